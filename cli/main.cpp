@@ -3,12 +3,16 @@
 #include "opengalaxy/api/session.h"
 #include "opengalaxy/install/install_service.h"
 #include "opengalaxy/library/library_service.h"
+#include "opengalaxy/runners/game_process_supervisor.h"
 #include "opengalaxy/runners/runner_manager.h"
 #include "opengalaxy/util/config.h"
 #include "opengalaxy/util/log.h"
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
 #include <QTextStream>
 #include <iostream>
 // main.moc is included by CMake's AUTOGEN; do not include it manually in a .cpp
@@ -23,9 +27,14 @@ class CLI {
         libraryService_ = new library::LibraryService(gogClient_);
         installService_ = new install::InstallService();
         runnerManager_ = new runners::RunnerManager();
+        // Each command is its own process; a kept wineserver is only useful
+        // if it outlives this one until the next launch
+        runnerManager_->setStopIdleWineservers(false);
+        supervisor_ = new runners::GameProcessSupervisor();
     }
 
     ~CLI() {
+        delete supervisor_;
         delete runnerManager_;
         delete installService_;
         delete libraryService_;
@@ -33,6 +42,10 @@ class CLI {
         delete session_;
     }
 
+    // Report install progress as JSON lines instead of a status line
+    void setJsonProgress(bool enabled) { jsonProgress_ = enabled; }
+    void setPrintEnvironment(bool enabled) { printEnvironment_ = enabled; }
+
     void login(const QString &username, const QString &password) {
         std::cout << "Logging in..." << std::endl;
 
@@ -100,30 +113,66 @@ class CLI {
                 return;
             }
 
-            const auto &game = result.value();
-            std::cout << "Installing: " << game.title.toStdString() << std::endl;
-
-            installService_->installGame(
-                game, installDir,
-                [](const install::InstallService::InstallProgress &progress) {
-                    std::cout << "\r[" << progress.percentage << "%] "
-                              << progress.status.toStdString() << "..." << std::flush;
-                },
-                [this](util::Result<QString> result) {
-                    std::cout << std::endl;
-                    if (result.isOk()) {
-                        std::cout << "Installation complete: " << result.value().toStdString()
-                                  << std::endl;
-                        app_->quit();
-                    } else {
-                        std::cerr << "Installation failed: " << result.errorMessage().toStdString()
-                                  << std::endl;
+            const api::GameInfo game = result.value();
+            if (!game.downloads.empty()) {
+                startInstall(game, installDir);
+                return;
+            }
+
+            // No cached installer metadata yet
+            gogClient_->fetchGameDownloads(
+                game.id, [this, game, installDir](util::Result<api::GameInfo> downloads) mutable {
+                    if (!downloads.isOk()) {
+                        std::cerr << "Failed to fetch downloads: "
+                                  << downloads.errorMessage().toStdString() << std::endl;
                         app_->exit(1);
+                        return;
                     }
+
+                    game.downloads = downloads.value().downloads;
+                    libraryService_->cacheGameDownloads(game.id, game.downloads);
+                    startInstall(game, installDir);
                 });
         });
     }
 
+    void startInstall(const api::GameInfo &game, const QString &installDir) {
+        std::cout << "Installing: " << game.title.toStdString() << std::endl;
+
+        installService_->installGame(
+            game, installDir,
+            [this](const install::InstallService::InstallProgress &progress) {
+                if (jsonProgress_) {
+                    // One object per line, for scripts
+                    QJsonObject json = progress.transfer.toJson();
+                    json["gameId"] = progress.gameId;
+                    json["status"] = progress.status;
+                    json["percentage"] = progress.percentage;
+                    std::cout << QJsonDocument(json).toJson(QJsonDocument::Compact).toStdString()
+                              << std::endl;
+                    return;
+                }
+                std::cout << "\r[" << progress.percentage << "%] "
+                          << progress.status.toStdString() << "...";
+                if (progress.status == "downloading" && progress.transfer.elapsedMs > 0) {
+                    std::cout << " " << progress.transfer.toString().toStdString();
+                }
+                std::cout << "   " << std::flush;
+            },
+            [this](util::Result<QString> result) {
+                std::cout << std::endl;
+                if (result.isOk()) {
+                    std::cout << "Installation complete: " << result.value().toStdString()
+                              << std::endl;
+                    app_->quit();
+                } else {
+                    std::cerr << "Installation failed: " << result.errorMessage().toStdString()
+                              << std::endl;
+                    app_->exit(1);
+                }
+            });
+    }
+
     void launchGame(const QString &gameId) {
         if (!session_->isAuthenticated()) {
             std::cerr << "Not logged in. Please login first." << std::endl;
@@ -148,41 +197,82 @@ class CLI {
 
             std::cout << "Launching: " << game.title.toStdString() << std::endl;
 
-            runners::LaunchConfig config;
+            // Answers at once from the index; a game without one is indexed first
+            libraryService_->primaryExecutable(
+                game.id, [this, game](auto target) { launchExecutable(game, target); });
+        });
+    }
+
+    void launchExecutable(const api::GameInfo &game,
+                          const util::Result<library::GameExecutable> &target) {
+        // Without an indexed executable the runner gets the install directory (only
+        // DOSBox can do anything with that)
+        runners::LaunchConfig config;
+        if (target.isOk()) {
+            config.gamePath = target.value().path;
+            config.workingDirectory = target.value().workingDirectory;
+            config.arguments = QProcess::splitCommand(target.value().arguments);
+        } else {
             config.gamePath = game.installPath;
-            config.workingDirectory = QFileInfo(game.installPath).absolutePath();
+            config.workingDirectory = game.installPath;
+        }
+        config.installPath = game.installPath;
 
-            // Detect platform and architecture from binary
-            config.gamePlatform = runners::Runner::detectPlatform(game.installPath);
-            config.gameArch = runners::Runner::detectArchitecture(game.installPath);
+        // Detect platform and architecture from binary
+        config.gamePlatform = runners::Runner::detectPlatform(config.gamePath);
+        config.gameArch = runners::Runner::detectArchitecture(config.gamePath);
 
-            // Use game-specific settings if available
-            config.runnerExecutableOverride = game.runnerExecutable.trimmed();
-            config.runnerArguments = game.runnerArguments; // Already a QStringList
-            config.arguments = {};                         // Game arguments (can be extended later)
+        // Use game-specific settings if available
+        config.runnerExecutableOverride = game.runnerExecutable.trimmed();
+        config.runnerArguments = game.runnerArguments; // Already a QStringList
+        config.profile = game.launchProfile;
+        config.gameMode = game.enableGameMode;
+        runners::GameProcessSupervisor::tagLaunch(config, game.id);
 
-            auto *runner = runnerManager_->findBestRunner(config);
-            if (!runner) {
-                std::cerr << "No suitable runner found." << std::endl;
-                app_->exit(1);
-                return;
-            }
+        // First run: nothing cached yet and the background scan may still be going
+        if (!runnerManager_->isReady()) runnerManager_->discoverRunners();
 
-            std::cout << "Using runner: " << runner->name().toStdString() << std::endl;
+        auto *runner = runnerManager_->findBestRunner(config);
+        if (!runner) {
+            std::cerr << "No suitable runner found." << std::endl;
+            app_->exit(1);
+            return;
+        }
 
-            auto process = runner->launch(config);
-            if (!process) {
-                std::cerr << "Failed to launch game." << std::endl;
-                app_->exit(1);
-                return;
+        std::cout << "Using runner: " << runner->name().toStdString() << std::endl;
+        if (printEnvironment_) {
+            for (const QString &line : runner->environment(config).describe()) {
+                std::cout << "  " << line.toStdString() << std::endl;
             }
+        }
 
-            std::cout << "Game launched successfully." << std::endl;
+        auto process = runner->launch(config);
+        if (!process) {
+            std::cerr << "Failed to launch game." << std::endl;
+            app_->exit(1);
+            return;
+        }
 
-            process->setParent(app_);
-            process.release();
-            app_->quit();
-        });
+        std::cout << "Game launched successfully." << std::endl;
+
+        // Stay alive until the whole process tree is gone so the play session
+        // gets closed; the runner's own process may exit long before the game
+        libraryService_->trackPlaySession(game.id, runner->name(), supervisor_);
+        QObject::connect(supervisor_, &runners::GameProcessSupervisor::gameExited, app_,
+                         [this](const QString &, int exitCode, bool crashed,
+                                const runners::GameProcessStats &stats) {
+                             std::cout << "Game " << (crashed ? "crashed" : "exited")
+                                       << " with code " << exitCode << " after "
+                                       << stats.wallTimeMs / 1000 << "s (CPU "
+                                       << stats.cpuTimeMs / 1000 << "s, peak "
+                                       << stats.peakRssKb / 1024 << " MiB)" << std::endl;
+                             std::cout << "Ran on CPUs " << stats.cpuAffinity.toStdString()
+                                       << ", nice " << stats.nice << ", "
+                                       << stats.schedPolicy.toStdString() << " scheduling"
+                                       << std::endl;
+                             app_->exit(exitCode);
+                         });
+        supervisor_->supervise(game.id, std::move(process));
     }
 
     void listRunners() {
@@ -261,6 +351,82 @@ class CLI {
         app_->quit();
     }
 
+    void showStats(const QString &gameId) {
+        const auto formatTime = [](qint64 seconds) {
+            return QString("%1h %2m").arg(seconds / 3600).arg((seconds % 3600) / 60).toStdString();
+        };
+
+        if (!gameId.isEmpty()) {
+            const auto stats = libraryService_->playStats(gameId);
+            std::cout << "Launches: " << stats.launchCount << std::endl;
+            std::cout << "Play time: " << formatTime(stats.totalSeconds) << std::endl;
+            if (stats.lastPlayed.isValid()) {
+                std::cout << "Last played: " << stats.lastPlayed.toString(Qt::ISODate).toStdString()
+                          << std::endl;
+            }
+
+            std::cout << "\nRecent sessions:" << std::endl;
+            for (const auto &session : libraryService_->playSessions(gameId, 10)) {
+                std::cout << "  " << session.startedAt.toString(Qt::ISODate).toStdString() << "  "
+                          << formatTime(session.durationSeconds()) << "  "
+                          << session.runner.toStdString();
+                if (!session.endedAt.isValid()) {
+                    std::cout << "  (not closed)";
+                } else if (session.crashed || session.exitCode != 0) {
+                    std::cout << "  (exit code " << session.exitCode << ")";
+                }
+                std::cout << std::endl;
+            }
+
+            app_->quit();
+            return;
+        }
+
+        std::cout << "Recently played:" << std::endl;
+        const auto snapshot = libraryService_->snapshot();
+        for (const auto &stats : libraryService_->recentlyPlayed()) {
+            const auto game = snapshot->find(stats.gameId);
+            std::cout << "  " << (game ? game->title : stats.gameId).toStdString() << "  "
+                      << formatTime(stats.totalSeconds) << "  "
+                      << stats.lastPlayed.toString(Qt::ISODate).toStdString() << std::endl;
+        }
+
+        std::cout << "\nRunners:" << std::endl;
+        for (const auto &stats : libraryService_->runnerStats()) {
+            std::cout << "  " << stats.runner.toStdString() << "  " << stats.sessions
+                      << " sessions, " << stats.failures << " failed, "
+                      << formatTime(stats.totalSeconds) << std::endl;
+        }
+
+        app_->quit();
+    }
+
+    void exportLibrary(const QString &path) {
+        auto result = libraryService_->exportSnapshot(path);
+        if (!result.isOk()) {
+            std::cerr << "Export failed: " << result.errorMessage().toStdString() << std::endl;
+            app_->exit(1);
+            return;
+        }
+
+        std::cout << "Exported " << libraryService_->snapshot()->size() << " games to "
+                  << path.toStdString() << std::endl;
+        app_->quit();
+    }
+
+    void importLibrary(const QString &path) {
+        auto result = libraryService_->importSnapshot(path);
+        if (!result.isOk()) {
+            std::cerr << "Import failed: " << result.errorMessage().toStdString() << std::endl;
+            app_->exit(1);
+            return;
+        }
+
+        std::cout << "Imported " << result.value() << " games from " << path.toStdString()
+                  << std::endl;
+        app_->quit();
+    }
+
   private:
     QCoreApplication *app_;
     api::Session *session_;
@@ -268,6 +434,9 @@ class CLI {
     library::LibraryService *libraryService_;
     install::InstallService *installService_;
     runners::RunnerManager *runnerManager_;
+    runners::GameProcessSupervisor *supervisor_;
+    bool jsonProgress_ = false;
+    bool printEnvironment_ = false;
 };
 
 int main(int argc, char *argv[]) {
@@ -286,8 +455,9 @@ int main(int argc, char *argv[]) {
     parser.addHelpOption();
     parser.addVersionOption();
 
-    parser.addPositionalArgument("command",
-                                 "Command to execute: login, list, install, launch, runners");
+    parser.addPositionalArgument(
+        "command", "Command to execute: login, list, install, launch, runners, stats, "
+                   "library export|import");
 
     QCommandLineOption usernameOption(QStringList() << "u" << "username", "Username for login",
                                       "username");
@@ -296,11 +466,17 @@ int main(int argc, char *argv[]) {
     QCommandLineOption gameIdOption(QStringList() << "g" << "game", "Game ID", "gameId");
     QCommandLineOption installDirOption(QStringList() << "d" << "dir", "Installation directory",
                                         "dir");
+    QCommandLineOption fileOption(QStringList() << "f" << "file", "Library snapshot file", "file");
+    QCommandLineOption jsonOption("json", "Print install progress as JSON lines");
+    QCommandLineOption printEnvOption("print-env", "Print the environment a launched game gets");
 
     parser.addOption(usernameOption);
     parser.addOption(passwordOption);
     parser.addOption(gameIdOption);
     parser.addOption(installDirOption);
+    parser.addOption(fileOption);
+    parser.addOption(jsonOption);
+    parser.addOption(printEnvOption);
 
     parser.process(app);
 
@@ -312,6 +488,8 @@ int main(int argc, char *argv[]) {
 
     QString command = args.first();
     CLI cli(&app);
+    cli.setJsonProgress(parser.isSet(jsonOption));
+    cli.setPrintEnvironment(parser.isSet(printEnvOption));
 
     if (command == "login") {
         if (!parser.isSet(usernameOption) || !parser.isSet(passwordOption)) {
@@ -340,6 +518,19 @@ int main(int argc, char *argv[]) {
         cli.launchGame(parser.value(gameIdOption));
     } else if (command == "runners") {
         cli.listRunners();
+    } else if (command == "stats") {
+        cli.showStats(parser.value(gameIdOption));
+    } else if (command == "library") {
+        const QString action = args.value(1);
+        if ((action != "export" && action != "import") || !parser.isSet(fileOption)) {
+            std::cerr << "Usage: library export|import --file <path>" << std::endl;
+            return 1;
+        }
+        if (action == "export") {
+            cli.exportLibrary(parser.value(fileOption));
+        } else {
+            cli.importLibrary(parser.value(fileOption));
+        }
     } else {
         std::cerr << "Unknown command: " << command.toStdString() << std::endl;
         parser.showHelp(1);
@@ -9,6 +9,29 @@
 
 namespace opengalaxy::api {
 
+/**
+ * @brief Scheduling and resource limits a game runs under
+ *
+ * Every default leaves the setting to the system. The cgroup limits are applied
+ * through a transient systemd scope, so they need a systemd user session.
+ */
+struct LaunchProfile {
+    QString cpuAffinity;     // CPU list as taskset -c takes it ("0-7,16-23"); empty: all
+    int niceLevel = 0;       // -20 (highest) to 19; 0 keeps the client's
+    int ioClass = 0;         // ioprio class: 0 unchanged, 1 realtime, 2 best effort, 3 idle
+    int ioLevel = 4;         // 0 (highest) to 7 within the class
+    bool schedIso = false;   // SCHED_ISO, on kernels that have it (MuQSS/-ck)
+    QString slice;           // systemd slice for the scope ("games.slice")
+    QString memoryMax;       // MemoryMax= of the scope ("8G"); empty: unlimited
+    int cpuQuotaPercent = 0; // CPUQuota= of the scope, 100 per CPU; 0: unlimited
+
+    bool usesCgroup() const {
+        return !slice.isEmpty() || !memoryMax.isEmpty() || cpuQuotaPercent > 0;
+    }
+
+    bool operator==(const LaunchProfile &) const = default;
+};
+
 /**
  * @brief Game information from GOG API
  */
@@ -43,6 +66,7 @@ struct GameInfo {
     bool enableDxvkHudFps = false; // Show FPS (DXVK_HUD=fps)
     bool enableGameMode = false;   // Use GameMode
     bool enableCloudSaves = true;  // Enable cloud saves (default true)
+    LaunchProfile launchProfile;   // CPU pinning, priorities and limits
 
     // Download URLs
     struct DownloadLink {
@@ -52,8 +76,12 @@ struct GameInfo {
         QString version;
         qint64 size = 0;
         QString checksumUrl; // optional: URL to checksum XML
+
+        bool operator==(const DownloadLink &) const = default;
     };
     std::vector<DownloadLink> downloads;
+
+    bool operator==(const GameInfo &) const = default;
 };
 /**
  * @brief User session information
@@ -3,9 +3,12 @@
 
 #include "../api/models.h"
 #include "../util/result.h"
+#include "transfer_stats.h"
+#include <QJsonObject>
 #include <QMutex>
 #include <QObject>
 #include <QString>
+#include <QTimer>
 #include <functional>
 
 namespace opengalaxy::install {
@@ -30,6 +33,7 @@ class InstallService : public QObject {
         QString currentFile;
         QString status; // downloading, extracting, verifying, complete
         int percentage = 0;
+        TransferStats::Snapshot transfer; // Throughput and ETA while downloading
     };
 
     using ProgressCallback = std::function<void(const InstallProgress &)>;
@@ -52,9 +56,22 @@ class InstallService : public QObject {
     // Get the auto-detected runner for a game (after installation)
     QString getDetectedRunner(const QString &gameId) const;
 
+    // Download throughput of one installation; empty if it is not downloading
+    TransferStats::Snapshot transferStats(const QString &gameId) const;
+    // All running downloads together
+    TransferStats::Snapshot totalTransferStats() const;
+    // Machine-readable status: {"downloads": {gameId: stats, ...}, "total": stats}
+    QJsonObject transferStatus() const;
+
   signals:
     void installStarted(const QString &gameId);
+    // Download progress is coalesced: at most ~10 per second per game, and only when the
+    // percentage changes. The progress callback receives the same updates.
     void installProgress(const QString &gameId, int percentage);
+    // With every progress update, and once a second while a download is running so that
+    // rates keep decaying and stalls show up even when no data arrives
+    void installTransferStats(const QString &gameId, const TransferStats::Snapshot &stats);
+    void installStalled(const QString &gameId, bool stalled);
     void installCompleted(const QString &gameId, const QString &installPath,
                           const QString &detectedRunner = "");
     void installFailed(const QString &gameId, const QString &error);
@@ -66,6 +83,9 @@ class InstallService : public QObject {
     std::map<QString, QString> detectedRunners_; // gameId -> detected runner name
     mutable QMutex tasksMutex_;
     void *session_ = nullptr; // api::Session* (void* to avoid forward declaration issues)
+    QTimer statsTimer_;       // Runs while any download is active
+
+    void publishTransferStats();
 
     void downloadAndExtract(InstallTask *task);
     bool verifyChecksum(const QString &filePath, const QString &expectedChecksum);
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QtGlobal>
+
+namespace opengalaxy::install {
+
+/**
+ * @brief Coalesces byte-level download progress into UI-sized updates
+ *
+ * Network replies report progress on every chunk, which on a fast link is
+ * thousands of times per second. update() records each tick but only asks for
+ * an update when the integer percentage changed and at least 1/maxHz seconds
+ * have passed since the last one. The first tick and the final one (all bytes
+ * received) always go through.
+ *
+ * Rates and ETA are TransferStats' job; this only decides when to publish.
+ */
+class ProgressThrottle {
+  public:
+    explicit ProgressThrottle(int maxHz = 10);
+
+    // Record a tick; true when the caller should publish an update
+    bool update(qint64 receivedBytes, qint64 totalBytes, qint64 nowMs);
+    void reset();
+
+    int percentage() const { return percentage_; }
+    qint64 receivedBytes() const { return received_; }
+    qint64 totalBytes() const { return total_; }
+
+  private:
+    qint64 minIntervalMs_;
+
+    qint64 received_ = 0;
+    qint64 total_ = 0;
+    int percentage_ = 0;
+    int publishedPercentage_ = -1;
+    qint64 publishedAtMs_ = 0;
+};
+
+} // namespace opengalaxy::install
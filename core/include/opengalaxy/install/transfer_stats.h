@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QtGlobal>
+
+namespace opengalaxy::install {
+
+/**
+ * @brief Throughput, ETA and stall tracking for one transfer
+ *
+ * addSample() is meant to be called on every received chunk: it is O(1) and
+ * allocation free. Three rates are kept:
+ *  - instantaneous: bytes over the last 0.5-1 s,
+ *  - smoothed: exponentially weighted moving average (time constant
+ *    kSmoothingMs), which the ETA is based on,
+ *  - average: bytes since the first sample over the elapsed time.
+ *
+ * A transfer that has not advanced for stallTimeoutMs is stalled. Since no
+ * chunks arrive while stalled, snapshot() takes the current time and decays
+ * the rates accordingly.
+ */
+class TransferStats {
+  public:
+    struct Snapshot {
+        qint64 receivedBytes = 0;
+        qint64 totalBytes = 0; // 0 when unknown
+        double instantBytesPerSecond = 0;
+        double smoothedBytesPerSecond = 0;
+        double averageBytesPerSecond = 0;
+        qint64 etaSeconds = -1; // -1 when unknown
+        qint64 elapsedMs = 0;
+        bool stalled = false;
+
+        // "12.4 MB/s, 3m left"
+        QString toString() const;
+        QJsonObject toJson() const;
+
+        // Sum of several transfers; the ETA is for all of them together
+        Snapshot &operator+=(const Snapshot &other);
+    };
+
+    static constexpr qint64 kSmoothingMs = 5000;
+    static constexpr qint64 kInstantWindowMs = 500;
+
+    explicit TransferStats(qint64 stallTimeoutMs = 10000);
+
+    void addSample(qint64 receivedBytes, qint64 totalBytes, qint64 nowMs);
+    void reset();
+
+    bool hasSamples() const { return startMs_ >= 0; }
+    bool isStalled(qint64 nowMs) const;
+    Snapshot snapshot(qint64 nowMs) const;
+
+    // "12.4 MB/s"
+    static QString formatRate(double bytesPerSecond);
+    // "45s", "3m", "1h 20m"
+    static QString formatDuration(qint64 seconds);
+
+  private:
+    qint64 stallTimeoutMs_;
+
+    qint64 startMs_ = -1;
+    qint64 startBytes_ = 0;
+    qint64 received_ = 0;
+    qint64 total_ = 0;
+
+    qint64 lastSampleMs_ = 0;
+    qint64 lastSampleBytes_ = 0;
+    qint64 lastProgressMs_ = 0; // Last time received bytes grew
+
+    // Two consecutive buckets of kInstantWindowMs for the instantaneous rate
+    qint64 bucketStartMs_ = 0;
+    qint64 bucketStartBytes_ = 0;
+    qint64 previousBucketStartMs_ = 0;
+    qint64 previousBucketStartBytes_ = 0;
+
+    double smoothed_ = 0;
+    bool smoothedValid_ = false;
+};
+
+} // namespace opengalaxy::install
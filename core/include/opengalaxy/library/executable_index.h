@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+namespace opengalaxy::library {
+
+/**
+ * @brief A launchable file inside a game's installation
+ */
+struct GameExecutable {
+    enum class Source { GogInfo, Heuristic };
+
+    QString path;             // Absolute
+    QString arguments;        // Command-line string, split with QProcess::splitCommand
+    QString workingDirectory; // Absolute
+    QString name;             // Play task name, or the file name
+    Source source = Source::Heuristic;
+    int rank = 0; // Higher is more likely the game itself
+    bool isPrimary = false;
+
+    // Identity at indexing time; a mismatch means the index is stale
+    qint64 size = 0;
+    qint64 mtime = 0;
+};
+
+/**
+ * @brief Finds the executables of an installed game
+ *
+ * GOG installers drop goggame-<id>.info files describing the play tasks; those
+ * are used when present. Otherwise, and for tasks that only start a bundled
+ * DOSBox or ScummVM (the host runners replace those), candidates are ranked by
+ * name, location and size. Wine and Proton prefixes inside the install
+ * directory are searched too, skipping their Windows system directories.
+ *
+ * build() walks the tree and is meant for install time, off the UI thread;
+ * launches look the result up in the library database.
+ */
+class ExecutableIndex {
+  public:
+    // Best first; the first entry is marked primary
+    static std::vector<GameExecutable> build(const QString &installPath);
+
+    // Still the same file as when it was indexed (one stat)
+    static bool isCurrent(const GameExecutable &executable);
+
+    static QString sourceToString(GameExecutable::Source source);
+    static GameExecutable::Source sourceFromString(const QString &source);
+};
+
+} // namespace opengalaxy::library
@@ -3,15 +3,79 @@
 
 #include "../api/gog_client.h"
 #include "../api/models.h"
+#include "../runners/game_process_supervisor.h"
 #include "../util/result.h"
+#include "executable_index.h"
+#include "library_snapshot.h"
+#include <QDateTime>
 #include <QObject>
+#include <QStringList>
+#include <atomic>
 #include <functional>
 #include <vector>
 
+class QThreadPool;
+class QTimer;
+
 namespace opengalaxy::library {
 
+/**
+ * @brief One run of a game
+ */
+struct PlaySession {
+    qint64 id = -1;
+    QString gameId;
+    QString runner; // Runner name at launch time
+    QDateTime startedAt;
+    QDateTime endedAt; // Invalid while the game is running (or if the client died first)
+    int exitCode = 0;
+    bool crashed = false;
+
+    qint64 durationSeconds() const { return endedAt.isValid() ? startedAt.secsTo(endedAt) : 0; }
+};
+
+/**
+ * @brief Rolled-up play time for one game
+ */
+struct PlayStats {
+    QString gameId;
+    int launchCount = 0;
+    qint64 totalSeconds = 0;
+    QDateTime lastPlayed;
+};
+
+/**
+ * @brief Size and health of library.db, for the settings page
+ */
+struct DatabaseStats {
+    QString path;
+    qint64 fileSize = 0; // Main file, bytes
+    qint64 walSize = 0;  // Write-ahead log, bytes
+    qint64 pageSize = 0;
+    qint64 pageCount = 0;
+    qint64 freePages = 0; // Reclaimable by incremental vacuum
+    QString journalMode;
+    int schemaVersion = 0;
+    QDateTime lastMaintenance; // Invalid until maintenance has run in this session
+};
+
+/**
+ * @brief Finished sessions grouped by runner
+ */
+struct RunnerStats {
+    QString runner;
+    int sessions = 0;
+    int failures = 0; // Crashed or exited non-zero
+    qint64 totalSeconds = 0;
+};
+
 /**
  * @brief Library service with local caching
+ *
+ * SQLite is the persistent store; snapshot() is the authoritative in-memory
+ * copy. Every write goes to the database first and then publishes a new
+ * snapshot, so readers (on any thread) never observe a half-applied change.
+ * Writes must happen on the thread that owns the service.
  */
 class LibraryService : public QObject {
     Q_OBJECT
@@ -22,34 +86,111 @@ class LibraryService : public QObject {
 
     using GamesCallback = std::function<void(util::Result<std::vector<api::GameInfo>>)>;
     using GameCallback = std::function<void(util::Result<api::GameInfo>)>;
+    using ExecutableCallback = std::function<void(util::Result<GameExecutable>)>;
 
     // Fetch library (from cache or API)
     void fetchLibrary(bool forceRefresh, GamesCallback callback);
 
-    // Get single game
+    // Get single game (served from the current snapshot)
     void getGame(const QString &gameId, GameCallback callback);
 
-    // Update game installation status
+    // Current library state; cheap to take and safe to keep while the service moves on
+    LibrarySnapshotPtr snapshot() const;
+
+    // Re-read the database, e.g. after another process (the CLI) changed it
+    void reload();
+
+    // Snapshot files for provisioning machines without crawling the GOG API. Import
+    // merges catalogue metadata and cached installer links; install state, per-game
+    // settings and play history stay local. Returns the number of games imported.
+    util::Result<void> exportSnapshot(const QString &path);
+    util::Result<int> importSnapshot(const QString &path);
+
+    // Update game installation status. Installing (re)builds the executable index.
     void updateGameInstallation(const QString &gameId, const QString &installPath,
                                 const QString &version);
     void removeGameInstallation(const QString &gameId);
 
+    // Executable index: what to launch for an installed game. indexExecutables() walks
+    // the install directory on a worker thread and replaces the stored entries.
+    // primaryExecutable() is a single lookup plus a stat() and calls back at once when
+    // the entry is current. A changed file that still exists is used as is and
+    // re-indexed in the background; without an index, or with the file gone, the
+    // callback waits for indexing on the worker. The tree is never walked inline.
+    void indexExecutables(const QString &gameId);
+    std::vector<GameExecutable> executables(const QString &gameId);
+    void primaryExecutable(const QString &gameId, ExecutableCallback callback);
+
     // Update per-game properties
     void updateGameProperties(const api::GameInfo &game);
 
+    // Persist product details from GOGClient::fetchGameDetails (description, background,
+    // release date). Empty fields leave the stored value alone.
+    void cacheGameDetails(const api::GameInfo &details);
+
+    // Persist installer metadata from GOGClient::fetchGameDownloads so installs can start
+    // without another API round trip
+    void cacheGameDownloads(const QString &gameId,
+                            const std::vector<api::GameInfo::DownloadLink> &downloads);
+    std::vector<api::GameInfo::DownloadLink> cachedDownloads(const QString &gameId);
+
+    // Play-session tracking. Sessions are appended on launch and closed once on exit;
+    // per-game aggregates are updated in the same transaction.
+    qint64 beginPlaySession(const QString &gameId, const QString &runner);
+    void endPlaySession(qint64 sessionId, int exitCode, bool crashed);
+    // Begin a session now and end it when the supervisor reports the game's process tree gone
+    void trackPlaySession(const QString &gameId, const QString &runner,
+                          runners::GameProcessSupervisor *supervisor);
+
+    PlayStats playStats(const QString &gameId);
+    std::vector<PlayStats> recentlyPlayed(int limit = 10);
+    std::vector<PlaySession> playSessions(const QString &gameId, int limit = 50);
+    std::vector<RunnerStats> runnerStats();
+
+    // Database maintenance. Runs by itself once the library has been idle for a while;
+    // runMaintenance() forces a pass (checkpoint, incremental vacuum, optimize).
+    DatabaseStats databaseStats();
+    void runMaintenance();
+
     // Search and filter
     std::vector<api::GameInfo> searchGames(const QString &query);
     std::vector<api::GameInfo> filterByPlatform(const QString &platform);
+    std::vector<api::GameInfo> filterByGenre(const QString &genre);
+    // Games with a cached installer for platform ("windows", "linux", "mac")
+    std::vector<api::GameInfo> filterByInstallerPlatform(const QString &platform);
   signals:
     void libraryUpdated(int gameCount);
     void gameUpdated(const QString &gameId);
+    void gamesAdded(const QStringList &gameIds);
+    void gamesRemoved(const QStringList &gameIds);
+    // Emitted once per published snapshot, after the per-game signals
+    void snapshotChanged(quint64 version);
+    void playStatsChanged(const QString &gameId);
+    void executablesIndexed(const QString &gameId, int count);
+    void maintenanceFinished();
 
   private:
     api::GOGClient *gogClient_;
     class LibraryDatabase *db_;
+    std::atomic<LibrarySnapshotPtr> snapshot_;
+    quint64 snapshotVersion_ = 0;
+
+    QString databasePath_;
+    QTimer *maintenanceTimer_;
+    QDateTime lastMaintenance_;
+    QThreadPool *indexPool_;
 
     void initDatabase();
-    void cacheGames(const std::vector<api::GameInfo> &games);
+    bool loadStartupCache();
+    void saveStartupCache();
+    void scheduleMaintenance();
+    bool cacheGames(const std::vector<api::GameInfo> &games);
+    std::vector<api::GameInfo> queryAllGames();
+    void publish(LibrarySnapshotPtr next, const QStringList &added, const QStringList &updated,
+                 const QStringList &removed);
+    void refreshGame(const QString &gameId);
+    void indexExecutables(const QString &gameId, ExecutableCallback then);
+    bool storeExecutables(const QString &gameId, const std::vector<GameExecutable> &entries);
 
   public:
     // Exposed for UI convenience (e.g., offline/demo mode)
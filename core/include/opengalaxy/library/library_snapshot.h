@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "../api/models.h"
+#include "../util/result.h"
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <memory>
+#include <vector>
+
+namespace opengalaxy::library {
+
+/**
+ * @brief Immutable view of the library at one point in time
+ *
+ * Snapshots are never modified after construction, so they can be read from
+ * any thread without locking. Writers derive a new snapshot with withGame(),
+ * which copies only the entry pointers: untouched games are shared between
+ * the old and the new version.
+ *
+ * A snapshot can be written to a compact binary file (versioned header plus a
+ * zlib-compressed payload). Reading maps the file and decompresses straight
+ * from the mapping, so loading never goes through SQLite.
+ */
+class LibrarySnapshot {
+  public:
+    using GamePtr = std::shared_ptr<const api::GameInfo>;
+
+    LibrarySnapshot() = default;
+    // Duplicate ids keep their first occurrence
+    LibrarySnapshot(std::vector<GamePtr> games, quint64 version);
+
+    quint64 version() const { return version_; }
+    size_t size() const { return games_.size(); }
+    bool empty() const { return games_.empty(); }
+
+    // Games in database order
+    const std::vector<GamePtr> &games() const { return games_; }
+
+    // O(1) lookup; nullptr if the id is unknown
+    GamePtr find(const QString &gameId) const;
+    bool contains(const QString &gameId) const { return indexById_.contains(gameId); }
+    // Position in games(), -1 if the id is unknown
+    int indexOf(const QString &gameId) const;
+
+    // Copy of the games, for callers that want plain values
+    std::vector<api::GameInfo> toVector() const;
+
+    // New snapshot with game replaced (matched by id) or appended
+    std::shared_ptr<const LibrarySnapshot> withGame(GamePtr game, quint64 version) const;
+
+    // Snapshot files. tag is stored verbatim in the header (e.g. to tie a cache to a database).
+    util::Result<void> writeToFile(const QString &path, const QByteArray &tag = {}) const;
+    static util::Result<std::shared_ptr<const LibrarySnapshot>>
+    readFromFile(const QString &path, QByteArray *tag = nullptr);
+
+  private:
+    std::vector<GamePtr> games_;
+    QHash<QString, size_t> indexById_;
+    quint64 version_ = 0;
+};
+
+using LibrarySnapshotPtr = std::shared_ptr<const LibrarySnapshot>;
+
+} // namespace opengalaxy::library
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "runner.h"
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <vector>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief What an executable's headers say about it
+ */
+struct BinaryInfo {
+    // MZ is an MZ image without a PE header: DOS, DOS-extended (LE/LX) or 16-bit Windows (NE)
+    enum class Format { Unknown, MZ, PE, ELF, MachO, MachOFat };
+
+    Format format = Format::Unknown;
+    Platform platform = Platform::Unknown;
+    Architecture arch = Architecture::Unknown;
+    bool is64Bit = false;
+
+    // PE
+    quint16 subsystem = 0;  // IMAGE_SUBSYSTEM_*: 2 = GUI, 3 = console
+    bool dotNet = false;    // Has a CLR header
+    bool anyCpu = false;    // IL-only .NET image that runs as 64-bit where it can
+    QStringList imports;    // Imported DLL names, lower case
+
+    // ELF
+    QString interpreter;    // PT_INTERP, e.g. /lib64/ld-linux-x86-64.so.2
+    QStringList needed;     // DT_NEEDED libraries
+
+    // Mach-O fat binaries: every slice, in file order
+    std::vector<Architecture> slices;
+
+    bool isValid() const { return format != Format::Unknown; }
+    bool importsLibrary(const QString &name) const {
+        return imports.contains(name, Qt::CaseInsensitive) ||
+               needed.contains(name, Qt::CaseInsensitive);
+    }
+    bool usesDirect3D9() const { return importsLibrary("d3d9.dll"); }
+    bool usesDirect3D11() const { return importsLibrary("d3d11.dll"); }
+    bool usesDirect3D12() const { return importsLibrary("d3d12.dll"); }
+    bool usesVulkan() const {
+        return importsLibrary("vulkan-1.dll") || importsLibrary("libvulkan.so.1");
+    }
+};
+
+/**
+ * @brief Parses PE/COFF, ELF and Mach-O headers
+ *
+ * Large files are memory-mapped so only the pages holding headers, section
+ * tables and import names are actually read. Results are cached by path and
+ * invalidated when the file's size or modification time changes, so scoring
+ * runners for the same game repeatedly costs one stat().
+ */
+class BinaryInspector {
+  public:
+    // Thread-safe; cached
+    static BinaryInfo inspect(const QString &path);
+
+    // Parse an in-memory image; no caching
+    static BinaryInfo parse(const uchar *data, qint64 size);
+
+    static void clearCache();
+};
+
+} // namespace opengalaxy::runners
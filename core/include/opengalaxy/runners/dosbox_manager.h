@@ -14,12 +14,17 @@ namespace opengalaxy::runners {
  * - Gracefully terminate with save prompts
  * - Force kill if necessary
  * - Detect stale processes
+ *
+ * Process state comes from /proc and exits are waited for on pidfds, so
+ * nothing here forks helpers or sleeps in fixed steps.
  */
 class DOSBoxManager {
   public:
     /**
      * @brief Find all running DOSBox processes
      *
+     * Only the current user's processes whose executable is named dosbox*
+     *
      * @return List of DOSBox process IDs
      */
     static QStringList findRunningDOSBoxProcesses();
@@ -45,6 +50,19 @@ class DOSBoxManager {
      */
     static bool forceKill(const QString &pid);
 
+    /**
+     * @brief Terminate processes, all at once
+     *
+     * Sends SIGTERM to every process, waits until they exit or the timeout
+     * passes, then SIGKILLs the rest. The total wait is the timeout, not the
+     * timeout per process, and returns as soon as the last one exits.
+     *
+     * @param pids Process IDs
+     * @param timeoutMs Timeout for graceful shutdown
+     * @return Number of processes terminated
+     */
+    static int terminateProcesses(const QStringList &pids, int timeoutMs = 5000);
+
     /**
      * @brief Terminate all DOSBox processes gracefully
      *
@@ -14,7 +14,8 @@ namespace opengalaxy::runners {
  */
 class DOSBoxRunner : public Runner {
   public:
-    explicit DOSBoxRunner(const QString &dosboxPath);
+    // version is probed from the binary on first use when not given
+    explicit DOSBoxRunner(const QString &dosboxPath, const QString &version = QString());
     ~DOSBoxRunner() override = default;
 
     // Runner information
@@ -33,8 +34,12 @@ class DOSBoxRunner : public Runner {
     QStringList configOptions() const override;
     void setConfigOption(const QString &key, const QString &value) override;
 
+    // Runs "dosbox -version" (up to 2 s); RunnerRegistry caches the result
+    static QString probeVersion(const QString &dosboxPath);
+
   private:
     QString dosboxPath_;
+    mutable QString version_;
     QString cpuCycles_ = "max";         // CPU cycles: max, auto, or specific number
     QString renderScaler_ = "normal2x"; // Scaler: normal2x, normal3x, etc.
     bool fullscreen_ = false;
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "runner.h"
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QSet>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+class QSocketNotifier;
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief Resource use of one game's process tree
+ */
+struct GameProcessStats {
+    qint64 pid = 0; // Process the runner started
+    QDateTime startedAt;
+    qint64 wallTimeMs = 0;
+    qint64 cpuTimeMs = 0; // User + system, summed over every process seen in the tree
+    qint64 peakRssKb = 0; // Highest sampled resident memory of the whole tree
+    int processCount = 0; // Alive at the last sample
+
+    // The leader as last seen, i.e. what the launch profile actually achieved
+    QString cpuAffinity; // CPU list it may run on
+    int nice = 0;
+    QString schedPolicy; // "normal", "batch", "idle", "iso", "fifo", "rr" or "deadline"
+    QString cgroup;      // cgroup v2 path
+};
+
+/**
+ * @brief Owns launched games and follows their whole process tree
+ *
+ * A runner's process is often not the game: wine and Proton start the game as
+ * a grandchild and may exit long before it does, leaving it reparented to
+ * init. Processes below a game's leader are followed by parent pid; orphans
+ * are recognised by the OPENGALAXY_GAME_ID variable that tagLaunch() puts in
+ * the environment every descendant inherits. Exits are picked up through
+ * pidfds where the kernel has them, with a periodic /proc sample as the
+ * fallback and for CPU and memory accounting.
+ *
+ * A game has exited once its leader and all descendants are gone, ignoring
+ * wineserver, which outlives its clients on purpose. Games still running when
+ * the supervisor is destroyed are left running.
+ */
+class GameProcessSupervisor : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit GameProcessSupervisor(QObject *parent = nullptr);
+    ~GameProcessSupervisor() override;
+
+    // Mark a launch so descendants that outlive their parent can still be attributed
+    static void tagLaunch(LaunchConfig &config, const QString &gameId);
+
+    // Take ownership of a started process. Fails if the game is already supervised
+    // or the process is not running.
+    bool supervise(const QString &gameId, std::unique_ptr<QProcess> process);
+
+    bool isRunning(const QString &gameId) const;
+    QStringList runningGames() const;
+
+    // Live processes of the game, leader first
+    std::vector<qint64> processTree(const QString &gameId) const;
+    GameProcessStats stats(const QString &gameId) const;
+
+    // SIGTERM to every process in the tree, SIGKILL to whatever is left after timeoutMs
+    void stop(const QString &gameId, int timeoutMs = 5000);
+
+  signals:
+    void gameStarted(const QString &gameId, qint64 pid);
+    // crashed: the leader died from a signal that stop() did not send
+    void gameExited(const QString &gameId, int exitCode, bool crashed,
+                    const opengalaxy::runners::GameProcessStats &stats);
+
+  private:
+    struct Game {
+        QString gameId;
+        std::unique_ptr<QProcess> process;
+        qint64 leader = 0;
+        QDateTime startedAt;
+        QSet<qint64> tree;              // Alive at the last sample, leader included
+        QHash<qint64, qint64> cpuTicks; // Last utime + stime per process, exited ones too
+        QHash<qint64, QSocketNotifier *> exitNotifiers; // pidfd per process in tree
+        qint64 peakRssKb = 0;
+        QString cpuAffinity; // Leader's placement, see GameProcessStats
+        QString cgroup;
+        int nice = 0;
+        int policy = 0;
+        bool leaderFinished = false;
+        int exitCode = 0;
+        bool crashed = false;
+        bool stopping = false;
+    };
+
+    void sample();
+    void scheduleSample();
+    void watchExit(Game &game, qint64 pid);
+    void signalTree(Game &game, int signal);
+    void finish(const QString &gameId);
+    GameProcessStats statsFor(const Game &game) const;
+
+    QHash<QString, std::shared_ptr<Game>> games_;
+    // Processes known not to belong to any game: pid -> start time (guards against reuse)
+    QHash<qint64, qint64> foreign_;
+    QTimer sampleTimer_;
+    bool samplePending_ = false;
+};
+
+} // namespace opengalaxy::runners
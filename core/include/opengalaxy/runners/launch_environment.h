@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QMap>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QString>
+#include <QStringList>
+#include <array>
+#include <utility>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief Environment a game is launched with
+ *
+ * The client's own environment is captured once and shared by every launch.
+ * Overrides are kept in layers and merged in a fixed order, later layers
+ * winning: user-wide settings (Config::launchEnvironment), then what the
+ * runner needs (WINEPREFIX, cache paths, ...), then the game's own
+ * environment, so a per-game setting always has the last word.
+ */
+class LaunchEnvironment {
+  public:
+    enum class Layer { Global, Runner, Game };
+
+    // The system environment plus the global layer from the configuration
+    LaunchEnvironment();
+    explicit LaunchEnvironment(const QMap<QString, QString> &gameEnvironment);
+
+    // Environment the client started with; later changes to it are not seen
+    static const QProcessEnvironment &systemEnvironment();
+
+    void insert(Layer layer, const QString &name, const QString &value);
+
+    // Whether the merged environment, system included, sets the variable
+    bool contains(const QString &name) const;
+    QString value(const QString &name, const QString &defaultValue = QString()) const;
+
+    QProcessEnvironment toProcessEnvironment() const;
+
+    // Set the merged environment on a process about to start, logging the overrides
+    void applyTo(QProcess &process) const;
+
+    // Every variable as NAME=value in name order, overrides tagged with their layer
+    QStringList describe() const;
+
+    // Only the layered variables; what differs from the client's environment
+    QStringList describeOverrides() const;
+
+  private:
+    std::array<QMap<QString, QString>, 3> layers_;
+
+    // Overrides with the layer each final value comes from
+    QMap<QString, std::pair<QString, Layer>> merged() const;
+};
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "../util/result.h"
+#include "runner.h"
+#include <QObject>
+#include <QThreadPool>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief What a prefix clone did
+ */
+struct CloneStats {
+    int files = 0;
+    int reflinked = 0;      // Shared extents, no data copied
+    qint64 bytesCopied = 0; // Files the filesystem could not reflink
+};
+
+/**
+ * @brief Creates Wine and Proton prefixes from pre-initialised templates
+ *
+ * A new prefix costs a wineboot run of 10-30 seconds and a few hundred MB.
+ * Instead one template per runner build is booted once, under the prefix
+ * template directory, and new prefixes are cloned from it: reflinked where
+ * the filesystem supports it (btrfs, XFS, bcachefs), otherwise copied in the
+ * kernel with copy_file_range. Hardlinks are not used because Wine rewrites
+ * files in place, which would change the template and every other clone.
+ *
+ * Templates are keyed on the runner executable's path, size and mtime, so a
+ * runner update gets a fresh one. Prefixes that already exist are never
+ * touched.
+ */
+class PrefixManager : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit PrefixManager(QObject *parent = nullptr);
+    ~PrefixManager() override;
+
+    // Prefix a game inside a prefix was installed into (.../drive_c/...), or empty
+    static QString containingPrefix(PrefixSpec::Type type, const QString &gamePath);
+
+    static QString templatePath(const PrefixSpec &spec);
+    // What WINEPREFIX is for this spec (Proton keeps it in <compat data>/pfx)
+    static QString winePrefix(const PrefixSpec &spec);
+    // The wineserver that belongs to the spec's runner build
+    static QString wineserverPath(const PrefixSpec &spec);
+    static bool isInitialised(PrefixSpec::Type type, const QString &path);
+
+    // Clone the template if there is one and the prefix does not exist yet. Fast
+    // enough for launch; never boots a template.
+    static bool cloneTemplate(const PrefixSpec &spec);
+
+    // Boot the template if needed, then clone it. Blocks for as long as wineboot
+    // takes; meant for worker threads.
+    static util::Result<QString> prepare(const PrefixSpec &spec);
+
+    // Copy a directory tree, keeping symlinks as they are
+    static util::Result<CloneStats> clone(const QString &source, const QString &destination);
+
+    // prepare() on a worker thread; prefixPrepared() reports the outcome
+    void prewarm(const PrefixSpec &spec);
+
+  signals:
+    void prefixPrepared(const QString &path, bool success, const QString &error);
+
+  private:
+    static util::Result<QString> bootTemplate(const PrefixSpec &spec);
+
+    QThreadPool pool_;
+};
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "../api/models.h"
+#include <QList>
+#include <QProcess>
+#include <QString>
+#include <vector>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief Applies a game's launch profile to the process about to start it
+ *
+ * CPU affinity, nice level, I/O priority and SCHED_ISO are set in the child
+ * between fork and exec, so the runner and everything it starts inherit them
+ * without extra tools. Memory and CPU limits need a cgroup: the command is
+ * wrapped in `systemd-run --user --scope`, which moves itself into a new scope
+ * and then execs the command, keeping its pid.
+ *
+ * With GameMode enabled the command also runs under gamemoderun. GameMode sets
+ * the nice level, I/O priority and SCHED_ISO of games that register with it,
+ * so the profile's own values for those are skipped; affinity and limits still
+ * apply. Settings the kernel refuses (a negative nice level without
+ * CAP_SYS_NICE, SCHED_ISO on mainline kernels) are left at their defaults;
+ * GameProcessStats reports what the game actually got.
+ */
+class ResourceProfile {
+  public:
+    // A set of CPUs worth pinning a game to, e.g. the performance cores
+    struct CpuGroup {
+        QString name;
+        QString cpus; // CPU list
+    };
+
+    // Hybrid core types and L3 cache domains (CCDs) from sysfs; only groups
+    // smaller than the whole machine
+    static std::vector<CpuGroup> cpuGroups();
+
+    // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}; empty for an empty or malformed list
+    static QList<int> parseCpuList(const QString &list);
+    static QString formatCpuList(QList<int> cpus);
+
+    // Empty when the profile can be applied, otherwise what is wrong with it
+    static QString validate(const api::LaunchProfile &profile);
+
+    // Wrap the process's program and arguments and set up the child; call after
+    // both are set and before start()
+    static void applyTo(QProcess &process, const api::LaunchProfile &profile, bool gameMode);
+};
+
+} // namespace opengalaxy::runners
@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "../api/models.h"
+#include "launch_environment.h"
 #include <QMap>
 #include <QProcess>
 #include <QString>
 #include <QStringList>
 #include <memory>
+#include <optional>
 
 namespace opengalaxy::runners {
 
@@ -53,12 +56,27 @@ struct LaunchConfig {
     QMap<QString, QString> environment;
     Platform gamePlatform;
     Architecture gameArch;
+    QString gameId;      // Library id; keys per-game state such as shader caches
+    QString installPath; // Game's install directory; workingDirectory varies per executable
+    api::LaunchProfile profile;
+    bool gameMode = false; // Run under gamemoderun; GameMode then owns the priorities
 
     // Optional per-game overrides (used by WrapperRunner / translators)
     QString runnerExecutableOverride; // e.g. /usr/local/bin/FEXInterpreter
     QStringList runnerArguments;      // wrapper/translator args (NOT game args)
 };
 
+/**
+ * @brief Wine prefix a launch runs in
+ */
+struct PrefixSpec {
+    enum class Type { Wine, Proton };
+
+    Type type = Type::Wine;
+    QString runnerExecutable; // wine binary or proton script; templates are per runner build
+    QString path;             // WINEPREFIX, or STEAM_COMPAT_DATA_PATH for Proton
+};
+
 /**
  * @brief Base class for game runners
  */
@@ -78,6 +96,16 @@ class Runner {
     // Launch game (returns owned QProcess - caller must manage lifetime)
     virtual std::unique_ptr<QProcess> launch(const LaunchConfig &config) = 0;
 
+    // Environment launch() starts the game with: the game's variables over the
+    // runner's own
+    virtual LaunchEnvironment environment(const LaunchConfig &config) const;
+
+    // Prefix this launch would use; none for runners without one
+    virtual std::optional<PrefixSpec> prefix(const LaunchConfig &config) const {
+        Q_UNUSED(config);
+        return std::nullopt;
+    }
+
     // Configuration
     virtual QStringList configOptions() const { return {}; }
     virtual void setConfigOption(const QString &key, const QString &value) {
@@ -2,14 +2,23 @@
 #pragma once
 
 #include "runner.h"
+#include "runner_registry.h"
+#include <QFileSystemWatcher>
 #include <QObject>
+#include <QThreadPool>
+#include <QTimer>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace opengalaxy::runners {
 
 /**
  * @brief Manages all available game runners
+ *
+ * Runners found on the previous run are registered from the registry cache at
+ * construction; a full scan then runs on a worker thread and again whenever a
+ * watched directory changes, adding and removing runners as needed.
  */
 class RunnerManager : public QObject {
     Q_OBJECT
@@ -18,9 +27,15 @@ class RunnerManager : public QObject {
     explicit RunnerManager(QObject *parent = nullptr);
     ~RunnerManager() override;
 
-    // Discover and register all available runners
+    // Discover and register all available runners, blocking until done
     void discoverRunners();
 
+    // Rescan on a worker thread; runnersDiscovered() fires when it is applied
+    void refreshRunners();
+
+    // False until runners were registered from the cache or a scan
+    bool isReady() const { return ready_; }
+
     // Get all available runners
     std::vector<RunnerCapabilities> availableRunners() const;
 
@@ -33,23 +48,36 @@ class RunnerManager : public QObject {
     // Register custom runner
     void registerRunner(std::unique_ptr<Runner> runner);
 
+    // Stop idle kept-alive wineservers on destruction (the default). One-shot
+    // clients turn this off so their servers outlive them for a relaunch.
+    void setStopIdleWineservers(bool enabled) { stopIdleWineservers_ = enabled; }
+
   signals:
     void runnersDiscovered(int count);
     void runnerAdded(const QString &name);
+    void runnerRemoved(const QString &name);
 
   private:
     std::vector<std::unique_ptr<Runner>> runners_;
 
-    void discoverNativeRunner();
-    void discoverWineRunners();
-    void discoverProtonRunners();
-    void discoverDOSBoxRunner();
-    void discoverISATranslators();
+    // Runners that came from discovery, as opposed to registerRunner() callers
+    std::vector<std::pair<RunnerRecord, Runner *>> discovered_;
+    std::vector<RunnerRecord> records_; // As last saved
+    QString registryPath_;
+    bool ready_ = false;
+
+    QFileSystemWatcher watcher_;
+    QTimer rescanTimer_;
+    QThreadPool scanPool_;
+    bool scanning_ = false;
+    bool rescanQueued_ = false;
+    bool stopIdleWineservers_ = true;
 
-    // Platform-specific discovery
-    void discoverLinuxRunners();
-    void discoverWindowsRunners();
-    void discoverMacOSRunners();
+    void onScanFinished(const std::vector<RunnerRecord> &records);
+    void updateRecords(const std::vector<RunnerRecord> &records);
+    void applyRecords(const std::vector<RunnerRecord> &records);
+    void watchDirectories();
+    static std::unique_ptr<Runner> createRunner(const RunnerRecord &record);
 };
 
 } // namespace opengalaxy::runners
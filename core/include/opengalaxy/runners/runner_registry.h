@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "../util/result.h"
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief One discovered runner, as remembered between runs
+ */
+struct RunnerRecord {
+    QString kind;     // dosbox, wine, proton, box64, fex, qemu, rosetta2
+    QString name;     // Runner::name()
+    QString path;     // Executable, or the Proton directory
+    qint64 mtime = 0; // Of path (the proton script for Proton), ms since epoch
+    QString version;  // Probed once at discovery; empty if the runner does not report one
+
+    bool operator==(const RunnerRecord &) const = default;
+};
+
+/**
+ * @brief Runner discovery and its on-disk cache
+ *
+ * scan() is the expensive part: PATH lookups for every runner binary, walks
+ * of the Steam compatibility tool directories and a "dosbox -version" probe
+ * (skipped when the previous records already know the binary's version).
+ * Its result is stored as a small JSON file so the next start can register
+ * runners straight away; isCurrent() is a single stat() per runner to drop
+ * entries whose binary changed or vanished since.
+ */
+class RunnerRegistry {
+  public:
+    // Full discovery; blocking, meant for a worker thread. Versions are taken
+    // from previous for binaries that are still current instead of probed again.
+    static std::vector<RunnerRecord> scan(const std::vector<RunnerRecord> &previous = {});
+
+    // Directories whose contents decide what scan() finds: PATH entries and the
+    // compatibility tool directories that exist
+    static QStringList watchedDirectories();
+
+    // path still exists and has not been modified since the record was made
+    static bool isCurrent(const RunnerRecord &record);
+
+    static util::Result<std::vector<RunnerRecord>> load(const QString &filePath);
+    static util::Result<void> save(const QString &filePath,
+                                   const std::vector<RunnerRecord> &records);
+
+    // <cache>/runners.json
+    static QString defaultPath();
+};
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "runner.h"
+#include <QStringList>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief Per-game shader and pipeline caches kept outside prefixes
+ *
+ * DXVK, VKD3D-Proton, Mesa and the NVIDIA driver all cache compiled shaders,
+ * by default inside the prefix or next to the executable, so a rebuilt prefix
+ * or an updated game starts from scratch and stutters again. Each game gets
+ * <Config::shaderCacheDir()>/<gameId>/ instead, keyed on the library id, and
+ * the Wine and Proton runners point the drivers there.
+ *
+ * Caches are accounted per game and pruned least recently used first.
+ */
+class ShaderCache {
+  public:
+    static QString path(const QString &gameId);
+
+    // Point the caches of the launch at the game's directory, where neither the
+    // game nor the user's environment already set them
+    static void applyTo(LaunchEnvironment &environment, const QString &gameId,
+                        PrefixSpec::Type type);
+
+    // Create the game's cache directories and mark them as used now
+    static void markUsed(const QString &gameId);
+
+    static qint64 size(const QString &gameId);
+    static qint64 totalSize();
+    static bool clear(const QString &gameId);
+    // Every game's cache but those in except, e.g. of games running right now
+    static bool clearAll(const QStringList &except = {});
+
+    // Remove caches of games not in knownGameIds, then least recently used ones
+    // until the total is at most maxBytes. Returns the bytes freed.
+    static qint64 prune(qint64 maxBytes, const QStringList &knownGameIds);
+};
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "runner.h"
+#include <QProcessEnvironment>
+#include <QStringList>
+
+namespace opengalaxy::runners {
+
+/**
+ * @brief Keeps wineserver running for recently used prefixes
+ *
+ * Every Wine start in a prefix without a server boots wineserver and the
+ * prefix's services (services.exe, winedevice.exe, ...), which takes seconds.
+ * With a keep-alive configured (Config::wineserverKeepAlive), the Wine and
+ * Proton runners start the prefix's server as `wineserver -p<seconds>` before
+ * the game, so it outlives the game by that long and a relaunch, or the
+ * game's launcher or config tool, attaches to it instead. The server gets
+ * the game's own environment: Wine refuses to connect a client whose esync
+ * or fsync setting differs from the server's.
+ *
+ * wineserver enforces the idle timeout itself. shutdownIdle() stops kept
+ * servers early, for prefixes where no Windows program is still running; the
+ * runner manager calls it when the client exits. The CLI leaves servers to
+ * their timeout so the next command can reuse them.
+ */
+class WineserverKeepAlive {
+  public:
+    // Seconds a server stays up after its last client; 0 means disabled
+    static int idleTimeout();
+
+    // Start a persistent server for the prefix with the environment the game
+    // runs with, or reuse the running one. False when disabled, or the prefix
+    // or its wineserver does not exist.
+    static bool acquire(const PrefixSpec &spec, const QProcessEnvironment &environment);
+
+    // WINEPREFIX of each server started here
+    static QStringList activePrefixes();
+
+    // Stop kept servers with no Windows program left in their prefix; returns
+    // how many were stopped. Does nothing without /proc to check.
+    static int shutdownIdle();
+};
+
+} // namespace opengalaxy::runners
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <QDir>
+#include <QMap>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QString>
@@ -43,12 +44,15 @@ class Config {
     static void initialize();
 
     // Path getters
-    QString dataDir() const;         // Application data directory
-    QString configDir() const;       // Configuration directory
-    QString sessionFilePath() const; // Session file path
-    QString libraryDbPath() const;   // Library database path
-    QString logFilePath() const;     // Log file path
-    QString defaultGamesDir() const; // Default games installation directory
+    QString dataDir() const;           // Application data directory
+    QString configDir() const;         // Configuration directory
+    QString sessionFilePath() const;   // Session file path
+    QString libraryDbPath() const;     // Library database path
+    QString logFilePath() const;       // Log file path
+    QString imageCacheDir() const;     // Downloaded cover and background images
+    QString prefixTemplateDir() const; // Booted Wine/Proton prefixes new ones are cloned from
+    QString shaderCacheDir() const;    // Per-game DXVK/VKD3D/driver shader caches
+    QString defaultGamesDir() const;   // Default games installation directory
 
     // Settings accessors
     QString gamesDirectory() const;
@@ -69,6 +73,25 @@ class Config {
     bool showHiddenGames() const;
     void setShowHiddenGames(bool enabled);
 
+    bool enableAnimations() const;
+    void setEnableAnimations(bool enabled);
+
+    bool showFrameStats() const; // Debug overlay with paint times
+    void setShowFrameStats(bool enabled);
+
+    bool prewarmPrefixes() const; // Create a game's Wine/Proton prefix right after install
+    void setPrewarmPrefixes(bool enabled);
+
+    int wineserverKeepAlive() const; // Seconds wineserver outlives a game; 0 disables
+    void setWineserverKeepAlive(int seconds);
+
+    int shaderCacheLimitMb() const; // Shader caches are pruned down to this
+    void setShaderCacheLimitMb(int megabytes);
+
+    // Variables set for every game; runner and per-game settings override them
+    QMap<QString, QString> launchEnvironment() const;
+    void setLaunchEnvironment(const QMap<QString, QString> &environment);
+
     // Window state
     QByteArray windowGeometry() const;
     void setWindowGeometry(const QByteArray &geometry);
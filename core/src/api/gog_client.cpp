@@ -85,6 +85,10 @@ void GOGClient::fetchLibrary(GamesCallback callback) {
                     }
                 }
 
+                // Listing only exposes the primary genre
+                const QString category = p.value("category").toString();
+                if (!category.isEmpty()) g.genres << category;
+
                 const QJsonObject worksOn = p.value("worksOn").toObject();
                 if (worksOn.value("Linux").toBool())
                     g.platform = "linux";
@@ -110,6 +114,51 @@ void GOGClient::fetchLibrary(GamesCallback callback) {
 
     fetchPage(fetchPage);
 }
+void GOGClient::fetchGameDetails(const QString &gameId, GameCallback callback) {
+    // Product details are public, but send the token so owned-only fields come back too
+    const QString url = QString("https://api.gog.com/products/%1?locale=%2&expand=description")
+                            .arg(QString(QUrl::toPercentEncoding(gameId)),
+                                 QString(QUrl::toPercentEncoding(locale_)));
+
+    net::HttpClient::Request req;
+    req.url = url;
+    req.method = "GET";
+    if (session_->isAuthenticated()) {
+        req.headers["Authorization"] = buildAuthHeader();
+    }
+
+    httpClient_->request(req, [this, gameId, callback = std::move(callback)](
+                                  util::Result<net::HttpClient::Response> result) mutable {
+        if (!result.isOk()) {
+            callback(util::Result<GameInfo>::error(result.errorMessage()));
+            return;
+        }
+
+        const QJsonObject obj = QJsonDocument::fromJson(result.value().body).object();
+        if (obj.isEmpty()) {
+            callback(util::Result<GameInfo>::error("Invalid product details response"));
+            return;
+        }
+
+        GameInfo game;
+        game.id = gameId;
+        game.title = obj.value("title").toString();
+        game.slug = obj.value("slug").toString();
+        game.releaseDate = QDateTime::fromString(obj.value("release_date").toString(), Qt::ISODate);
+
+        QString background = obj.value("images").toObject().value("background").toString();
+        if (background.startsWith("//")) background = "https:" + background;
+        game.backgroundUrl = background;
+
+        const QJsonObject description = obj.value("description").toObject();
+        game.description = description.value("full").toString();
+        if (game.description.isEmpty()) game.description = description.value("lead").toString();
+
+        emit gameDetailsUpdated(gameId);
+        callback(util::Result<GameInfo>::success(game));
+    });
+}
+
 void GOGClient::fetchGameDownloads(const QString &gameId, GameCallback callback) {
     if (!session_->isAuthenticated()) {
         callback(util::Result<GameInfo>::error("Not authenticated"));
@@ -2,11 +2,13 @@
 #include "opengalaxy/install/install_service.h"
 #include "opengalaxy/api/session.h"
 #include "opengalaxy/install/installer_detector.h"
+#include "opengalaxy/install/progress_throttle.h"
 #include "opengalaxy/net/http_client.h"
 #include "opengalaxy/util/dos_detector.h"
 #include "opengalaxy/util/log.h"
 
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -20,6 +22,7 @@
 #include <QSysInfo>
 #include <QTimer>
 #include <map>
+#include <vector>
 namespace opengalaxy::install {
 
 struct InstallService::InstallTask {
@@ -31,9 +34,16 @@ struct InstallService::InstallTask {
     QNetworkReply *reply = nullptr;
     qint64 downloadedBytes = 0;
     qint64 totalBytes = 0;
+    ProgressThrottle progressThrottle;
+    TransferStats transferStats;
+    QElapsedTimer clock; // Timestamps for progressThrottle and transferStats
+    bool stalled = false;
 };
 
-InstallService::InstallService(QObject *parent) : QObject(parent) {}
+InstallService::InstallService(QObject *parent) : QObject(parent) {
+    statsTimer_.setInterval(1000);
+    connect(&statsTimer_, &QTimer::timeout, this, &InstallService::publishTransferStats);
+}
 
 InstallService::~InstallService() = default;
 
@@ -79,6 +89,7 @@ void InstallService::installGame(const api::GameInfo &game, const QString &insta
         QMutexLocker locker(&tasksMutex_);
         activeTasks_[game.id] = std::move(task);
     }
+    statsTimer_.start();
 
     emit installStarted(game.id);
 
@@ -1175,19 +1186,31 @@ void InstallService::installGame(const api::GameInfo &game, const QString &insta
                     return; // Cancelled
                 }
                 InstallTask *taskPtr = it->second.get();
+                taskPtr->downloadedBytes = received;
+                taskPtr->totalBytes = total;
+
+                if (!taskPtr->clock.isValid()) taskPtr->clock.start();
+                const qint64 now = taskPtr->clock.elapsed();
+                taskPtr->transferStats.addSample(received, total, now);
+
+                // Most ticks stop here: nothing visible changed since the last update
+                ProgressThrottle &throttle = taskPtr->progressThrottle;
+                if (!throttle.update(received, total, now)) {
+                    return;
+                }
 
                 InstallProgress p;
                 p.gameId = taskPtr->gameId;
                 p.downloadedBytes = received;
                 p.totalBytes = total;
                 p.status = "downloading";
-                if (total > 0) {
-                    p.percentage = static_cast<int>((received * 100) / total);
-                }
+                p.percentage = throttle.percentage();
+                p.transfer = taskPtr->transferStats.snapshot(now);
                 locker.unlock();
 
                 if (taskPtr->progressCallback) taskPtr->progressCallback(p);
                 emit installProgress(gameId, p.percentage);
+                emit installTransferStats(gameId, p.transfer);
             });
     });
 }
@@ -1251,4 +1274,81 @@ QString InstallService::getDetectedRunner(const QString &gameId) const {
     return QString();
 }
 
+TransferStats::Snapshot InstallService::transferStats(const QString &gameId) const {
+    QMutexLocker locker(&tasksMutex_);
+    auto it = activeTasks_.find(gameId);
+    if (it == activeTasks_.end() || !it->second->clock.isValid()) {
+        return TransferStats::Snapshot();
+    }
+    return it->second->transferStats.snapshot(it->second->clock.elapsed());
+}
+
+TransferStats::Snapshot InstallService::totalTransferStats() const {
+    QMutexLocker locker(&tasksMutex_);
+    TransferStats::Snapshot total;
+    bool first = true;
+    for (const auto &[gameId, task] : activeTasks_) {
+        if (!task->clock.isValid()) continue;
+        const auto stats = task->transferStats.snapshot(task->clock.elapsed());
+        if (first) {
+            total = stats;
+            first = false;
+        } else {
+            total += stats;
+        }
+    }
+    return total;
+}
+
+QJsonObject InstallService::transferStatus() const {
+    QJsonObject downloads;
+    {
+        QMutexLocker locker(&tasksMutex_);
+        for (const auto &[gameId, task] : activeTasks_) {
+            if (!task->clock.isValid()) continue;
+            downloads[gameId] = task->transferStats.snapshot(task->clock.elapsed()).toJson();
+        }
+    }
+
+    QJsonObject status;
+    status["downloads"] = downloads;
+    status["total"] = totalTransferStats().toJson();
+    return status;
+}
+
+void InstallService::publishTransferStats() {
+    struct Update {
+        QString gameId;
+        TransferStats::Snapshot stats;
+        bool stallChanged;
+    };
+    std::vector<Update> updates;
+
+    {
+        QMutexLocker locker(&tasksMutex_);
+        if (activeTasks_.empty()) {
+            statsTimer_.stop();
+            return;
+        }
+        for (const auto &[gameId, task] : activeTasks_) {
+            if (!task->clock.isValid()) continue; // Not downloading (yet)
+            const auto stats = task->transferStats.snapshot(task->clock.elapsed());
+            if (stats.totalBytes > 0 && stats.receivedBytes >= stats.totalBytes) continue;
+
+            const bool stallChanged = stats.stalled != task->stalled;
+            task->stalled = stats.stalled;
+            updates.push_back({gameId, stats, stallChanged});
+        }
+    }
+
+    for (const auto &update : updates) {
+        if (update.stallChanged) {
+            LOG_INFO(QString("Download %1: %2")
+                         .arg(update.gameId, update.stats.stalled ? "stalled" : "resumed"));
+            emit installStalled(update.gameId, update.stats.stalled);
+        }
+        emit installTransferStats(update.gameId, update.stats);
+    }
+}
+
 } // namespace opengalaxy::install
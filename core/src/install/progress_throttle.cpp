@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/install/progress_throttle.h"
+
+namespace opengalaxy::install {
+
+ProgressThrottle::ProgressThrottle(int maxHz) : minIntervalMs_(maxHz > 0 ? 1000 / maxHz : 0) {}
+
+void ProgressThrottle::reset() {
+    received_ = 0;
+    total_ = 0;
+    percentage_ = 0;
+    publishedPercentage_ = -1;
+    publishedAtMs_ = 0;
+}
+
+bool ProgressThrottle::update(qint64 receivedBytes, qint64 totalBytes, qint64 nowMs) {
+    received_ = receivedBytes;
+    total_ = totalBytes;
+    percentage_ = totalBytes > 0 ? static_cast<int>((receivedBytes * 100) / totalBytes) : 0;
+
+    const bool first = publishedPercentage_ < 0;
+    const bool finished = totalBytes > 0 && receivedBytes >= totalBytes;
+    const bool changed = percentage_ != publishedPercentage_;
+    const bool due = nowMs - publishedAtMs_ >= minIntervalMs_;
+
+    if (!first && !(changed && (due || finished))) return false;
+
+    publishedPercentage_ = percentage_;
+    publishedAtMs_ = nowMs;
+    return true;
+}
+
+} // namespace opengalaxy::install
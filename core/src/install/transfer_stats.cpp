@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/install/transfer_stats.h"
+
+#include <cmath>
+
+namespace opengalaxy::install {
+
+namespace {
+qint64 etaFor(qint64 received, qint64 total, double rate) {
+    if (total <= 0 || rate <= 0) return -1;
+    if (received >= total) return 0;
+    return static_cast<qint64>(std::ceil((total - received) / rate));
+}
+} // namespace
+
+QString TransferStats::Snapshot::toString() const {
+    if (stalled) return QStringLiteral("stalled");
+    QString text = formatRate(smoothedBytesPerSecond);
+    if (etaSeconds >= 0) {
+        text += QStringLiteral(", %1 left").arg(formatDuration(etaSeconds));
+    }
+    return text;
+}
+
+QJsonObject TransferStats::Snapshot::toJson() const {
+    QJsonObject json;
+    json["receivedBytes"] = receivedBytes;
+    json["totalBytes"] = totalBytes;
+    json["instantBytesPerSecond"] = instantBytesPerSecond;
+    json["smoothedBytesPerSecond"] = smoothedBytesPerSecond;
+    json["averageBytesPerSecond"] = averageBytesPerSecond;
+    json["etaSeconds"] = etaSeconds;
+    json["elapsedMs"] = elapsedMs;
+    json["stalled"] = stalled;
+    return json;
+}
+
+TransferStats::Snapshot &TransferStats::Snapshot::operator+=(const Snapshot &other) {
+    receivedBytes += other.receivedBytes;
+    totalBytes += other.totalBytes;
+    instantBytesPerSecond += other.instantBytesPerSecond;
+    smoothedBytesPerSecond += other.smoothedBytesPerSecond;
+    averageBytesPerSecond += other.averageBytesPerSecond;
+    elapsedMs = qMax(elapsedMs, other.elapsedMs);
+    etaSeconds = etaFor(receivedBytes, totalBytes, smoothedBytesPerSecond);
+    // The aggregate is stalled only when nothing is moving at all
+    stalled = stalled && other.stalled;
+    return *this;
+}
+
+TransferStats::TransferStats(qint64 stallTimeoutMs) : stallTimeoutMs_(stallTimeoutMs) {}
+
+void TransferStats::reset() { *this = TransferStats(stallTimeoutMs_); }
+
+void TransferStats::addSample(qint64 receivedBytes, qint64 totalBytes, qint64 nowMs) {
+    total_ = totalBytes;
+
+    if (startMs_ < 0) {
+        startMs_ = lastSampleMs_ = lastProgressMs_ = nowMs;
+        bucketStartMs_ = previousBucketStartMs_ = nowMs;
+        startBytes_ = received_ = lastSampleBytes_ = receivedBytes;
+        bucketStartBytes_ = previousBucketStartBytes_ = receivedBytes;
+        return;
+    }
+
+    if (receivedBytes > received_) lastProgressMs_ = nowMs;
+    received_ = receivedBytes;
+
+    if (nowMs - bucketStartMs_ >= kInstantWindowMs) {
+        previousBucketStartMs_ = bucketStartMs_;
+        previousBucketStartBytes_ = bucketStartBytes_;
+        bucketStartMs_ = nowMs;
+        bucketStartBytes_ = receivedBytes;
+    }
+
+    // Chunks often arrive several per millisecond; fold them into the next step
+    const qint64 dt = nowMs - lastSampleMs_;
+    if (dt <= 0) return;
+
+    const double rate = (receivedBytes - lastSampleBytes_) * 1000.0 / dt;
+    if (smoothedValid_) {
+        const double alpha = 1.0 - std::exp(-double(dt) / kSmoothingMs);
+        smoothed_ += alpha * (rate - smoothed_);
+    } else {
+        smoothed_ = rate;
+        smoothedValid_ = true;
+    }
+    lastSampleMs_ = nowMs;
+    lastSampleBytes_ = receivedBytes;
+}
+
+bool TransferStats::isStalled(qint64 nowMs) const {
+    if (startMs_ < 0) return false;
+    if (total_ > 0 && received_ >= total_) return false;
+    return nowMs - lastProgressMs_ >= stallTimeoutMs_;
+}
+
+TransferStats::Snapshot TransferStats::snapshot(qint64 nowMs) const {
+    Snapshot s;
+    s.receivedBytes = received_;
+    s.totalBytes = total_;
+    if (startMs_ < 0) return s;
+
+    s.elapsedMs = nowMs - startMs_;
+    s.stalled = isStalled(nowMs);
+    if (s.elapsedMs > 0) {
+        s.averageBytesPerSecond = (received_ - startBytes_) * 1000.0 / s.elapsedMs;
+    }
+
+    // Time without samples counts as time at zero speed
+    const qint64 silentMs = nowMs - lastSampleMs_;
+    s.smoothedBytesPerSecond = smoothed_;
+    if (silentMs > kInstantWindowMs) {
+        s.smoothedBytesPerSecond *= std::exp(-double(silentMs) / kSmoothingMs);
+    }
+    if (silentMs < 2 * kInstantWindowMs && lastSampleMs_ > previousBucketStartMs_) {
+        s.instantBytesPerSecond =
+            (received_ - previousBucketStartBytes_) * 1000.0 / (nowMs - previousBucketStartMs_);
+    }
+
+    s.etaSeconds = s.stalled ? -1 : etaFor(received_, total_, s.smoothedBytesPerSecond);
+    return s;
+}
+
+QString TransferStats::formatRate(double bytesPerSecond) {
+    static const char *units[] = {"B/s", "KB/s", "MB/s", "GB/s"};
+    int unit = 0;
+    while (bytesPerSecond >= 1000 && unit < 3) {
+        bytesPerSecond /= 1000;
+        ++unit;
+    }
+    return QStringLiteral("%1 %2")
+        .arg(bytesPerSecond, 0, 'f', unit == 0 ? 0 : 1)
+        .arg(QLatin1String(units[unit]));
+}
+
+QString TransferStats::formatDuration(qint64 seconds) {
+    if (seconds < 60) return QStringLiteral("%1s").arg(seconds);
+    if (seconds < 3600) return QStringLiteral("%1m").arg((seconds + 59) / 60);
+    return QStringLiteral("%1h %2m").arg(seconds / 3600).arg((seconds % 3600) / 60);
+}
+
+} // namespace opengalaxy::install
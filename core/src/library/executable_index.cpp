@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/library/executable_index.h"
+#include "opengalaxy/runners/binary_info.h"
+#include "opengalaxy/util/log.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+namespace opengalaxy::library {
+
+namespace {
+
+constexpr int kMaxDepth = 6;
+constexpr int kMaxHeuristicEntries = 16;
+
+// Directories that never hold the game itself: Windows system files in a prefix,
+// redistributable installers and GOG's support files
+bool isSkippedDirectory(const QString &name) {
+    static const QStringList skipped = {"windows", "programdata", "users", "common files",
+                                        "internet explorer", "__redist", "_commonredist",
+                                        "redist", "directx", "vcredist", "dotnet", "__support",
+                                        "support", "__installer", "dosbox", "scummvm"};
+    return skipped.contains(name.toLower());
+}
+
+bool isInstallerName(const QString &fileName) {
+    static const QStringList patterns = {"setup",   "install",     "unins",   "patch",
+                                         "update",  "redist",      "dxsetup", "crashreport",
+                                         "crashpad"};
+    const QString lower = fileName.toLower();
+    return std::any_of(patterns.begin(), patterns.end(),
+                       [&lower](const QString &p) { return lower.contains(p); });
+}
+
+// DOSBox and ScummVM ship inside many GOG packages; the host runners replace them
+bool isBundledEmulator(const QString &fileName) {
+    const QString lower = fileName.toLower();
+    return lower.startsWith("dosbox") || lower.startsWith("scummvm");
+}
+
+bool isCandidate(const QFileInfo &info) {
+    const QString suffix = info.suffix().toLower();
+    if (suffix == "exe" || suffix == "com" || suffix == "bat" || suffix == "sh") return true;
+    // Native Linux binaries usually have no suffix
+    return suffix.isEmpty() && info.isExecutable() &&
+           runners::BinaryInspector::inspect(info.absoluteFilePath()).format ==
+               runners::BinaryInfo::Format::ELF;
+}
+
+GameExecutable makeEntry(const QFileInfo &info) {
+    GameExecutable entry;
+    entry.path = info.absoluteFilePath();
+    entry.workingDirectory = info.absolutePath();
+    entry.name = info.completeBaseName();
+    entry.size = info.size();
+    entry.mtime = info.lastModified().toMSecsSinceEpoch();
+    return entry;
+}
+
+// Windows paths from .info files; Linux filesystems are case-sensitive, so fall
+// back to a case-insensitive match one component at a time
+QString resolvePath(const QString &baseDir, const QString &windowsPath) {
+    QString relative = windowsPath;
+    relative.replace('\\', '/');
+    const QString direct = QDir(baseDir).absoluteFilePath(relative);
+    if (QFileInfo::exists(direct)) return QDir::cleanPath(direct);
+
+    QDir dir(baseDir);
+    const QStringList parts = relative.split('/', Qt::SkipEmptyParts);
+    for (int i = 0; i < parts.size(); ++i) {
+        if (parts[i] == ".") continue;
+        if (parts[i] == "..") {
+            if (!dir.cdUp()) return {};
+            continue;
+        }
+        const QStringList entries = dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot);
+        const auto match = std::find_if(entries.begin(), entries.end(), [&](const QString &e) {
+            return e.compare(parts[i], Qt::CaseInsensitive) == 0;
+        });
+        if (match == entries.end()) return {};
+        if (i == parts.size() - 1) return dir.absoluteFilePath(*match);
+        if (!dir.cd(*match)) return {};
+    }
+    return {};
+}
+
+void findInfoFiles(const QDir &dir, int depth, QFileInfoList &out) {
+    out += dir.entryInfoList({"goggame-*.info"}, QDir::Files);
+    if (depth >= kMaxDepth) return;
+    for (const QFileInfo &sub : dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!sub.isSymLink() && !isSkippedDirectory(sub.fileName())) {
+            findInfoFiles(QDir(sub.absoluteFilePath()), depth + 1, out);
+        }
+    }
+}
+
+void fromInfoFile(const QFileInfo &infoFile, std::vector<GameExecutable> &out) {
+    QFile file(infoFile.absoluteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+    const QJsonObject info = QJsonDocument::fromJson(file.readAll()).object();
+    const QString baseDir = infoFile.absolutePath();
+
+    // DLC info files have no play tasks; base game tasks come first in the file
+    const QJsonArray tasks = info.value("playTasks").toArray();
+    int order = 0;
+    for (const QJsonValue &value : tasks) {
+        const QJsonObject task = value.toObject();
+        if (task.value("type").toString() != "FileTask") continue;
+
+        const QString category = task.value("category").toString();
+        if (category != "game" && category != "launcher") continue;
+
+        const QString path = resolvePath(baseDir, task.value("path").toString());
+        if (path.isEmpty() || isBundledEmulator(QFileInfo(path).fileName())) continue;
+
+        GameExecutable entry = makeEntry(QFileInfo(path));
+        entry.source = GameExecutable::Source::GogInfo;
+        entry.arguments = task.value("arguments").toString();
+        entry.name = task.value("name").toString(entry.name);
+
+        const QString workingDir = task.value("workingDir").toString();
+        if (!workingDir.isEmpty()) {
+            const QString resolved = resolvePath(baseDir, workingDir);
+            if (!resolved.isEmpty()) entry.workingDirectory = resolved;
+        }
+
+        // Always above any guess
+        entry.rank = 1000 - order++;
+        if (task.value("isPrimary").toBool()) entry.rank += 100;
+        out.push_back(entry);
+    }
+}
+
+int heuristicRank(const QFileInfo &info, int depth, bool atInstallRoot) {
+    const QString fileName = info.fileName();
+    const QString suffix = info.suffix().toLower();
+
+    int rank = 100;
+    // GOG's Linux packages put their launcher here
+    if (atInstallRoot && fileName == "start.sh") rank += 300;
+    if (isInstallerName(fileName)) rank -= 200;
+    if (suffix == "bat") rank -= 20;
+    if (suffix == "sh" && fileName != "start.sh") rank -= 10;
+    rank -= depth * 10;
+    rank += static_cast<int>(std::min<qint64>(info.size() >> 20, 50)); // MiB, capped
+    return rank;
+}
+
+void collectCandidates(const QDir &dir, int depth, bool isInstallRoot,
+                       std::vector<GameExecutable> &out) {
+    for (const QFileInfo &info : dir.entryInfoList(QDir::Files)) {
+        if (!isCandidate(info) || isBundledEmulator(info.fileName())) continue;
+        GameExecutable entry = makeEntry(info);
+        entry.rank = heuristicRank(info, depth, isInstallRoot && depth == 0);
+        out.push_back(entry);
+    }
+
+    if (depth >= kMaxDepth) return;
+    for (const QFileInfo &sub : dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!sub.isSymLink() && !isSkippedDirectory(sub.fileName())) {
+            collectCandidates(QDir(sub.absoluteFilePath()), depth + 1, isInstallRoot, out);
+        }
+    }
+}
+
+} // namespace
+
+std::vector<GameExecutable> ExecutableIndex::build(const QString &installPath) {
+    std::vector<GameExecutable> entries;
+    if (!QFileInfo(installPath).isDir()) return entries;
+
+    // Wine/Proton prefixes are hidden directories, so the install root walk skips
+    // them; their drive_c is searched as a root of its own
+    const QStringList prefixRoots = {installPath + "/.wine/drive_c",
+                                     installPath + "/.proton/pfx/drive_c"};
+
+    QFileInfoList infoFiles;
+    findInfoFiles(QDir(installPath), 0, infoFiles);
+    for (const QString &root : prefixRoots) {
+        if (QFileInfo(root).isDir()) findInfoFiles(QDir(root), 0, infoFiles);
+    }
+    for (const QFileInfo &infoFile : infoFiles) {
+        fromInfoFile(infoFile, entries);
+    }
+
+    std::vector<GameExecutable> guesses;
+    collectCandidates(QDir(installPath), 0, true, guesses);
+    for (const QString &root : prefixRoots) {
+        if (QFileInfo(root).isDir()) collectCandidates(QDir(root), 0, false, guesses);
+    }
+    std::stable_sort(guesses.begin(), guesses.end(),
+                     [](const auto &a, const auto &b) { return a.rank > b.rank; });
+    if (guesses.size() > kMaxHeuristicEntries) guesses.resize(kMaxHeuristicEntries);
+
+    for (auto &guess : guesses) {
+        const bool known = std::any_of(entries.begin(), entries.end(),
+                                       [&guess](const auto &e) { return e.path == guess.path; });
+        if (!known) entries.push_back(std::move(guess));
+    }
+
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const auto &a, const auto &b) { return a.rank > b.rank; });
+    if (!entries.empty()) entries.front().isPrimary = true;
+
+    LOG_INFO(QString("Indexed %1 executables in %2 (%3 from GOG play tasks)")
+                 .arg(entries.size())
+                 .arg(installPath)
+                 .arg(std::count_if(entries.begin(), entries.end(), [](const auto &e) {
+                     return e.source == GameExecutable::Source::GogInfo;
+                 })));
+    return entries;
+}
+
+bool ExecutableIndex::isCurrent(const GameExecutable &executable) {
+    const QFileInfo info(executable.path);
+    return info.isFile() && info.size() == executable.size &&
+           info.lastModified().toMSecsSinceEpoch() == executable.mtime;
+}
+
+QString ExecutableIndex::sourceToString(GameExecutable::Source source) {
+    return source == GameExecutable::Source::GogInfo ? "goggame" : "heuristic";
+}
+
+GameExecutable::Source ExecutableIndex::sourceFromString(const QString &source) {
+    return source == "goggame" ? GameExecutable::Source::GogInfo
+                               : GameExecutable::Source::Heuristic;
+}
+
+} // namespace opengalaxy::library
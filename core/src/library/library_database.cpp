@@ -0,0 +1,430 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "library_database.h"
+#include "opengalaxy/util/log.h"
+
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QStringList>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace opengalaxy::library {
+
+namespace {
+
+bool execStatement(QSqlQuery &query, const QString &sql) {
+    if (!query.exec(sql)) {
+        LOG_ERROR(QString("Migration statement failed: %1 (%2)")
+                      .arg(sql.simplified(), query.lastError().text()));
+        return false;
+    }
+    return true;
+}
+
+QSet<QString> tableColumns(QSqlDatabase &db, const QString &table) {
+    QSet<QString> columns;
+    QSqlQuery query(db);
+    if (query.exec(QString("PRAGMA table_info(%1)").arg(table))) {
+        while (query.next()) {
+            columns.insert(query.value(1).toString());
+        }
+    }
+    return columns;
+}
+
+// v1: the games table as it existed before versioning. Older databases may be
+// missing the per-game property columns, so add whatever is not there yet.
+bool createGamesTable(QSqlDatabase &db) {
+    QSqlQuery query(db);
+
+    if (!execStatement(query, R"(
+        CREATE TABLE IF NOT EXISTS games (
+                id TEXT PRIMARY KEY,
+                title TEXT NOT NULL,
+                platform TEXT,
+                coverUrl TEXT,
+                backgroundUrl TEXT,
+                developer TEXT,
+                publisher TEXT,
+                releaseDate TEXT,
+                description TEXT,
+                isInstalled INTEGER DEFAULT 0,
+                installPath TEXT,
+                version TEXT,
+                size INTEGER DEFAULT 0,
+                preferredRunner TEXT,
+                runnerExecutable TEXT,
+                runnerArguments TEXT,
+                extraEnvironment TEXT,
+                slug TEXT,
+                hiddenInLibrary INTEGER DEFAULT 0,
+                enableMangoHud INTEGER DEFAULT 0,
+                enableDxvkHudFps INTEGER DEFAULT 0,
+                enableGameMode INTEGER DEFAULT 0,
+                enableCloudSaves INTEGER DEFAULT 1
+        )
+    )")) {
+        return false;
+    }
+
+    static const std::vector<std::pair<QString, QString>> lateColumns = {
+        {"preferredRunner", "TEXT"},
+        {"runnerExecutable", "TEXT"},
+        {"runnerArguments", "TEXT"},
+        {"extraEnvironment", "TEXT"},
+        {"slug", "TEXT"},
+        {"hiddenInLibrary", "INTEGER DEFAULT 0"},
+        {"enableMangoHud", "INTEGER DEFAULT 0"},
+        {"enableDxvkHudFps", "INTEGER DEFAULT 0"},
+        {"enableGameMode", "INTEGER DEFAULT 0"},
+        {"enableCloudSaves", "INTEGER DEFAULT 1"},
+    };
+
+    const QSet<QString> existing = tableColumns(db, "games");
+    for (const auto &[name, type] : lateColumns) {
+        if (existing.contains(name)) continue;
+        if (!execStatement(query, QString("ALTER TABLE games ADD COLUMN %1 %2").arg(name, type))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// v2: genres, downloads, environment and runner arguments move into child
+// tables. The packed games.runnerArguments / games.extraEnvironment values are
+// copied over and then cleared, so an older build opening the file sees no
+// arguments or environment. The columns stay only because SQLite before 3.35
+// cannot drop them.
+bool createChildTables(QSqlDatabase &db) {
+    QSqlQuery query(db);
+
+    const QStringList ddl = {
+        R"(CREATE TABLE IF NOT EXISTS game_genres (
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                genre TEXT NOT NULL,
+                PRIMARY KEY (gameId, genre)
+        ))",
+        "CREATE INDEX IF NOT EXISTS idx_game_genres_genre ON game_genres(genre COLLATE NOCASE)",
+        R"(CREATE TABLE IF NOT EXISTS game_downloads (
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                position INTEGER NOT NULL,
+                url TEXT NOT NULL,
+                platform TEXT,
+                language TEXT,
+                version TEXT,
+                size INTEGER DEFAULT 0,
+                checksumUrl TEXT,
+                PRIMARY KEY (gameId, position)
+        ))",
+        "CREATE INDEX IF NOT EXISTS idx_game_downloads_platform "
+        "ON game_downloads(platform COLLATE NOCASE)",
+        R"(CREATE TABLE IF NOT EXISTS game_environment (
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                key TEXT NOT NULL,
+                value TEXT,
+                PRIMARY KEY (gameId, key)
+        ))",
+        R"(CREATE TABLE IF NOT EXISTS game_runner_arguments (
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                position INTEGER NOT NULL,
+                argument TEXT NOT NULL,
+                PRIMARY KEY (gameId, position)
+        ))",
+    };
+
+    for (const QString &statement : ddl) {
+        if (!execStatement(query, statement)) return false;
+    }
+
+    // Backfill from the packed columns
+    QSqlQuery select(db);
+    if (!select.exec("SELECT id, runnerArguments, extraEnvironment FROM games")) {
+        LOG_ERROR(QString("Migration backfill failed: %1").arg(select.lastError().text()));
+        return false;
+    }
+
+    QSqlQuery insertArg(db);
+    insertArg.prepare(
+        "INSERT INTO game_runner_arguments (gameId, position, argument) VALUES (?, ?, ?)");
+    QSqlQuery insertEnv(db);
+    insertEnv.prepare(
+        "INSERT OR REPLACE INTO game_environment (gameId, key, value) VALUES (?, ?, ?)");
+
+    while (select.next()) {
+        const QString gameId = select.value(0).toString();
+
+        const QStringList args = select.value(1).toString().split('\n', Qt::SkipEmptyParts);
+        for (int i = 0; i < args.size(); ++i) {
+            insertArg.addBindValue(gameId);
+            insertArg.addBindValue(i);
+            insertArg.addBindValue(args[i]);
+            if (!insertArg.exec()) {
+                LOG_ERROR(
+                    QString("Migration backfill failed: %1").arg(insertArg.lastError().text()));
+                return false;
+            }
+        }
+
+        const QString envJson = select.value(2).toString();
+        if (envJson.isEmpty()) continue;
+        const QJsonObject env = QJsonDocument::fromJson(envJson.toUtf8()).object();
+        for (auto it = env.begin(); it != env.end(); ++it) {
+            insertEnv.addBindValue(gameId);
+            insertEnv.addBindValue(it.key());
+            insertEnv.addBindValue(it.value().toString());
+            if (!insertEnv.exec()) {
+                LOG_ERROR(
+                    QString("Migration backfill failed: %1").arg(insertEnv.lastError().text()));
+                return false;
+            }
+        }
+    }
+
+    return execStatement(query, "UPDATE games SET runnerArguments = NULL, extraEnvironment = NULL");
+}
+
+// v3: play-session log and per-game aggregates. Sessions are only ever
+// appended (and closed once on exit); game_play_stats is maintained
+// incrementally alongside so "recently played" never has to scan the log.
+bool createPlaySessionTables(QSqlDatabase &db) {
+    QSqlQuery query(db);
+
+    const QStringList ddl = {
+        R"(CREATE TABLE IF NOT EXISTS play_sessions (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                runner TEXT,
+                startedAt INTEGER NOT NULL,
+                endedAt INTEGER,
+                exitCode INTEGER,
+                crashed INTEGER DEFAULT 0
+        ))",
+        "CREATE INDEX IF NOT EXISTS idx_play_sessions_game ON play_sessions(gameId, startedAt)",
+        "CREATE INDEX IF NOT EXISTS idx_play_sessions_runner ON play_sessions(runner)",
+        R"(CREATE TABLE IF NOT EXISTS game_play_stats (
+                gameId TEXT PRIMARY KEY REFERENCES games(id) ON DELETE CASCADE,
+                launchCount INTEGER NOT NULL DEFAULT 0,
+                totalSeconds INTEGER NOT NULL DEFAULT 0,
+                lastPlayedAt INTEGER
+        ))",
+        "CREATE INDEX IF NOT EXISTS idx_game_play_stats_last ON game_play_stats(lastPlayedAt)",
+    };
+
+    for (const QString &statement : ddl) {
+        if (!execStatement(query, statement)) return false;
+    }
+    return true;
+}
+
+// v4: launch targets found at install time (GOG play tasks and ranked guesses),
+// so launching a game is a lookup rather than a walk of its install tree.
+bool createExecutableTable(QSqlDatabase &db) {
+    QSqlQuery query(db);
+    return execStatement(query, R"(CREATE TABLE IF NOT EXISTS game_executables (
+                gameId TEXT NOT NULL REFERENCES games(id) ON DELETE CASCADE,
+                path TEXT NOT NULL,
+                arguments TEXT,
+                workingDir TEXT,
+                name TEXT,
+                source TEXT,
+                rank INTEGER NOT NULL DEFAULT 0,
+                isPrimary INTEGER NOT NULL DEFAULT 0,
+                size INTEGER,
+                mtime INTEGER,
+                PRIMARY KEY (gameId, path)
+        ))");
+}
+
+// v5: per-game launch profile (CPU affinity, priorities, cgroup limits)
+bool addLaunchProfileColumns(QSqlDatabase &db) {
+    QSqlQuery query(db);
+
+    static const std::vector<std::pair<QString, QString>> columns = {
+        {"cpuAffinity", "TEXT"},
+        {"niceLevel", "INTEGER DEFAULT 0"},
+        {"ioClass", "INTEGER DEFAULT 0"},
+        {"ioLevel", "INTEGER DEFAULT 4"},
+        {"schedIso", "INTEGER DEFAULT 0"},
+        {"cgroupSlice", "TEXT"},
+        {"memoryMax", "TEXT"},
+        {"cpuQuotaPercent", "INTEGER DEFAULT 0"},
+    };
+
+    for (const auto &[name, type] : columns) {
+        if (!execStatement(query, QString("ALTER TABLE games ADD COLUMN %1 %2").arg(name, type))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Migration {
+    int version;
+    const char *description;
+    bool (*apply)(QSqlDatabase &db);
+};
+
+// Append new migrations at the end; never edit one that has shipped.
+const Migration kMigrations[] = {
+    {1, "games table", createGamesTable},
+    {2, "genre, download, environment and argument tables", createChildTables},
+    {3, "play session log and aggregates", createPlaySessionTables},
+    {4, "executable index", createExecutableTable},
+    {5, "launch profile", addLaunchProfileColumns},
+};
+
+constexpr const char *kConnectionName = "library";
+
+} // namespace
+
+LibraryDatabase::LibraryDatabase() {
+    QString dbPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dbPath);
+
+    db_ = QSqlDatabase::addDatabase("QSQLITE", kConnectionName);
+    db_.setDatabaseName(dbPath + "/library.db");
+
+    if (!db_.open()) {
+        LOG_ERROR("Failed to open library database");
+        return;
+    }
+
+    configure();
+}
+
+void LibraryDatabase::configure() {
+    // All of these must run outside of any transaction
+    QSqlQuery query(db_);
+    if (!query.exec("PRAGMA foreign_keys = ON")) {
+        LOG_WARNING(QString("Failed to enable foreign keys: %1").arg(query.lastError().text()));
+    }
+
+    // auto_vacuum only takes effect on an empty file or after a VACUUM, so databases
+    // created by older builds are rebuilt once. Has to happen before switching to WAL.
+    constexpr int kIncrementalVacuum = 2;
+    if (pragma("auto_vacuum").toInt() != kIncrementalVacuum) {
+        const bool hasTables = pragma("page_count").toLongLong() > 1;
+        if (!query.exec("PRAGMA auto_vacuum = INCREMENTAL") ||
+            (hasTables && !query.exec("VACUUM"))) {
+            LOG_WARNING(QString("Failed to enable incremental auto-vacuum: %1")
+                            .arg(query.lastError().text()));
+        } else if (hasTables) {
+            LOG_INFO("Library database converted to incremental auto-vacuum");
+        }
+    }
+
+    // WAL lets readers (the CLI, the startup cache writer) proceed during a sync;
+    // NORMAL sync is durable across application crashes in WAL mode
+    if (!query.exec("PRAGMA journal_mode = WAL") || !query.next() ||
+        query.value(0).toString().compare("wal", Qt::CaseInsensitive) != 0) {
+        LOG_WARNING("Library database is not in WAL mode");
+    }
+    query.finish();
+    if (!query.exec("PRAGMA synchronous = NORMAL")) {
+        LOG_WARNING(QString("Failed to set synchronous mode: %1").arg(query.lastError().text()));
+    }
+}
+
+QVariant LibraryDatabase::pragma(const QString &name) const {
+    QSqlQuery query(db_);
+    if (query.exec("PRAGMA " + name) && query.next()) {
+        return query.value(0);
+    }
+    return {};
+}
+
+bool LibraryDatabase::checkpoint() {
+    QSqlQuery query(db_);
+    if (!query.exec("PRAGMA wal_checkpoint(TRUNCATE)") || !query.next()) {
+        LOG_WARNING(QString("WAL checkpoint failed: %1").arg(query.lastError().text()));
+        return false;
+    }
+    // Columns: busy, WAL frames, frames checkpointed
+    return query.value(0).toInt() == 0;
+}
+
+int LibraryDatabase::incrementalVacuum(int maxPages) {
+    const int freePages = pragma("freelist_count").toInt();
+    if (freePages <= 0) return 0;
+
+    // Each result row releases one page, so the statement has to be stepped to the end
+    QSqlQuery query(db_);
+    if (!query.exec(QString("PRAGMA incremental_vacuum(%1)").arg(qMin(freePages, maxPages)))) {
+        LOG_WARNING(QString("Incremental vacuum failed: %1").arg(query.lastError().text()));
+        return 0;
+    }
+    while (query.next()) {
+    }
+    query.finish();
+
+    return freePages - pragma("freelist_count").toInt();
+}
+
+void LibraryDatabase::optimize() {
+    QSqlQuery query(db_);
+    const bool analyzed =
+        query.exec("SELECT 1 FROM sqlite_master WHERE name = 'sqlite_stat1'") && query.next();
+    query.finish();
+
+    if (!query.exec(analyzed ? "PRAGMA optimize" : "ANALYZE")) {
+        LOG_WARNING(QString("Database optimize failed: %1").arg(query.lastError().text()));
+    }
+}
+
+LibraryDatabase::~LibraryDatabase() {
+    db_.close();
+    db_ = QSqlDatabase();
+    QSqlDatabase::removeDatabase(kConnectionName);
+}
+
+int LibraryDatabase::schemaVersion() const {
+    QSqlQuery query(db_);
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+int LibraryDatabase::latestSchemaVersion() {
+    return kMigrations[std::size(kMigrations) - 1].version;
+}
+
+bool LibraryDatabase::migrate() {
+    int current = schemaVersion();
+
+    for (const Migration &migration : kMigrations) {
+        if (migration.version <= current) continue;
+
+        if (!db_.transaction()) {
+            LOG_ERROR(QString("Failed to start migration to schema v%1").arg(migration.version));
+            return false;
+        }
+
+        QSqlQuery query(db_);
+        if (!migration.apply(db_) ||
+            !query.exec(QString("PRAGMA user_version = %1").arg(migration.version)) ||
+            !db_.commit()) {
+            db_.rollback();
+            LOG_ERROR(QString("Library database migration to schema v%1 (%2) failed")
+                          .arg(migration.version)
+                          .arg(migration.description));
+            return false;
+        }
+
+        LOG_INFO(QString("Library database migrated to schema v%1 (%2)")
+                     .arg(migration.version)
+                     .arg(migration.description));
+        current = migration.version;
+    }
+
+    return true;
+}
+
+} // namespace opengalaxy::library
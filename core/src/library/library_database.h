@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QVariant>
+
+namespace opengalaxy::library {
+
+/**
+ * @brief SQLite connection behind LibraryService
+ *
+ * Owns the "library" connection and keeps its schema current. The schema
+ * version lives in PRAGMA user_version; every migration runs in its own
+ * transaction together with the version bump, so an interrupted upgrade
+ * leaves the database at the last fully applied version.
+ *
+ * The file runs in WAL mode with incremental auto-vacuum; the maintenance
+ * helpers below are driven by LibraryService when the library is idle.
+ */
+class LibraryDatabase {
+  public:
+    LibraryDatabase();
+    ~LibraryDatabase();
+
+    QSqlDatabase &database() { return db_; }
+    QString filePath() const { return db_.databaseName(); }
+
+    // Apply all pending migrations (returns false if one of them failed)
+    bool migrate();
+
+    // Version currently stored in the database file
+    int schemaVersion() const;
+
+    // Version this build migrates to
+    static int latestSchemaVersion();
+
+    // Value of a read-only PRAGMA (e.g. "page_count"), invalid on error
+    QVariant pragma(const QString &name) const;
+
+    // Fold the WAL back into the main file and truncate it (false if readers kept it busy)
+    bool checkpoint();
+    // Release up to maxPages free pages to the filesystem; returns the pages released
+    int incrementalVacuum(int maxPages);
+    // Refresh query planner statistics (full ANALYZE the first time)
+    void optimize();
+
+  private:
+    void configure();
+
+    QSqlDatabase db_;
+};
+
+} // namespace opengalaxy::library
@@ -1,51 +1,267 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "opengalaxy/library/library_service.h"
+#include "library_database.h"
+#include "opengalaxy/runners/shader_cache.h"
+#include "opengalaxy/util/config.h"
 #include "opengalaxy/util/log.h"
 
-#include <QDir>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QSqlDatabase>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QSqlError>
 #include <QSqlQuery>
-#include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
 
 namespace opengalaxy::library {
 
-class LibraryDatabase {
-  public:
-    LibraryDatabase() {
-        QString dbPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-        QDir().mkpath(dbPath);
+namespace {
 
-        db_ = QSqlDatabase::addDatabase("QSQLITE", "library");
-        db_.setDatabaseName(dbPath + "/library.db");
+// Maintenance runs once the library has seen no writes for this long
+constexpr int kMaintenanceIdleMs = 30 * 1000;
+// Bounds how long a single idle pass can hold the write lock
+constexpr int kVacuumPagesPerPass = 256;
 
-        if (!db_.open()) {
-            LOG_ERROR("Failed to open library database");
+// Column list shared by every games query; readGameRow() depends on this order
+constexpr const char *kGameColumns =
+    "id, title, platform, coverUrl, backgroundUrl, developer, publisher, description, "
+    "releaseDate, isInstalled, installPath, version, size, preferredRunner, runnerExecutable, "
+    "slug, hiddenInLibrary, enableMangoHud, enableDxvkHudFps, enableGameMode, enableCloudSaves, "
+    "cpuAffinity, niceLevel, ioClass, ioLevel, schedIso, cgroupSlice, memoryMax, cpuQuotaPercent";
+
+api::GameInfo readGameRow(const QSqlQuery &query) {
+    api::GameInfo game;
+    game.id = query.value(0).toString();
+    game.title = query.value(1).toString();
+    game.platform = query.value(2).toString();
+    game.coverUrl = query.value(3).toString();
+    game.backgroundUrl = query.value(4).toString();
+    game.developer = query.value(5).toString();
+    game.publisher = query.value(6).toString();
+    game.description = query.value(7).toString();
+    game.releaseDate = QDateTime::fromString(query.value(8).toString(), Qt::ISODate);
+    game.isInstalled = query.value(9).toBool();
+    game.installPath = query.value(10).toString();
+    game.version = query.value(11).toString();
+    game.size = query.value(12).toLongLong();
+    game.preferredRunner = query.value(13).toString();
+    game.runnerExecutable = query.value(14).toString();
+    game.slug = query.value(15).toString();
+    game.hiddenInLibrary = query.value(16).toInt() != 0;
+    game.enableMangoHud = query.value(17).toInt() != 0;
+    game.enableDxvkHudFps = query.value(18).toInt() != 0;
+    game.enableGameMode = query.value(19).toInt() != 0;
+    game.enableCloudSaves = query.value(20).toInt() != 0;
+
+    api::LaunchProfile &profile = game.launchProfile;
+    profile.cpuAffinity = query.value(21).toString();
+    profile.niceLevel = query.value(22).toInt();
+    profile.ioClass = query.value(23).toInt();
+    profile.ioLevel = query.value(24).isNull() ? 4 : query.value(24).toInt();
+    profile.schedIso = query.value(25).toInt() != 0;
+    profile.slice = query.value(26).toString();
+    profile.memoryMax = query.value(27).toString();
+    profile.cpuQuotaPercent = query.value(28).toInt();
+    return game;
+}
+
+api::GameInfo::DownloadLink readDownloadRow(const QSqlQuery &query, int first) {
+    api::GameInfo::DownloadLink link;
+    link.url = query.value(first).toString();
+    link.platform = query.value(first + 1).toString();
+    link.language = query.value(first + 2).toString();
+    link.version = query.value(first + 3).toString();
+    link.size = query.value(first + 4).toLongLong();
+    link.checksumUrl = query.value(first + 5).toString();
+    return link;
+}
+
+// Fill genres, downloads, environment and runner arguments from the child tables.
+// With an empty gameId every game in the vector is filled using one query per table.
+void attachChildRows(QSqlDatabase &db, std::vector<api::GameInfo> &games,
+                     const QString &gameId = QString()) {
+    if (games.empty()) return;
+
+    QHash<QString, size_t> indexById;
+    indexById.reserve(static_cast<qsizetype>(games.size()));
+    for (size_t i = 0; i < games.size(); ++i) {
+        indexById.insert(games[i].id, i);
+    }
+
+    const auto run = [&](const QString &select, const QString &orderBy, auto &&apply) {
+        QSqlQuery query(db);
+        QString sql = select;
+        if (!gameId.isEmpty()) sql += " WHERE gameId = ?";
+        sql += " ORDER BY " + orderBy;
+        query.prepare(sql);
+        if (!gameId.isEmpty()) query.addBindValue(gameId);
+
+        if (!query.exec()) {
+            LOG_ERROR(QString("Failed to load game metadata: %1").arg(query.lastError().text()));
+            return;
         }
+        while (query.next()) {
+            const auto it = indexById.constFind(query.value(0).toString());
+            if (it != indexById.constEnd()) apply(games[it.value()], query);
+        }
+    };
+
+    run("SELECT gameId, genre FROM game_genres", "gameId, genre",
+        [](api::GameInfo &game, const QSqlQuery &q) { game.genres << q.value(1).toString(); });
+
+    run("SELECT gameId, url, platform, language, version, size, checksumUrl FROM game_downloads",
+        "gameId, position", [](api::GameInfo &game, const QSqlQuery &q) {
+            game.downloads.push_back(readDownloadRow(q, 1));
+        });
+
+    run("SELECT gameId, key, value FROM game_environment", "gameId, key",
+        [](api::GameInfo &game, const QSqlQuery &q) {
+            game.extraEnvironment.insert(q.value(1).toString(), q.value(2).toString());
+        });
+
+    run("SELECT gameId, argument FROM game_runner_arguments", "gameId, position",
+        [](api::GameInfo &game, const QSqlQuery &q) {
+            game.runnerArguments << q.value(1).toString();
+        });
+}
+
+bool deleteChildRows(QSqlDatabase &db, const QString &table, const QString &gameId) {
+    QSqlQuery query(db);
+    query.prepare(QString("DELETE FROM %1 WHERE gameId = ?").arg(table));
+    query.addBindValue(gameId);
+    if (!query.exec()) {
+        LOG_ERROR(QString("Failed to clear %1: %2").arg(table, query.lastError().text()));
+        return false;
+    }
+    return true;
+}
+
+bool writeGenres(QSqlDatabase &db, const QString &gameId, const QStringList &genres) {
+    if (!deleteChildRows(db, "game_genres", gameId)) return false;
+
+    QSqlQuery query(db);
+    query.prepare("INSERT OR IGNORE INTO game_genres (gameId, genre) VALUES (?, ?)");
+    for (const QString &genre : genres) {
+        query.addBindValue(gameId);
+        query.addBindValue(genre.trimmed());
+        if (!query.exec()) return false;
     }
+    return true;
+}
 
-    ~LibraryDatabase() { db_.close(); }
+bool writeDownloads(QSqlDatabase &db, const QString &gameId,
+                    const std::vector<api::GameInfo::DownloadLink> &downloads) {
+    if (!deleteChildRows(db, "game_downloads", gameId)) return false;
 
-    QSqlDatabase &database() { return db_; }
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO game_downloads (gameId, position, url, platform, language, version, "
+                  "size, checksumUrl) VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    for (size_t i = 0; i < downloads.size(); ++i) {
+        const auto &dl = downloads[i];
+        query.addBindValue(gameId);
+        query.addBindValue(static_cast<int>(i));
+        query.addBindValue(dl.url);
+        query.addBindValue(dl.platform);
+        query.addBindValue(dl.language);
+        query.addBindValue(dl.version);
+        query.addBindValue(dl.size);
+        query.addBindValue(dl.checksumUrl);
+        if (!query.exec()) return false;
+    }
+    return true;
+}
 
-  private:
-    QSqlDatabase db_;
-};
+bool writeEnvironment(QSqlDatabase &db, const QString &gameId,
+                      const QMap<QString, QString> &environment) {
+    if (!deleteChildRows(db, "game_environment", gameId)) return false;
+
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO game_environment (gameId, key, value) VALUES (?, ?, ?)");
+    for (auto it = environment.begin(); it != environment.end(); ++it) {
+        query.addBindValue(gameId);
+        query.addBindValue(it.key());
+        query.addBindValue(it.value());
+        if (!query.exec()) return false;
+    }
+    return true;
+}
+
+bool writeRunnerArguments(QSqlDatabase &db, const QString &gameId, const QStringList &arguments) {
+    if (!deleteChildRows(db, "game_runner_arguments", gameId)) return false;
+
+    QSqlQuery query(db);
+    query.prepare(
+        "INSERT INTO game_runner_arguments (gameId, position, argument) VALUES (?, ?, ?)");
+    for (int i = 0; i < arguments.size(); ++i) {
+        query.addBindValue(gameId);
+        query.addBindValue(i);
+        query.addBindValue(arguments[i]);
+        if (!query.exec()) return false;
+    }
+    return true;
+}
+
+QDateTime fromEpochMs(const QVariant &value) {
+    return value.isNull() ? QDateTime() : QDateTime::fromMSecsSinceEpoch(value.toLongLong());
+}
+
+PlayStats readPlayStatsRow(const QSqlQuery &query) {
+    PlayStats stats;
+    stats.gameId = query.value(0).toString();
+    stats.launchCount = query.value(1).toInt();
+    stats.totalSeconds = query.value(2).toLongLong();
+    stats.lastPlayed = fromEpochMs(query.value(3));
+    return stats;
+}
+
+// Identifies the on-disk state of the database. An empty or missing WAL counts
+// the same, since SQLite creates one on open and removes it on a clean close.
+QByteArray databaseStamp(const QString &dbPath) {
+    QByteArray stamp;
+    for (const QString &file : {dbPath, dbPath + "-wal"}) {
+        const QFileInfo info(file);
+        if (!info.exists() || info.size() == 0) continue;
+        stamp += QByteArray::number(info.size()) + ':' +
+                 QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + ';';
+    }
+    return stamp;
+}
+
+QString startupCachePath(const QString &dbPath) { return dbPath + ".snapshot"; }
+
+} // namespace
 
 LibraryService::LibraryService(api::GOGClient *gogClient, QObject *parent)
-    : QObject(parent), gogClient_(gogClient), db_(new LibraryDatabase()) {
+    : QObject(parent), gogClient_(gogClient), db_(new LibraryDatabase()),
+      snapshot_(std::make_shared<const LibrarySnapshot>()), databasePath_(db_->filePath()),
+      maintenanceTimer_(new QTimer(this)), indexPool_(new QThreadPool(this)) {
+    // One install tree at a time; these walks are disk-bound
+    indexPool_->setMaxThreadCount(1);
+    maintenanceTimer_->setSingleShot(true);
+    maintenanceTimer_->setInterval(kMaintenanceIdleMs);
+    connect(maintenanceTimer_, &QTimer::timeout, this, &LibraryService::runMaintenance);
+
     initDatabase();
+    if (!loadStartupCache()) {
+        reload();
+    }
 }
 
-LibraryService::~LibraryService() { delete db_; }
+LibraryService::~LibraryService() {
+    indexPool_->waitForDone();
+    db_->optimize();
+
+    // Close first so the stamp covers what SQLite flushes on close
+    delete db_;
+    saveStartupCache();
+}
 
 void LibraryService::fetchLibrary(bool forceRefresh, GamesCallback callback) {
     if (!forceRefresh) {
-        auto cached = loadCachedGames();
-        if (!cached.empty()) {
-            callback(util::Result<std::vector<api::GameInfo>>::success(cached));
+        const LibrarySnapshotPtr current = snapshot();
+        if (!current->empty()) {
+            callback(util::Result<std::vector<api::GameInfo>>::success(current->toVector()));
             return;
         }
     }
@@ -60,48 +276,186 @@ void LibraryService::fetchLibrary(bool forceRefresh, GamesCallback callback) {
 }
 
 void LibraryService::getGame(const QString &gameId, GameCallback callback) {
+    if (const auto game = snapshot()->find(gameId)) {
+        callback(util::Result<api::GameInfo>::success(*game));
+    } else {
+        callback(util::Result<api::GameInfo>::error("Game not found"));
+    }
+}
+
+LibrarySnapshotPtr LibraryService::snapshot() const {
+    return snapshot_.load(std::memory_order_acquire);
+}
+
+void LibraryService::reload() {
+    const LibrarySnapshotPtr previous = snapshot();
+
+    std::vector<LibrarySnapshot::GamePtr> games;
+    for (auto &game : queryAllGames()) {
+        // Unchanged games keep their entry so readers can compare by pointer
+        const auto old = previous->find(game.id);
+        if (old && *old == game) {
+            games.push_back(old);
+        } else {
+            games.push_back(std::make_shared<const api::GameInfo>(std::move(game)));
+        }
+    }
+
+    auto next = std::make_shared<const LibrarySnapshot>(std::move(games), snapshotVersion_ + 1);
+
+    QStringList added, updated, removed;
+    for (const auto &game : next->games()) {
+        const auto old = previous->find(game->id);
+        if (!old) {
+            added << game->id;
+        } else if (old != game) {
+            updated << game->id;
+        }
+    }
+    for (const auto &game : previous->games()) {
+        if (!next->contains(game->id)) removed << game->id;
+    }
+
+    if (added.isEmpty() && updated.isEmpty() && removed.isEmpty()) return;
+    publish(std::move(next), added, updated, removed);
+}
+
+util::Result<void> LibraryService::exportSnapshot(const QString &path) {
+    const LibrarySnapshotPtr current = snapshot();
+    auto result = current->writeToFile(path);
+    if (result.isOk()) {
+        LOG_INFO(QString("Exported %1 games to %2").arg(current->size()).arg(path));
+    }
+    return result;
+}
+
+util::Result<int> LibraryService::importSnapshot(const QString &path) {
+    auto loaded = LibrarySnapshot::readFromFile(path);
+    if (!loaded.isOk()) {
+        return util::Result<int>::error(loaded.errorMessage());
+    }
+
+    const std::vector<api::GameInfo> games = loaded.value()->toVector();
+    if (!cacheGames(games)) {
+        return util::Result<int>::error("Failed to store imported games in the library database");
+    }
+
+    LOG_INFO(QString("Imported %1 games from %2").arg(games.size()).arg(path));
+    emit libraryUpdated(static_cast<int>(games.size()));
+    return util::Result<int>::success(static_cast<int>(games.size()));
+}
+
+bool LibraryService::loadStartupCache() {
+    QByteArray tag;
+    auto cached = LibrarySnapshot::readFromFile(startupCachePath(databasePath_), &tag);
+    if (!cached.isOk() || tag.isEmpty() || tag != databaseStamp(databasePath_)) {
+        return false;
+    }
+
+    const LibrarySnapshotPtr &loaded = cached.value();
+    LOG_DEBUG(QString("Loaded %1 games from startup snapshot").arg(loaded->size()));
+    publish(std::make_shared<const LibrarySnapshot>(loaded->games(), snapshotVersion_ + 1), {},
+            {}, {});
+    return true;
+}
+
+void LibraryService::saveStartupCache() {
+    const QString cachePath = startupCachePath(databasePath_);
+    const LibrarySnapshotPtr current = snapshot();
+    const QByteArray stamp = databaseStamp(databasePath_);
+
+    if (current->empty() || stamp.isEmpty()) {
+        QFile::remove(cachePath);
+        return;
+    }
+
+    auto result = current->writeToFile(cachePath, stamp);
+    if (!result.isOk()) {
+        LOG_WARNING(QString("Failed to write startup snapshot: %1").arg(result.errorMessage()));
+    }
+}
+
+DatabaseStats LibraryService::databaseStats() {
+    DatabaseStats stats;
+    stats.path = databasePath_;
+    stats.fileSize = QFileInfo(databasePath_).size();
+    const QFileInfo wal(databasePath_ + "-wal");
+    stats.walSize = wal.exists() ? wal.size() : 0;
+    stats.pageSize = db_->pragma("page_size").toLongLong();
+    stats.pageCount = db_->pragma("page_count").toLongLong();
+    stats.freePages = db_->pragma("freelist_count").toLongLong();
+    stats.journalMode = db_->pragma("journal_mode").toString();
+    stats.schemaVersion = db_->schemaVersion();
+    stats.lastMaintenance = lastMaintenance_;
+    return stats;
+}
+
+void LibraryService::runMaintenance() {
+    maintenanceTimer_->stop();
+
+    const int released = db_->incrementalVacuum(kVacuumPagesPerPass);
+    db_->optimize();
+    // Last, so the WAL written by the steps above is folded back too
+    const bool checkpointed = db_->checkpoint();
+
+    lastMaintenance_ = QDateTime::currentDateTime();
+    LOG_DEBUG(QString("Library maintenance: released %1 pages, checkpoint %2")
+                  .arg(released)
+                  .arg(checkpointed ? "complete" : "deferred (database busy)"));
+    emit maintenanceFinished();
+
+    // An empty library is more likely not loaded yet than emptied; keep every cache then
+    const LibrarySnapshotPtr current = snapshot();
+    if (current->empty()) return;
+
+    QStringList gameIds;
+    for (const auto &game : current->games()) {
+        gameIds << game->id;
+    }
+    const qint64 limit = qint64(util::Config::instance().shaderCacheLimitMb()) << 20;
+    indexPool_->start([limit, gameIds]() { runners::ShaderCache::prune(limit, gameIds); });
+}
+
+void LibraryService::scheduleMaintenance() { maintenanceTimer_->start(); }
+
+void LibraryService::publish(LibrarySnapshotPtr next, const QStringList &added,
+                             const QStringList &updated, const QStringList &removed) {
+    snapshotVersion_ = next->version();
+    snapshot_.store(next, std::memory_order_release);
+    scheduleMaintenance();
+
+    if (!added.isEmpty()) emit gamesAdded(added);
+    for (const QString &gameId : updated) {
+        emit gameUpdated(gameId);
+    }
+    if (!removed.isEmpty()) emit gamesRemoved(removed);
+    emit snapshotChanged(next->version());
+}
+
+void LibraryService::refreshGame(const QString &gameId) {
     QSqlQuery query(db_->database());
-    query.prepare("SELECT id, title, platform, coverUrl, isInstalled, installPath, version, "
-                  "preferredRunner, runnerExecutable, "
-                  "runnerArguments, extraEnvironment, slug, hiddenInLibrary, enableMangoHud, "
-                  "enableDxvkHudFps, enableGameMode, enableCloudSaves "
-                  "FROM games WHERE id = ?");
+    query.prepare(QString("SELECT %1 FROM games WHERE id = ?").arg(kGameColumns));
     query.addBindValue(gameId);
 
-    if (query.exec() && query.next()) {
-        api::GameInfo game;
-        game.id = query.value(0).toString();
-        game.title = query.value(1).toString();
-        game.platform = query.value(2).toString();
-        game.coverUrl = query.value(3).toString();
-        game.isInstalled = query.value(4).toBool();
-        game.installPath = query.value(5).toString();
-        game.version = query.value(6).toString();
-        game.preferredRunner = query.value(7).toString();
-        game.runnerExecutable = query.value(8).toString();
-        game.runnerArguments = query.value(9).toString().split('\n', Qt::SkipEmptyParts);
-
-        const QString envJson = query.value(10).toString();
-        if (!envJson.isEmpty()) {
-            const QJsonDocument doc = QJsonDocument::fromJson(envJson.toUtf8());
-            if (doc.isObject()) {
-                const auto obj = doc.object();
-                for (auto it = obj.begin(); it != obj.end(); ++it) {
-                    game.extraEnvironment.insert(it.key(), it.value().toString());
-                }
-            }
-        }
+    if (!query.exec() || !query.next()) {
+        // Row vanished underneath us; fall back to a full diff
+        reload();
+        return;
+    }
+
+    std::vector<api::GameInfo> games{readGameRow(query)};
+    attachChildRows(db_->database(), games, gameId);
 
-        game.slug = query.value(11).toString();
-        game.hiddenInLibrary = query.value(12).toInt() != 0;
-        game.enableMangoHud = query.value(13).toInt() != 0;
-        game.enableDxvkHudFps = query.value(14).toInt() != 0;
-        game.enableGameMode = query.value(15).toInt() != 0;
-        game.enableCloudSaves = query.value(16).toInt() != 0;
+    const LibrarySnapshotPtr current = snapshot();
+    const auto old = current->find(gameId);
+    if (old && *old == games.front()) return;
 
-        callback(util::Result<api::GameInfo>::success(game));
+    auto next = current->withGame(std::make_shared<const api::GameInfo>(std::move(games.front())),
+                                  snapshotVersion_ + 1);
+    if (old) {
+        publish(std::move(next), {}, {gameId}, {});
     } else {
-        callback(util::Result<api::GameInfo>::error("Game not found"));
+        publish(std::move(next), {gameId}, {}, {});
     }
 }
 
@@ -115,79 +469,484 @@ void LibraryService::updateGameInstallation(const QString &gameId, const QString
 
     if (query.exec()) {
         LOG_INFO(QString("Updated installation for game: %1").arg(gameId));
-        emit gameUpdated(gameId);
+        refreshGame(gameId);
+        if (!installPath.isEmpty()) indexExecutables(gameId);
     } else {
         LOG_ERROR(QString("Failed to update game installation: %1").arg(query.lastError().text()));
     }
 }
 
 void LibraryService::removeGameInstallation(const QString &gameId) {
-    QSqlQuery query(db_->database());
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return;
+    }
+
+    QSqlQuery query(db);
     query.prepare("UPDATE games SET isInstalled = 0, installPath = '', version = '' WHERE id = ?");
     query.addBindValue(gameId);
 
-    if (query.exec()) {
-        LOG_INFO(QString("Removed installation for game: %1").arg(gameId));
-        emit gameUpdated(gameId);
-    } else {
-        LOG_ERROR(QString("Failed to remove game installation: %1").arg(query.lastError().text()));
+    QSqlQuery clear(db);
+    clear.prepare("DELETE FROM game_executables WHERE gameId = ?");
+    clear.addBindValue(gameId);
+
+    QString error;
+    if (!query.exec()) {
+        error = query.lastError().text();
+    } else if (!clear.exec()) {
+        error = clear.lastError().text();
+    } else if (!db.commit()) {
+        error = db.lastError().text();
+    }
+
+    if (!error.isEmpty()) {
+        db.rollback();
+        LOG_ERROR(QString("Failed to remove game installation: %1").arg(error));
+        return;
     }
+
+    LOG_INFO(QString("Removed installation for game: %1").arg(gameId));
+    refreshGame(gameId);
 }
 
-void LibraryService::updateGameProperties(const api::GameInfo &game) {
+void LibraryService::indexExecutables(const QString &gameId) { indexExecutables(gameId, nullptr); }
+
+void LibraryService::indexExecutables(const QString &gameId, ExecutableCallback then) {
+    const auto game = snapshot()->find(gameId);
+    if (!game || game->installPath.isEmpty()) {
+        if (then) then(util::Result<GameExecutable>::error("Game is not installed"));
+        return;
+    }
+
+    const QString installPath = game->installPath;
+    indexPool_->start([this, gameId, installPath, then = std::move(then)]() {
+        auto entries = ExecutableIndex::build(installPath);
+        QMetaObject::invokeMethod(
+            this,
+            [this, gameId, installPath, then, entries = std::move(entries)]() {
+                // Uninstalled or moved while the walk ran: the entries describe nothing
+                const auto current = snapshot()->find(gameId);
+                if (!current || current->installPath != installPath) {
+                    if (then) then(util::Result<GameExecutable>::error("Game is not installed"));
+                    return;
+                }
+
+                if (storeExecutables(gameId, entries)) {
+                    emit executablesIndexed(gameId, static_cast<int>(entries.size()));
+                }
+                if (!then) return;
+                if (entries.empty()) {
+                    then(util::Result<GameExecutable>::error(
+                        "No executable found in the install directory"));
+                } else {
+                    then(util::Result<GameExecutable>::success(entries.front()));
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+std::vector<GameExecutable> LibraryService::executables(const QString &gameId) {
+    std::vector<GameExecutable> entries;
+
     QSqlQuery query(db_->database());
+    query.prepare("SELECT path, arguments, workingDir, name, source, rank, isPrimary, size, mtime "
+                  "FROM game_executables WHERE gameId = ? ORDER BY rank DESC");
+    query.addBindValue(gameId);
+
+    if (query.exec()) {
+        while (query.next()) {
+            GameExecutable entry;
+            entry.path = query.value(0).toString();
+            entry.arguments = query.value(1).toString();
+            entry.workingDirectory = query.value(2).toString();
+            entry.name = query.value(3).toString();
+            entry.source = ExecutableIndex::sourceFromString(query.value(4).toString());
+            entry.rank = query.value(5).toInt();
+            entry.isPrimary = query.value(6).toBool();
+            entry.size = query.value(7).toLongLong();
+            entry.mtime = query.value(8).toLongLong();
+            entries.push_back(entry);
+        }
+    }
+
+    return entries;
+}
+
+void LibraryService::primaryExecutable(const QString &gameId, ExecutableCallback callback) {
+    const std::vector<GameExecutable> entries = executables(gameId);
+    if (!entries.empty() && ExecutableIndex::isCurrent(entries.front())) {
+        callback(util::Result<GameExecutable>::success(entries.front()));
+        return;
+    }
+
+    // Patched since it was indexed, but still there: launch it and refresh the
+    // index for next time
+    if (!entries.empty() && QFileInfo::exists(entries.front().path)) {
+        indexExecutables(gameId);
+        callback(util::Result<GameExecutable>::success(entries.front()));
+        return;
+    }
+
+    // Installed before the index existed, or the binary is gone
+    indexExecutables(gameId, std::move(callback));
+}
+
+bool LibraryService::storeExecutables(const QString &gameId,
+                                      const std::vector<GameExecutable> &entries) {
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return false;
+    }
+
+    QSqlQuery clear(db);
+    clear.prepare("DELETE FROM game_executables WHERE gameId = ?");
+    clear.addBindValue(gameId);
+    bool ok = clear.exec();
+
+    QSqlQuery insert(db);
+    insert.prepare("INSERT OR REPLACE INTO game_executables (gameId, path, arguments, workingDir, "
+                   "name, source, rank, isPrimary, size, mtime) "
+                   "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    for (size_t i = 0; ok && i < entries.size(); ++i) {
+        const GameExecutable &entry = entries[i];
+        insert.addBindValue(gameId);
+        insert.addBindValue(entry.path);
+        insert.addBindValue(entry.arguments);
+        insert.addBindValue(entry.workingDirectory);
+        insert.addBindValue(entry.name);
+        insert.addBindValue(ExecutableIndex::sourceToString(entry.source));
+        insert.addBindValue(entry.rank);
+        insert.addBindValue(entry.isPrimary ? 1 : 0);
+        insert.addBindValue(entry.size);
+        insert.addBindValue(entry.mtime);
+        ok = insert.exec();
+    }
 
-    QJsonObject envObj;
-    for (auto it = game.extraEnvironment.begin(); it != game.extraEnvironment.end(); ++it) {
-        envObj.insert(it.key(), it.value());
+    if (!ok || !db.commit()) {
+        db.rollback();
+        LOG_ERROR(QString("Failed to store executable index for game %1: %2")
+                      .arg(gameId, insert.lastError().text()));
+        return false;
+    }
+
+    scheduleMaintenance();
+    return true;
+}
+
+void LibraryService::updateGameProperties(const api::GameInfo &game) {
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return;
     }
-    const QString envJson = QString::fromUtf8(QJsonDocument(envObj).toJson(QJsonDocument::Compact));
 
-    query.prepare("UPDATE games SET preferredRunner = ?, runnerExecutable = ?, runnerArguments = "
-                  "?, extraEnvironment = ?, "
+    QSqlQuery query(db);
+    query.prepare("UPDATE games SET preferredRunner = ?, runnerExecutable = ?, "
                   "hiddenInLibrary = ?, enableMangoHud = ?, enableDxvkHudFps = ?, enableGameMode = "
-                  "?, enableCloudSaves = ? WHERE id = ?");
+                  "?, enableCloudSaves = ?, cpuAffinity = ?, niceLevel = ?, ioClass = ?, "
+                  "ioLevel = ?, schedIso = ?, cgroupSlice = ?, memoryMax = ?, cpuQuotaPercent = ? "
+                  "WHERE id = ?");
     query.addBindValue(game.preferredRunner);
     query.addBindValue(game.runnerExecutable);
-    query.addBindValue(game.runnerArguments.join("\n"));
-    query.addBindValue(envJson);
     query.addBindValue(game.hiddenInLibrary ? 1 : 0);
     query.addBindValue(game.enableMangoHud ? 1 : 0);
     query.addBindValue(game.enableDxvkHudFps ? 1 : 0);
     query.addBindValue(game.enableGameMode ? 1 : 0);
     query.addBindValue(game.enableCloudSaves ? 1 : 0);
+    const api::LaunchProfile &profile = game.launchProfile;
+    query.addBindValue(profile.cpuAffinity);
+    query.addBindValue(profile.niceLevel);
+    query.addBindValue(profile.ioClass);
+    query.addBindValue(profile.ioLevel);
+    query.addBindValue(profile.schedIso ? 1 : 0);
+    query.addBindValue(profile.slice);
+    query.addBindValue(profile.memoryMax);
+    query.addBindValue(profile.cpuQuotaPercent);
     query.addBindValue(game.id);
 
-    if (query.exec()) {
+    const bool ok = query.exec() && writeRunnerArguments(db, game.id, game.runnerArguments) &&
+                    writeEnvironment(db, game.id, game.extraEnvironment);
+
+    if (ok && db.commit()) {
         LOG_INFO(QString("Updated properties for game: %1").arg(game.id));
-        emit gameUpdated(game.id);
+        refreshGame(game.id);
     } else {
+        db.rollback();
         LOG_ERROR(QString("Failed to update game properties: %1").arg(query.lastError().text()));
     }
 }
 
+void LibraryService::cacheGameDetails(const api::GameInfo &details) {
+    QSqlQuery query(db_->database());
+    query.prepare(R"(
+            UPDATE games SET
+                backgroundUrl = COALESCE(NULLIF(?, ''), backgroundUrl),
+                developer = COALESCE(NULLIF(?, ''), developer),
+                publisher = COALESCE(NULLIF(?, ''), publisher),
+                description = COALESCE(NULLIF(?, ''), description),
+                releaseDate = COALESCE(NULLIF(?, ''), releaseDate),
+                slug = COALESCE(NULLIF(?, ''), slug)
+            WHERE id = ?
+    )");
+    query.addBindValue(details.backgroundUrl);
+    query.addBindValue(details.developer);
+    query.addBindValue(details.publisher);
+    query.addBindValue(details.description);
+    query.addBindValue(details.releaseDate.isValid() ? details.releaseDate.toString(Qt::ISODate)
+                                                     : QString());
+    query.addBindValue(details.slug);
+    query.addBindValue(details.id);
+
+    if (query.exec()) {
+        LOG_DEBUG(QString("Cached details for game: %1").arg(details.id));
+        refreshGame(details.id);
+    } else {
+        LOG_ERROR(QString("Failed to cache game details: %1").arg(query.lastError().text()));
+    }
+}
+
+void LibraryService::cacheGameDownloads(const QString &gameId,
+                                        const std::vector<api::GameInfo::DownloadLink> &downloads) {
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return;
+    }
+
+    if (writeDownloads(db, gameId, downloads) && db.commit()) {
+        LOG_DEBUG(QString("Cached %1 downloads for game: %2").arg(downloads.size()).arg(gameId));
+        refreshGame(gameId);
+    } else {
+        db.rollback();
+        LOG_ERROR(QString("Failed to cache downloads for game: %1").arg(gameId));
+    }
+}
+
+std::vector<api::GameInfo::DownloadLink> LibraryService::cachedDownloads(const QString &gameId) {
+    std::vector<api::GameInfo::DownloadLink> downloads;
+
+    QSqlQuery query(db_->database());
+    query.prepare("SELECT url, platform, language, version, size, checksumUrl FROM game_downloads "
+                  "WHERE gameId = ? ORDER BY position");
+    query.addBindValue(gameId);
+
+    if (query.exec()) {
+        while (query.next()) {
+            downloads.push_back(readDownloadRow(query, 0));
+        }
+    }
+
+    return downloads;
+}
+
+qint64 LibraryService::beginPlaySession(const QString &gameId, const QString &runner) {
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return -1;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QSqlQuery insert(db);
+    insert.prepare("INSERT INTO play_sessions (gameId, runner, startedAt) VALUES (?, ?, ?)");
+    insert.addBindValue(gameId);
+    insert.addBindValue(runner);
+    insert.addBindValue(now);
+
+    QSqlQuery stats(db);
+    stats.prepare(R"(
+            INSERT INTO game_play_stats (gameId, launchCount, lastPlayedAt) VALUES (?, 1, ?)
+            ON CONFLICT(gameId) DO UPDATE SET
+                launchCount = launchCount + 1, lastPlayedAt = excluded.lastPlayedAt
+    )");
+    stats.addBindValue(gameId);
+    stats.addBindValue(now);
+
+    if (!insert.exec() || !stats.exec() || !db.commit()) {
+        db.rollback();
+        LOG_ERROR(QString("Failed to record launch of game %1: %2")
+                      .arg(gameId, insert.lastError().text()));
+        return -1;
+    }
+
+    const qint64 sessionId = insert.lastInsertId().toLongLong();
+    LOG_DEBUG(
+        QString("Play session %1 started for game %2 (%3)").arg(sessionId).arg(gameId, runner));
+    emit playStatsChanged(gameId);
+    scheduleMaintenance();
+    return sessionId;
+}
+
+void LibraryService::endPlaySession(qint64 sessionId, int exitCode, bool crashed) {
+    QSqlDatabase &db = db_->database();
+    if (!db.transaction()) {
+        LOG_ERROR("Failed to start database transaction");
+        return;
+    }
+
+    // Only an open session can be closed, so a session is never counted twice
+    QSqlQuery select(db);
+    select.prepare("SELECT gameId, startedAt FROM play_sessions WHERE id = ? AND endedAt IS NULL");
+    select.addBindValue(sessionId);
+    if (!select.exec() || !select.next()) {
+        db.rollback();
+        LOG_WARNING(QString("Play session %1 is unknown or already closed").arg(sessionId));
+        return;
+    }
+
+    const QString gameId = select.value(0).toString();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 seconds = qMax<qint64>(0, (now - select.value(1).toLongLong()) / 1000);
+
+    QSqlQuery close(db);
+    close.prepare("UPDATE play_sessions SET endedAt = ?, exitCode = ?, crashed = ? WHERE id = ?");
+    close.addBindValue(now);
+    close.addBindValue(exitCode);
+    close.addBindValue(crashed ? 1 : 0);
+    close.addBindValue(sessionId);
+
+    QSqlQuery stats(db);
+    stats.prepare("UPDATE game_play_stats SET totalSeconds = totalSeconds + ?, lastPlayedAt = ? "
+                  "WHERE gameId = ?");
+    stats.addBindValue(seconds);
+    stats.addBindValue(now);
+    stats.addBindValue(gameId);
+
+    if (!close.exec() || !stats.exec() || !db.commit()) {
+        db.rollback();
+        LOG_ERROR(QString("Failed to close play session %1: %2")
+                      .arg(sessionId)
+                      .arg(close.lastError().text()));
+        return;
+    }
+
+    LOG_INFO(QString("Game %1 ran for %2s (exit code %3%4)")
+                 .arg(gameId)
+                 .arg(seconds)
+                 .arg(exitCode)
+                 .arg(crashed ? ", crashed" : ""));
+    emit playStatsChanged(gameId);
+    scheduleMaintenance();
+}
+
+void LibraryService::trackPlaySession(const QString &gameId, const QString &runner,
+                                      runners::GameProcessSupervisor *supervisor) {
+    const qint64 sessionId = beginPlaySession(gameId, runner);
+    if (sessionId < 0 || !supervisor) return;
+
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = connect(supervisor, &runners::GameProcessSupervisor::gameExited, this,
+                          [this, gameId, sessionId, connection](const QString &exitedId,
+                                                                int exitCode, bool crashed) {
+                              if (exitedId != gameId) return;
+                              disconnect(*connection);
+                              endPlaySession(sessionId, exitCode, crashed);
+                          });
+}
+
+PlayStats LibraryService::playStats(const QString &gameId) {
+    QSqlQuery query(db_->database());
+    query.prepare("SELECT gameId, launchCount, totalSeconds, lastPlayedAt FROM game_play_stats "
+                  "WHERE gameId = ?");
+    query.addBindValue(gameId);
+
+    if (query.exec() && query.next()) {
+        return readPlayStatsRow(query);
+    }
+
+    PlayStats stats;
+    stats.gameId = gameId;
+    return stats;
+}
+
+std::vector<PlayStats> LibraryService::recentlyPlayed(int limit) {
+    std::vector<PlayStats> results;
+
+    QSqlQuery query(db_->database());
+    query.prepare("SELECT gameId, launchCount, totalSeconds, lastPlayedAt FROM game_play_stats "
+                  "WHERE lastPlayedAt IS NOT NULL ORDER BY lastPlayedAt DESC LIMIT ?");
+    query.addBindValue(limit);
+
+    if (query.exec()) {
+        while (query.next()) {
+            results.push_back(readPlayStatsRow(query));
+        }
+    }
+
+    return results;
+}
+
+std::vector<PlaySession> LibraryService::playSessions(const QString &gameId, int limit) {
+    std::vector<PlaySession> results;
+
+    QSqlQuery query(db_->database());
+    query.prepare("SELECT id, gameId, runner, startedAt, endedAt, exitCode, crashed "
+                  "FROM play_sessions WHERE gameId = ? ORDER BY startedAt DESC LIMIT ?");
+    query.addBindValue(gameId);
+    query.addBindValue(limit);
+
+    if (query.exec()) {
+        while (query.next()) {
+            PlaySession session;
+            session.id = query.value(0).toLongLong();
+            session.gameId = query.value(1).toString();
+            session.runner = query.value(2).toString();
+            session.startedAt = fromEpochMs(query.value(3));
+            session.endedAt = fromEpochMs(query.value(4));
+            session.exitCode = query.value(5).toInt();
+            session.crashed = query.value(6).toInt() != 0;
+            results.push_back(session);
+        }
+    }
+
+    return results;
+}
+
+std::vector<RunnerStats> LibraryService::runnerStats() {
+    std::vector<RunnerStats> results;
+
+    // Sessions still open (running, or orphaned by a client crash) are left out
+    QSqlQuery query(db_->database());
+    if (query.exec(R"(
+            SELECT runner, COUNT(*),
+                   SUM(CASE WHEN crashed != 0 OR exitCode != 0 THEN 1 ELSE 0 END),
+                   SUM((endedAt - startedAt) / 1000)
+            FROM play_sessions
+            WHERE endedAt IS NOT NULL
+            GROUP BY runner
+            ORDER BY COUNT(*) DESC
+    )")) {
+        while (query.next()) {
+            RunnerStats stats;
+            stats.runner = query.value(0).toString();
+            stats.sessions = query.value(1).toInt();
+            stats.failures = query.value(2).toInt();
+            stats.totalSeconds = query.value(3).toLongLong();
+            results.push_back(stats);
+        }
+    }
+
+    return results;
+}
+
 std::vector<api::GameInfo> LibraryService::searchGames(const QString &query) {
     std::vector<api::GameInfo> results;
 
     QSqlQuery sqlQuery(db_->database());
-    sqlQuery.prepare("SELECT id, title, platform, coverUrl, isInstalled, installPath, version FROM "
-                     "games WHERE title LIKE ?");
+    sqlQuery.prepare(QString("SELECT %1 FROM games WHERE title LIKE ?").arg(kGameColumns));
     sqlQuery.addBindValue("%" + query + "%");
 
     if (sqlQuery.exec()) {
         while (sqlQuery.next()) {
-            api::GameInfo game;
-            game.id = sqlQuery.value(0).toString();
-            game.title = sqlQuery.value(1).toString();
-            game.platform = sqlQuery.value(2).toString();
-            game.coverUrl = sqlQuery.value(3).toString();
-            game.isInstalled = sqlQuery.value(4).toBool();
-            game.installPath = sqlQuery.value(5).toString();
-            game.version = sqlQuery.value(6).toString();
-            results.push_back(game);
+            results.push_back(readGameRow(sqlQuery));
         }
     }
 
+    attachChildRows(db_->database(), results);
     return results;
 }
 
@@ -195,95 +954,94 @@ std::vector<api::GameInfo> LibraryService::filterByPlatform(const QString &platf
     std::vector<api::GameInfo> results;
 
     QSqlQuery query(db_->database());
-    query.prepare("SELECT id, title, platform, coverUrl, isInstalled, installPath, version FROM "
-                  "games WHERE platform = ?");
+    query.prepare(QString("SELECT %1 FROM games WHERE platform = ?").arg(kGameColumns));
     query.addBindValue(platform);
 
     if (query.exec()) {
         while (query.next()) {
-            api::GameInfo game;
-            game.id = query.value(0).toString();
-            game.title = query.value(1).toString();
-            game.platform = query.value(2).toString();
-            game.coverUrl = query.value(3).toString();
-            game.isInstalled = query.value(4).toBool();
-            game.installPath = query.value(5).toString();
-            game.version = query.value(6).toString();
-            results.push_back(game);
+            results.push_back(readGameRow(query));
         }
     }
 
+    attachChildRows(db_->database(), results);
     return results;
 }
 
-void LibraryService::initDatabase() {
-    QSqlQuery query(db_->database());
+std::vector<api::GameInfo> LibraryService::filterByGenre(const QString &genre) {
+    std::vector<api::GameInfo> results;
 
-    query.exec(R"(
-        CREATE TABLE IF NOT EXISTS games (
-                id TEXT PRIMARY KEY,
-                title TEXT NOT NULL,
-                platform TEXT,
-                coverUrl TEXT,
-                backgroundUrl TEXT,
-                developer TEXT,
-                publisher TEXT,
-                releaseDate TEXT,
-                description TEXT,
-                isInstalled INTEGER DEFAULT 0,
-                installPath TEXT,
-                version TEXT,
-                size INTEGER DEFAULT 0,
-                preferredRunner TEXT,
-                runnerExecutable TEXT,
-                runnerArguments TEXT,
-                extraEnvironment TEXT,
-                slug TEXT,
-                hiddenInLibrary INTEGER DEFAULT 0,
-                enableMangoHud INTEGER DEFAULT 0,
-                enableDxvkHudFps INTEGER DEFAULT 0,
-                enableGameMode INTEGER DEFAULT 0,
-                enableCloudSaves INTEGER DEFAULT 1
-        )
-    )");
+    QSqlQuery query(db_->database());
+    query.prepare(QString("SELECT %1 FROM games WHERE id IN (SELECT gameId FROM game_genres "
+                          "WHERE genre = ? COLLATE NOCASE)")
+                      .arg(kGameColumns));
+    query.addBindValue(genre);
 
-    const auto tryAddColumn = [&](const QString &ddl) {
-        if (!query.exec(ddl)) {
-            const QString err = query.lastError().text().toLower();
-            if (!err.contains("duplicate column") && !err.contains("already exists")) {
-                LOG_ERROR(QString("Migration failed: %1 (%2)").arg(ddl, query.lastError().text()));
-            }
+    if (query.exec()) {
+        while (query.next()) {
+            results.push_back(readGameRow(query));
         }
-    };
+    }
 
-    tryAddColumn("ALTER TABLE games ADD COLUMN preferredRunner TEXT");
-    tryAddColumn("ALTER TABLE games ADD COLUMN runnerExecutable TEXT");
-    tryAddColumn("ALTER TABLE games ADD COLUMN runnerArguments TEXT");
-    tryAddColumn("ALTER TABLE games ADD COLUMN extraEnvironment TEXT");
-    tryAddColumn("ALTER TABLE games ADD COLUMN slug TEXT");
-    tryAddColumn("ALTER TABLE games ADD COLUMN hiddenInLibrary INTEGER DEFAULT 0");
-    tryAddColumn("ALTER TABLE games ADD COLUMN enableMangoHud INTEGER DEFAULT 0");
-    tryAddColumn("ALTER TABLE games ADD COLUMN enableDxvkHudFps INTEGER DEFAULT 0");
-    tryAddColumn("ALTER TABLE games ADD COLUMN enableGameMode INTEGER DEFAULT 0");
-    tryAddColumn("ALTER TABLE games ADD COLUMN enableCloudSaves INTEGER DEFAULT 1");
+    attachChildRows(db_->database(), results);
+    return results;
 }
 
-void LibraryService::cacheGames(const std::vector<api::GameInfo> &games) {
+std::vector<api::GameInfo> LibraryService::filterByInstallerPlatform(const QString &platform) {
+    std::vector<api::GameInfo> results;
+
     QSqlQuery query(db_->database());
+    query.prepare(QString("SELECT %1 FROM games WHERE id IN (SELECT gameId FROM game_downloads "
+                          "WHERE platform = ? COLLATE NOCASE)")
+                      .arg(kGameColumns));
+    query.addBindValue(platform);
+
+    if (query.exec()) {
+        while (query.next()) {
+            results.push_back(readGameRow(query));
+        }
+    }
+
+    attachChildRows(db_->database(), results);
+    return results;
+}
+
+void LibraryService::initDatabase() {
+    if (!db_->migrate()) {
+        LOG_ERROR(QString("Library database schema is at v%1, expected v%2")
+                      .arg(db_->schemaVersion())
+                      .arg(LibraryDatabase::latestSchemaVersion()));
+    }
+}
+
+bool LibraryService::cacheGames(const std::vector<api::GameInfo> &games) {
+    QSqlDatabase &db = db_->database();
+    QSqlQuery query(db);
 
-    if (!db_->database().transaction()) {
+    if (!db.transaction()) {
         LOG_ERROR("Failed to start database transaction");
-        return;
+        return false;
     }
 
+    // Upsert only the API-owned columns: install state and per-game properties are
+    // user-owned and must survive a library refresh. The listing carries no product
+    // details, so empty detail columns keep what cacheGameDetails() stored.
+    query.prepare(R"(
+            INSERT INTO games (id, title, platform, coverUrl, backgroundUrl, developer, publisher,
+                               description, releaseDate, size, slug)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+            ON CONFLICT(id) DO UPDATE SET
+                title = excluded.title, platform = excluded.platform,
+                coverUrl = excluded.coverUrl,
+                backgroundUrl = COALESCE(NULLIF(excluded.backgroundUrl, ''), backgroundUrl),
+                developer = COALESCE(NULLIF(excluded.developer, ''), developer),
+                publisher = COALESCE(NULLIF(excluded.publisher, ''), publisher),
+                description = COALESCE(NULLIF(excluded.description, ''), description),
+                releaseDate = COALESCE(NULLIF(excluded.releaseDate, ''), releaseDate),
+                size = excluded.size, slug = excluded.slug
+    )");
+
     bool hasError = false;
     for (const auto &game : games) {
-        query.prepare(R"(
-                INSERT OR REPLACE INTO games (id, title, platform, coverUrl, backgroundUrl, developer, publisher, description, size, slug,
-                                         preferredRunner, runnerExecutable, runnerArguments, extraEnvironment,
-                                         hiddenInLibrary, enableMangoHud, enableDxvkHudFps, enableGameMode, enableCloudSaves)
-                VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
-        )");
         query.addBindValue(game.id);
         query.addBindValue(game.title);
         query.addBindValue(game.platform);
@@ -292,93 +1050,57 @@ void LibraryService::cacheGames(const std::vector<api::GameInfo> &games) {
         query.addBindValue(game.developer);
         query.addBindValue(game.publisher);
         query.addBindValue(game.description);
+        query.addBindValue(game.releaseDate.isValid() ? game.releaseDate.toString(Qt::ISODate)
+                                                      : QString());
         query.addBindValue(game.size);
         query.addBindValue(game.slug);
 
-        // Keep user properties when refreshing from API (these fields are user-owned)
-        query.addBindValue(game.preferredRunner);
-        query.addBindValue(game.runnerExecutable);
-        query.addBindValue(game.runnerArguments.join("\n"));
-
-        // Add new toggle fields
-        query.addBindValue(game.hiddenInLibrary ? 1 : 0);
-        query.addBindValue(game.enableMangoHud ? 1 : 0);
-        query.addBindValue(game.enableDxvkHudFps ? 1 : 0);
-        query.addBindValue(game.enableGameMode ? 1 : 0);
-        query.addBindValue(game.enableCloudSaves ? 1 : 0);
-
-        QJsonObject envObj;
-        for (auto it = game.extraEnvironment.begin(); it != game.extraEnvironment.end(); ++it) {
-            envObj.insert(it.key(), it.value());
-        }
-        query.addBindValue(QString::fromUtf8(QJsonDocument(envObj).toJson(QJsonDocument::Compact)));
-
         if (!query.exec()) {
             LOG_ERROR(QString("Failed to cache game: %1").arg(query.lastError().text()));
             hasError = true;
             break;
         }
+
+        // The library listing carries no installer data; keep what fetchGameDownloads cached
+        if ((!game.genres.isEmpty() && !writeGenres(db, game.id, game.genres)) ||
+            (!game.downloads.empty() && !writeDownloads(db, game.id, game.downloads))) {
+            LOG_ERROR(QString("Failed to cache metadata for game: %1").arg(game.id));
+            hasError = true;
+            break;
+        }
     }
 
     if (hasError) {
-        db_->database().rollback();
+        db.rollback();
         LOG_ERROR("Database transaction rolled back due to errors");
-    } else {
-        if (!db_->database().commit()) {
-            LOG_ERROR("Failed to commit database transaction");
-            db_->database().rollback();
-        }
+        return false;
+    }
+
+    if (!db.commit()) {
+        LOG_ERROR("Failed to commit database transaction");
+        db.rollback();
+        return false;
     }
+
+    // A sync rewrites most rows; refresh planner statistics while we are at it
+    db_->optimize();
+    reload();
+    return true;
 }
 
-std::vector<api::GameInfo> LibraryService::loadCachedGames() {
+std::vector<api::GameInfo> LibraryService::loadCachedGames() { return snapshot()->toVector(); }
+
+std::vector<api::GameInfo> LibraryService::queryAllGames() {
     std::vector<api::GameInfo> games;
 
     QSqlQuery query(db_->database());
-    if (query.exec("SELECT id, title, platform, coverUrl, backgroundUrl, developer, "
-                   "publisher, description, isInstalled, installPath, version, size, "
-                   "preferredRunner, runnerExecutable, runnerArguments, extraEnvironment, "
-                   "slug, hiddenInLibrary, enableMangoHud, enableDxvkHudFps, "
-                   "enableGameMode, enableCloudSaves FROM games")) {
+    if (query.exec(QString("SELECT %1 FROM games").arg(kGameColumns))) {
         while (query.next()) {
-            api::GameInfo game;
-            game.id = query.value(0).toString();
-            game.title = query.value(1).toString();
-            game.platform = query.value(2).toString();
-            game.coverUrl = query.value(3).toString();
-            game.backgroundUrl = query.value(4).toString();
-            game.developer = query.value(5).toString();
-            game.publisher = query.value(6).toString();
-            game.description = query.value(7).toString();
-            game.isInstalled = query.value(8).toBool();
-            game.installPath = query.value(9).toString();
-            game.version = query.value(10).toString();
-            game.size = query.value(11).toLongLong();
-            game.preferredRunner = query.value(12).toString();
-            game.runnerExecutable = query.value(13).toString();
-            game.runnerArguments = query.value(14).toString().split('\n', Qt::SkipEmptyParts);
-
-            const QString envJson = query.value(15).toString();
-            game.slug = query.value(16).toString();
-            game.hiddenInLibrary = query.value(17).toInt() != 0;
-            game.enableMangoHud = query.value(18).toInt() != 0;
-            game.enableDxvkHudFps = query.value(19).toInt() != 0;
-            game.enableGameMode = query.value(20).toInt() != 0;
-            game.enableCloudSaves = query.value(21).toInt() != 0;
-            if (!envJson.isEmpty()) {
-                const QJsonDocument doc = QJsonDocument::fromJson(envJson.toUtf8());
-                if (doc.isObject()) {
-                    const auto obj = doc.object();
-                    for (auto it = obj.begin(); it != obj.end(); ++it) {
-                        game.extraEnvironment.insert(it.key(), it.value().toString());
-                    }
-                }
-            }
-
-            games.push_back(game);
+            games.push_back(readGameRow(query));
         }
     }
 
+    attachChildRows(db_->database(), games);
     return games;
 }
 
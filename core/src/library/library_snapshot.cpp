@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/library/library_snapshot.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QScopeGuard>
+
+namespace opengalaxy::library {
+
+namespace {
+
+// File layout (QDataStream, big endian):
+//   quint32 magic, quint32 format version, QByteArray tag, quint32 game count,
+//   followed by qCompress()ed records up to the end of the file.
+// Bump kFileFormatVersion whenever a record changes; readers reject any other
+// version. v2 added the launch profile.
+constexpr quint32 kFileMagic = 0x4F474C53; // "OGLS"
+constexpr quint32 kFileFormatVersion = 2;
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_6_0;
+
+void writeGame(QDataStream &out, const api::GameInfo &game) {
+    out << game.id << game.slug << game.title << game.platform << game.coverUrl
+        << game.backgroundUrl << game.genres << game.developer << game.publisher
+        << game.releaseDate << game.description << game.isInstalled << game.installPath
+        << game.version << game.size << game.preferredRunner << game.runnerExecutable
+        << game.runnerArguments << game.extraEnvironment << game.hiddenInLibrary
+        << game.enableMangoHud << game.enableDxvkHudFps << game.enableGameMode
+        << game.enableCloudSaves;
+
+    const api::LaunchProfile &profile = game.launchProfile;
+    out << profile.cpuAffinity << qint32(profile.niceLevel) << qint32(profile.ioClass)
+        << qint32(profile.ioLevel) << profile.schedIso << profile.slice << profile.memoryMax
+        << qint32(profile.cpuQuotaPercent);
+
+    out << quint32(game.downloads.size());
+    for (const auto &dl : game.downloads) {
+        out << dl.url << dl.platform << dl.language << dl.version << dl.size << dl.checksumUrl;
+    }
+}
+
+void readGame(QDataStream &in, api::GameInfo &game) {
+    in >> game.id >> game.slug >> game.title >> game.platform >> game.coverUrl >>
+        game.backgroundUrl >> game.genres >> game.developer >> game.publisher >>
+        game.releaseDate >> game.description >> game.isInstalled >> game.installPath >>
+        game.version >> game.size >> game.preferredRunner >> game.runnerExecutable >>
+        game.runnerArguments >> game.extraEnvironment >> game.hiddenInLibrary >>
+        game.enableMangoHud >> game.enableDxvkHudFps >> game.enableGameMode >>
+        game.enableCloudSaves;
+
+    api::LaunchProfile &profile = game.launchProfile;
+    qint32 niceLevel = 0, ioClass = 0, ioLevel = 0, cpuQuotaPercent = 0;
+    in >> profile.cpuAffinity >> niceLevel >> ioClass >> ioLevel >> profile.schedIso >>
+        profile.slice >> profile.memoryMax >> cpuQuotaPercent;
+    profile.niceLevel = niceLevel;
+    profile.ioClass = ioClass;
+    profile.ioLevel = ioLevel;
+    profile.cpuQuotaPercent = cpuQuotaPercent;
+
+    quint32 downloadCount = 0;
+    in >> downloadCount;
+    for (quint32 i = 0; i < downloadCount && in.status() == QDataStream::Ok; ++i) {
+        api::GameInfo::DownloadLink dl;
+        in >> dl.url >> dl.platform >> dl.language >> dl.version >> dl.size >> dl.checksumUrl;
+        game.downloads.push_back(dl);
+    }
+}
+
+} // namespace
+
+LibrarySnapshot::LibrarySnapshot(std::vector<GamePtr> games, quint64 version)
+    : version_(version) {
+    games_.reserve(games.size());
+    indexById_.reserve(static_cast<qsizetype>(games.size()));
+
+    for (auto &game : games) {
+        if (!game || indexById_.contains(game->id)) continue;
+        indexById_.insert(game->id, games_.size());
+        games_.push_back(std::move(game));
+    }
+}
+
+LibrarySnapshot::GamePtr LibrarySnapshot::find(const QString &gameId) const {
+    const auto it = indexById_.constFind(gameId);
+    return it != indexById_.constEnd() ? games_[it.value()] : nullptr;
+}
+
+int LibrarySnapshot::indexOf(const QString &gameId) const {
+    const auto it = indexById_.constFind(gameId);
+    return it != indexById_.constEnd() ? static_cast<int>(it.value()) : -1;
+}
+
+std::vector<api::GameInfo> LibrarySnapshot::toVector() const {
+    std::vector<api::GameInfo> games;
+    games.reserve(games_.size());
+    for (const auto &game : games_) {
+        games.push_back(*game);
+    }
+    return games;
+}
+
+std::shared_ptr<const LibrarySnapshot> LibrarySnapshot::withGame(GamePtr game,
+                                                                 quint64 version) const {
+    auto next = std::make_shared<LibrarySnapshot>(*this);
+    next->version_ = version;
+
+    const auto it = indexById_.constFind(game->id);
+    if (it != indexById_.constEnd()) {
+        next->games_[it.value()] = std::move(game);
+    } else {
+        next->indexById_.insert(game->id, next->games_.size());
+        next->games_.push_back(std::move(game));
+    }
+    return next;
+}
+
+util::Result<void> LibrarySnapshot::writeToFile(const QString &path, const QByteArray &tag) const {
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(kStreamVersion);
+        for (const auto &game : games_) {
+            writeGame(out, *game);
+        }
+    }
+
+    // QSaveFile so a reader never sees a half-written snapshot
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return util::Result<void>::error("Cannot write " + path + ": " + file.errorString());
+    }
+
+    QDataStream header(&file);
+    header.setVersion(kStreamVersion);
+    header << kFileMagic << kFileFormatVersion << tag << quint32(games_.size());
+    file.write(qCompress(payload));
+
+    if (header.status() != QDataStream::Ok || !file.commit()) {
+        return util::Result<void>::error("Cannot write " + path + ": " + file.errorString());
+    }
+    return util::Result<void>::success();
+}
+
+util::Result<LibrarySnapshotPtr> LibrarySnapshot::readFromFile(const QString &path,
+                                                               QByteArray *tag) {
+    using ReadResult = util::Result<LibrarySnapshotPtr>;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return ReadResult::error("Cannot open " + path + ": " + file.errorString());
+    }
+
+    const qint64 size = file.size();
+    uchar *data = size > 0 ? file.map(0, size) : nullptr;
+    if (!data) {
+        return ReadResult::error("Cannot map " + path);
+    }
+    const auto unmap = qScopeGuard([&file, data] { file.unmap(data); });
+
+    QDataStream header(QByteArray::fromRawData(reinterpret_cast<const char *>(data), size));
+    header.setVersion(kStreamVersion);
+
+    quint32 magic = 0;
+    quint32 format = 0;
+    QByteArray fileTag;
+    quint32 count = 0;
+    header >> magic >> format;
+    if (header.status() != QDataStream::Ok || magic != kFileMagic) {
+        return ReadResult::error(path + " is not a library snapshot");
+    }
+    if (format != kFileFormatVersion) {
+        return ReadResult::error(
+            QString("%1 uses snapshot format v%2, this build reads v%3")
+                .arg(path)
+                .arg(format)
+                .arg(kFileFormatVersion));
+    }
+    header >> fileTag >> count;
+    if (header.status() != QDataStream::Ok) {
+        return ReadResult::error(path + " has a truncated header");
+    }
+
+    // Decompress directly from the mapping; no intermediate read buffer
+    const qint64 offset = header.device()->pos();
+    const QByteArray payload = qUncompress(data + offset, size - offset);
+
+    QDataStream in(payload);
+    in.setVersion(kStreamVersion);
+
+    std::vector<GamePtr> games;
+    games.reserve(qMin<quint32>(count, 100000));
+    for (quint32 i = 0; i < count; ++i) {
+        api::GameInfo game;
+        readGame(in, game);
+        if (in.status() != QDataStream::Ok) {
+            return ReadResult::error(path + " is corrupt");
+        }
+        games.push_back(std::make_shared<const api::GameInfo>(std::move(game)));
+    }
+
+    if (tag) *tag = fileTag;
+    return ReadResult::success(std::make_shared<const LibrarySnapshot>(std::move(games), 0));
+}
+
+} // namespace opengalaxy::library
@@ -0,0 +1,428 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/binary_info.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSysInfo>
+#include <QtEndian>
+#include <algorithm>
+
+namespace opengalaxy::runners {
+
+namespace {
+
+// Below this the whole file is read; above it, mapped
+constexpr qint64 kMapThreshold = 1024 * 1024;
+// Fallback when mapping fails: headers and import tables live near the start
+constexpr qint64 kMaxRead = 16 * 1024 * 1024;
+constexpr int kMaxCacheEntries = 1024;
+constexpr int kMaxImports = 512;
+
+// Bounds-checked reads from an untrusted image; out of range reads yield 0
+class Reader {
+  public:
+    Reader(const uchar *data, qint64 size) : data_(data), size_(size) {}
+
+    void setBigEndian(bool bigEndian) { bigEndian_ = bigEndian; }
+
+    bool has(qint64 offset, qint64 length) const {
+        return offset >= 0 && length >= 0 && offset <= size_ - length;
+    }
+
+    quint8 u8(qint64 offset) const { return has(offset, 1) ? data_[offset] : 0; }
+    quint16 u16(qint64 offset) const { return read<quint16>(offset); }
+    quint32 u32(qint64 offset) const { return read<quint32>(offset); }
+    quint64 u64(qint64 offset) const { return read<quint64>(offset); }
+
+    QString string(qint64 offset, int maxLength = 256) const {
+        if (!has(offset, 1)) return {};
+        const qint64 end = std::min(size_, offset + maxLength);
+        const auto *begin = reinterpret_cast<const char *>(data_ + offset);
+        return QString::fromLatin1(begin, qstrnlen(begin, end - offset));
+    }
+
+  private:
+    template <typename T> T read(qint64 offset) const {
+        if (!has(offset, sizeof(T))) return 0;
+        const uchar *p = data_ + offset;
+        return bigEndian_ ? qFromBigEndian<T>(p) : qFromLittleEndian<T>(p);
+    }
+
+    const uchar *data_;
+    qint64 size_;
+    bool bigEndian_ = false;
+};
+
+Architecture hostArchitecture() {
+    const QString arch = QSysInfo::currentCpuArchitecture();
+    if (arch == "x86_64") return Architecture::X86_64;
+    if (arch == "arm64") return Architecture::ARM64;
+    if (arch == "i386") return Architecture::X86;
+    return Architecture::Unknown;
+}
+
+bool is64BitArch(Architecture arch) {
+    return arch != Architecture::Unknown && arch != Architecture::X86 && arch != Architecture::ARM;
+}
+
+// --- PE/COFF ---
+
+Architecture peMachine(quint16 machine) {
+    switch (machine) {
+    case 0x014C:
+        return Architecture::X86;
+    case 0x8664:
+        return Architecture::X86_64;
+    case 0xAA64:
+        return Architecture::ARM64;
+    case 0x01C0:
+    case 0x01C2:
+    case 0x01C4:
+        return Architecture::ARM;
+    case 0x5064:
+        return Architecture::RISCV64;
+    default:
+        return Architecture::Unknown;
+    }
+}
+
+struct PeSection {
+    quint32 virtualAddress;
+    quint32 virtualSize;
+    quint32 rawOffset;
+    quint32 rawSize;
+};
+
+qint64 rvaToOffset(const std::vector<PeSection> &sections, quint32 rva) {
+    for (const auto &s : sections) {
+        const quint32 extent = std::max(s.virtualSize, s.rawSize);
+        if (rva >= s.virtualAddress && rva - s.virtualAddress < extent) {
+            return qint64(rva - s.virtualAddress) + s.rawOffset;
+        }
+    }
+    return -1;
+}
+
+void parseMz(const Reader &r, BinaryInfo &info) {
+    info.format = BinaryInfo::Format::MZ;
+    info.platform = Platform::DOS;
+    info.arch = Architecture::X86;
+
+    const quint32 newHeader = r.u32(0x3C);
+    if (newHeader == 0 || !r.has(newHeader, 4)) return;
+
+    const quint16 signature = r.u16(newHeader);
+    if (signature == 0x454E) { // "NE": 16-bit Windows
+        info.platform = Platform::Windows;
+        return;
+    }
+    // "LE"/"LX" images are DOS extender (DOS/4GW) games and stay DOS
+    if (r.u32(newHeader) != 0x00004550) return; // "PE\0\0"
+
+    const qint64 coff = newHeader + 4;
+    const qint64 optional = coff + 20;
+    const quint16 sectionCount = r.u16(coff + 2);
+    const quint16 optionalSize = r.u16(coff + 16);
+    const quint16 magic = r.u16(optional);
+    if (magic != 0x10B && magic != 0x20B) return;
+
+    const bool pe32Plus = magic == 0x20B;
+    info.format = BinaryInfo::Format::PE;
+    info.platform = Platform::Windows;
+    info.arch = peMachine(r.u16(coff));
+    info.is64Bit = pe32Plus;
+    info.subsystem = r.u16(optional + 68);
+
+    const quint32 directoryCount = r.u32(optional + (pe32Plus ? 108 : 92));
+    const qint64 directories = optional + (pe32Plus ? 112 : 96);
+    auto directory = [&](quint32 index) -> quint32 {
+        return index < directoryCount ? r.u32(directories + index * 8) : 0;
+    };
+
+    std::vector<PeSection> sections;
+    const qint64 sectionTable = optional + optionalSize;
+    for (int i = 0; i < sectionCount && i < 96; ++i) {
+        const qint64 s = sectionTable + i * 40;
+        if (!r.has(s, 40)) break;
+        sections.push_back({r.u32(s + 12), r.u32(s + 8), r.u32(s + 20), r.u32(s + 16)});
+    }
+
+    auto addImport = [&](quint32 nameRva) {
+        const QString name = r.string(rvaToOffset(sections, nameRva)).toLower();
+        if (!name.isEmpty() && !info.imports.contains(name)) info.imports << name;
+    };
+
+    // Import descriptors, 20 bytes each, terminated by an all-zero entry
+    const qint64 imports = directory(1) ? rvaToOffset(sections, directory(1)) : -1;
+    if (imports > 0) {
+        for (int i = 0; i < kMaxImports; ++i) {
+            const qint64 d = imports + i * 20;
+            const quint32 nameRva = r.u32(d + 12);
+            if (!nameRva && !r.u32(d + 16)) break;
+            addImport(nameRva);
+        }
+    }
+
+    // Delay-loaded imports; graphics APIs are often pulled in this way
+    const qint64 delayed = directory(13) ? rvaToOffset(sections, directory(13)) : -1;
+    if (delayed > 0) {
+        for (int i = 0; i < kMaxImports; ++i) {
+            const qint64 d = delayed + i * 32;
+            const quint32 nameRva = r.u32(d + 4);
+            if (!nameRva) break;
+            // Attribute bit 0 set means RVAs; the old VA-based format is rare and skipped
+            if (r.u32(d) & 1) addImport(nameRva);
+        }
+    }
+
+    // CLR header: .NET assembly. IL-only images without 32BITREQUIRED or
+    // 32BITPREFERRED run as 64-bit processes on a 64-bit system.
+    if (const quint32 clrRva = directory(14)) {
+        info.dotNet = true;
+        const qint64 clr = rvaToOffset(sections, clrRva);
+        const quint32 flags = clr >= 0 ? r.u32(clr + 16) : 0;
+        const bool ilOnly = flags & 0x1;
+        const bool wants32Bit = flags & (0x2 | 0x20000);
+        if (ilOnly && !wants32Bit && info.arch == Architecture::X86) {
+            info.anyCpu = true;
+            info.arch = Architecture::X86_64;
+            info.is64Bit = true;
+        }
+    }
+}
+
+// --- ELF ---
+
+Architecture elfMachine(quint16 machine, bool is64) {
+    switch (machine) {
+    case 3:
+        return Architecture::X86;
+    case 62:
+        return Architecture::X86_64;
+    case 40:
+        return Architecture::ARM;
+    case 183:
+        return Architecture::ARM64;
+    case 243:
+        return is64 ? Architecture::RISCV64 : Architecture::Unknown;
+    case 21:
+        return Architecture::PPC64;
+    case 8:
+        return is64 ? Architecture::MIPS64 : Architecture::Unknown;
+    case 258:
+        return Architecture::LoongArch64;
+    default:
+        return Architecture::Unknown;
+    }
+}
+
+void parseElf(Reader &r, BinaryInfo &info) {
+    const bool is64 = r.u8(4) == 2;
+    r.setBigEndian(r.u8(5) == 2);
+
+    info.format = BinaryInfo::Format::ELF;
+    info.platform = Platform::Linux;
+    info.is64Bit = is64;
+    info.arch = elfMachine(r.u16(18), is64);
+
+    const quint64 phoff = is64 ? r.u64(32) : r.u32(28);
+    const quint16 phentsize = r.u16(is64 ? 54 : 42);
+    const quint16 phnum = r.u16(is64 ? 56 : 44);
+    if (!phoff || phentsize < (is64 ? 56 : 32)) return;
+
+    struct Segment {
+        quint32 type;
+        quint64 offset;
+        quint64 vaddr;
+        quint64 filesz;
+    };
+    std::vector<Segment> segments;
+    for (int i = 0; i < phnum && i < 256; ++i) {
+        const qint64 p = qint64(phoff) + qint64(i) * phentsize;
+        if (!r.has(p, phentsize)) break;
+        if (is64) {
+            segments.push_back({r.u32(p), r.u64(p + 8), r.u64(p + 16), r.u64(p + 32)});
+        } else {
+            segments.push_back({r.u32(p), r.u32(p + 4), r.u32(p + 8), r.u32(p + 16)});
+        }
+    }
+
+    constexpr quint32 PT_LOAD = 1, PT_DYNAMIC = 2, PT_INTERP = 3;
+    auto vaddrToOffset = [&](quint64 vaddr) -> qint64 {
+        for (const auto &s : segments) {
+            if (s.type == PT_LOAD && vaddr >= s.vaddr && vaddr - s.vaddr < s.filesz) {
+                return qint64(vaddr - s.vaddr + s.offset);
+            }
+        }
+        return -1;
+    };
+
+    for (const auto &s : segments) {
+        if (s.type == PT_INTERP) {
+            info.interpreter = r.string(qint64(s.offset), int(std::min<quint64>(s.filesz, 256)));
+        }
+    }
+
+    const auto dynamic = std::find_if(segments.begin(), segments.end(),
+                                      [](const Segment &s) { return s.type == PT_DYNAMIC; });
+    if (dynamic == segments.end()) return;
+
+    // Two passes: DT_STRTAB may follow the DT_NEEDED entries that refer to it
+    const int entrySize = is64 ? 16 : 8;
+    const qint64 count = qint64(std::min<quint64>(dynamic->filesz / entrySize, 4096));
+    auto tagAt = [&](qint64 i) -> quint64 {
+        const qint64 e = qint64(dynamic->offset) + i * entrySize;
+        return is64 ? r.u64(e) : r.u32(e);
+    };
+    auto valueAt = [&](qint64 i) -> quint64 {
+        const qint64 e = qint64(dynamic->offset) + i * entrySize + entrySize / 2;
+        return is64 ? r.u64(e) : r.u32(e);
+    };
+
+    constexpr quint64 DT_NULL = 0, DT_NEEDED = 1, DT_STRTAB = 5;
+    qint64 strtab = -1;
+    for (qint64 i = 0; i < count && tagAt(i) != DT_NULL; ++i) {
+        if (tagAt(i) == DT_STRTAB) strtab = vaddrToOffset(valueAt(i));
+    }
+    if (strtab < 0) return;
+
+    for (qint64 i = 0; i < count && tagAt(i) != DT_NULL; ++i) {
+        if (tagAt(i) != DT_NEEDED) continue;
+        const QString name = r.string(strtab + qint64(valueAt(i)));
+        if (!name.isEmpty()) info.needed << name;
+    }
+}
+
+// --- Mach-O ---
+
+Architecture machCpu(quint32 cpuType) {
+    switch (cpuType) {
+    case 7:
+        return Architecture::X86;
+    case 0x01000007:
+        return Architecture::X86_64;
+    case 12:
+        return Architecture::ARM;
+    case 0x0100000C:
+        return Architecture::ARM64;
+    case 0x01000012:
+        return Architecture::PPC64;
+    default:
+        return Architecture::Unknown;
+    }
+}
+
+void parseFat(Reader &r, BinaryInfo &info, bool fat64) {
+    r.setBigEndian(true);
+    const quint32 count = r.u32(4);
+    // Java class files share the 0xCAFEBABE magic; their "count" is the class
+    // file version, which is always 45 or above
+    if (count == 0 || count > 30) return;
+
+    info.format = BinaryInfo::Format::MachOFat;
+    info.platform = Platform::MacOS;
+
+    const int entrySize = fat64 ? 32 : 20;
+    for (quint32 i = 0; i < count; ++i) {
+        const qint64 e = 8 + qint64(i) * entrySize;
+        if (!r.has(e, entrySize)) break;
+        info.slices.push_back(machCpu(r.u32(e)));
+    }
+
+    // The slice the loader would pick: the host's, else the first 64-bit one
+    const Architecture host = hostArchitecture();
+    if (std::find(info.slices.begin(), info.slices.end(), host) != info.slices.end()) {
+        info.arch = host;
+    } else if (auto it = std::find_if(info.slices.begin(), info.slices.end(), is64BitArch);
+               it != info.slices.end()) {
+        info.arch = *it;
+    } else if (!info.slices.empty()) {
+        info.arch = info.slices.front();
+    }
+    info.is64Bit = is64BitArch(info.arch);
+}
+
+void parseMachO(Reader &r, BinaryInfo &info, bool bigEndian) {
+    r.setBigEndian(bigEndian);
+    info.format = BinaryInfo::Format::MachO;
+    info.platform = Platform::MacOS;
+    info.arch = machCpu(r.u32(4));
+    info.is64Bit = r.u32(0) == 0xFEEDFACF;
+}
+
+struct CacheEntry {
+    qint64 mtime;
+    qint64 size;
+    BinaryInfo info;
+};
+
+QMutex cacheMutex;
+QHash<QString, CacheEntry> cache;
+
+} // namespace
+
+BinaryInfo BinaryInspector::parse(const uchar *data, qint64 size) {
+    BinaryInfo info;
+    if (!data || size < 4) return info;
+
+    Reader r(data, size);
+    const quint32 magicLe = r.u32(0);
+    r.setBigEndian(true);
+    const quint32 magicBe = r.u32(0);
+    r.setBigEndian(false);
+
+    if (data[0] == 'M' && data[1] == 'Z') {
+        parseMz(r, info);
+    } else if (magicBe == 0x7F454C46) { // "\x7FELF"
+        parseElf(r, info);
+    } else if (magicBe == 0xCAFEBABE || magicBe == 0xCAFEBABF) {
+        parseFat(r, info, magicBe == 0xCAFEBABF);
+    } else if (magicLe == 0xFEEDFACE || magicLe == 0xFEEDFACF) {
+        parseMachO(r, info, false);
+    } else if (magicBe == 0xFEEDFACE || magicBe == 0xFEEDFACF) {
+        parseMachO(r, info, true);
+    }
+    return info;
+}
+
+BinaryInfo BinaryInspector::inspect(const QString &path) {
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.isFile()) return {};
+
+    const qint64 mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+    const qint64 size = fileInfo.size();
+    const QString key = fileInfo.absoluteFilePath();
+    {
+        QMutexLocker lock(&cacheMutex);
+        const auto it = cache.constFind(key);
+        if (it != cache.constEnd() && it->mtime == mtime && it->size == size) return it->info;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    BinaryInfo info;
+    uchar *mapped = size > kMapThreshold ? file.map(0, size) : nullptr;
+    if (mapped) {
+        info = parse(mapped, size);
+        file.unmap(mapped);
+    } else {
+        const QByteArray data = file.read(std::min(size, kMaxRead));
+        info = parse(reinterpret_cast<const uchar *>(data.constData()), data.size());
+    }
+
+    QMutexLocker lock(&cacheMutex);
+    if (cache.size() >= kMaxCacheEntries) cache.clear();
+    cache.insert(key, {mtime, size, info});
+    return info;
+}
+
+void BinaryInspector::clearCache() {
+    QMutexLocker lock(&cacheMutex);
+    cache.clear();
+}
+
+} // namespace opengalaxy::runners
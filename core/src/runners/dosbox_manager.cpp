@@ -1,60 +1,84 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "opengalaxy/runners/dosbox_manager.h"
 #include "opengalaxy/util/log.h"
+#include "process_info.h"
 
-#include <QProcess>
-#include <QStandardPaths>
-#include <QThread>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <algorithm>
 #include <signal.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 namespace opengalaxy::runners {
 
-QStringList DOSBoxManager::findRunningDOSBoxProcesses() {
-    QStringList pids;
+namespace {
+
+// Time a SIGKILLed process gets to disappear
+constexpr int kKillWaitMs = 500;
+
+qint64 parsePid(const QString &pid) {
+    bool ok = false;
+    const qint64 value = pid.toLongLong(&ok);
+    return ok && value > 0 ? value : 0;
+}
+
+// Opened before signalling so the waits and signals cannot hit a reused pid
+std::vector<ProcessHandle> openHandles(const QStringList &pids) {
+    std::vector<ProcessHandle> handles;
+    for (const QString &pid : pids) {
+        const qint64 value = parsePid(pid);
+        if (value > 0) handles.push_back({value, openPidfd(value)});
+    }
+    return handles;
+}
+
+void closeHandles(const std::vector<ProcessHandle> &handles) {
+    for (const auto &handle : handles) {
+        if (handle.pidfd >= 0) ::close(handle.pidfd);
+    }
+}
+
+bool isDOSBox(const ProcessInfo &info) {
+    if (info.comm.toLower().startsWith("dosbox")) return true;
+    // comm is truncated and may be a wrapper's name; argv[0] is the real executable
+    const QStringList args = processCommandLine(info.pid);
+    return !args.isEmpty() && QFileInfo(args.first()).fileName().toLower().startsWith("dosbox");
+}
 
-    auto *proc = new QProcess();
-    proc->setProgram("pgrep");
-    proc->setArguments({"-f", "dosbox"});
-    proc->start();
+} // namespace
 
-    if (proc->waitForFinished(5000)) {
-        const QString output = QString::fromUtf8(proc->readAllStandardOutput());
-        pids = output.split('\n', Qt::SkipEmptyParts);
-        LOG_INFO(QString("Found %1 DOSBox processes").arg(pids.size()));
+QStringList DOSBoxManager::findRunningDOSBoxProcesses() {
+    QStringList pids;
+    const qint64 self = QCoreApplication::applicationPid();
+    const auto processes = listProcesses();
+    for (const ProcessInfo &info : processes) {
+        if (info.pid == self || !info.isAlive() || !isOwnProcess(info.pid)) continue;
+        if (isDOSBox(info)) pids << QString::number(info.pid);
     }
 
-    proc->deleteLater();
+    LOG_INFO(QString("Found %1 DOSBox processes").arg(pids.size()));
     return pids;
 }
 
 bool DOSBoxManager::gracefullyTerminate(const QString &pid, int timeoutMs) {
-    if (pid.isEmpty()) return false;
-
-    bool ok = false;
-    int pidInt = pid.toInt(&ok);
-    if (!ok) return false;
+    const auto handles = openHandles({pid});
+    if (handles.empty()) return false;
 
     LOG_INFO(QString("Gracefully terminating DOSBox process: %1").arg(pid));
 
     // Send SIGTERM (allows process to save state)
-    if (kill(pidInt, SIGTERM) != 0) {
+    if (!signalProcess(handles.front(), SIGTERM)) {
         LOG_ERROR(QString("Failed to send SIGTERM to process %1").arg(pid));
+        closeHandles(handles);
         return false;
     }
 
-    // Wait for process to terminate
-    int elapsed = 0;
-    int checkInterval = 100; // Check every 100ms
-
-    while (elapsed < timeoutMs) {
-        if (!isProcessRunning(pid)) {
-            LOG_INFO(QString("Process %1 terminated gracefully").arg(pid));
-            return true;
-        }
-
-        QThread::msleep(checkInterval);
-        elapsed += checkInterval;
+    const bool exited = waitForExit(handles, timeoutMs).empty();
+    closeHandles(handles);
+    if (exited) {
+        LOG_INFO(QString("Process %1 terminated gracefully").arg(pid));
+        return true;
     }
 
     LOG_WARNING(
@@ -63,86 +87,87 @@ bool DOSBoxManager::gracefullyTerminate(const QString &pid, int timeoutMs) {
 }
 
 bool DOSBoxManager::forceKill(const QString &pid) {
-    if (pid.isEmpty()) return false;
-
-    bool ok = false;
-    int pidInt = pid.toInt(&ok);
-    if (!ok) return false;
+    const auto handles = openHandles({pid});
+    if (handles.empty()) return false;
 
     LOG_WARNING(QString("Force killing DOSBox process: %1").arg(pid));
 
     // Send SIGKILL (immediate termination)
-    if (kill(pidInt, SIGKILL) != 0) {
+    if (!signalProcess(handles.front(), SIGKILL)) {
         LOG_ERROR(QString("Failed to send SIGKILL to process %1").arg(pid));
+        closeHandles(handles);
         return false;
     }
 
-    // Wait a moment for process to die
-    QThread::msleep(500);
-
-    if (!isProcessRunning(pid)) {
-        LOG_INFO(QString("Process %1 force killed").arg(pid));
-        return true;
-    }
-
-    return false;
+    const bool exited = waitForExit(handles, kKillWaitMs).empty();
+    closeHandles(handles);
+    if (exited) LOG_INFO(QString("Process %1 force killed").arg(pid));
+    return exited;
 }
 
-int DOSBoxManager::terminateAllDOSBox(int timeoutMs) {
-    const QStringList pids = findRunningDOSBoxProcesses();
-    int terminated = 0;
-
-    LOG_INFO(QString("Terminating %1 DOSBox processes").arg(pids.size()));
-
-    // First, try graceful termination for all
-    for (const auto &pid : pids) {
-        if (gracefullyTerminate(pid, timeoutMs)) {
-            terminated++;
+int DOSBoxManager::terminateProcesses(const QStringList &pids, int timeoutMs) {
+    std::vector<ProcessHandle> handles = openHandles(pids);
+    if (handles.empty()) return 0;
+
+    // Everyone gets SIGTERM up front so they shut down in parallel
+    std::vector<ProcessHandle> signalled;
+    for (const auto &handle : handles) {
+        if (signalProcess(handle, SIGTERM)) {
+            signalled.push_back(handle);
+        } else {
+            LOG_ERROR(QString("Failed to send SIGTERM to process %1").arg(handle.pid));
         }
     }
 
-    // Force kill any remaining processes
-    for (const auto &pid : pids) {
-        if (isProcessRunning(pid)) {
-            if (forceKill(pid)) {
-                terminated++;
+    const std::vector<qint64> stubborn = waitForExit(signalled, timeoutMs);
+    int terminated = static_cast<int>(signalled.size() - stubborn.size());
+
+    if (!stubborn.empty()) {
+        LOG_WARNING(QString("%1 processes did not terminate within %2ms, forcing kill")
+                        .arg(stubborn.size())
+                        .arg(timeoutMs));
+        std::vector<ProcessHandle> killed;
+        for (const auto &handle : signalled) {
+            if (std::find(stubborn.begin(), stubborn.end(), handle.pid) != stubborn.end() &&
+                signalProcess(handle, SIGKILL)) {
+                killed.push_back(handle);
             }
         }
+        terminated += static_cast<int>(killed.size() - waitForExit(killed, kKillWaitMs).size());
     }
 
-    LOG_INFO(QString("Terminated %1 DOSBox processes").arg(terminated));
+    closeHandles(handles);
     return terminated;
 }
 
-bool DOSBoxManager::isProcessRunning(const QString &pid) {
-    if (pid.isEmpty()) return false;
-
-    auto *proc = new QProcess();
-    proc->setProgram("kill");
-    proc->setArguments({"-0", pid});
-    proc->start();
+int DOSBoxManager::terminateAllDOSBox(int timeoutMs) {
+    const QStringList pids = findRunningDOSBoxProcesses();
+    LOG_INFO(QString("Terminating %1 DOSBox processes").arg(pids.size()));
 
-    bool running = proc->waitForFinished(1000) && proc->exitCode() == 0;
-    proc->deleteLater();
+    const int terminated = terminateProcesses(pids, timeoutMs);
+    LOG_INFO(QString("Terminated %1 DOSBox processes").arg(terminated));
+    return terminated;
+}
 
-    return running;
+bool DOSBoxManager::isProcessRunning(const QString &pid) {
+    const qint64 value = parsePid(pid);
+    return value > 0 && isProcessAlive(value);
 }
 
 QString DOSBoxManager::getProcessInfo(const QString &pid) {
-    if (pid.isEmpty()) return "Invalid PID";
-
-    auto *proc = new QProcess();
-    proc->setProgram("ps");
-    proc->setArguments({"-p", pid, "-o", "pid,cmd,etime,rss"});
-    proc->start();
-
-    QString info;
-    if (proc->waitForFinished(2000)) {
-        info = QString::fromUtf8(proc->readAllStandardOutput());
-    }
-
-    proc->deleteLater();
-    return info;
+    const qint64 value = parsePid(pid);
+    if (value <= 0) return "Invalid PID";
+
+    ProcessInfo info;
+    if (!readProcessInfo(value, info)) return {};
+
+    static const qint64 pageKb = sysconf(_SC_PAGESIZE) / 1024;
+    const QStringList args = processCommandLine(value);
+    return QString("PID %1: %2 (uptime %3s, RSS %4 KiB)")
+        .arg(value)
+        .arg(args.isEmpty() ? QString::fromUtf8(info.comm) : args.join(' '))
+        .arg(processUptimeSeconds(info))
+        .arg(info.rssPages * pageKb);
 }
 
 bool DOSBoxManager::likelyHasUnsavedProgress(const QString &pid) {
@@ -152,45 +177,10 @@ bool DOSBoxManager::likelyHasUnsavedProgress(const QString &pid) {
 }
 
 int DOSBoxManager::getProcessUptime(const QString &pid) {
-    if (pid.isEmpty()) return -1;
-
-    auto *proc = new QProcess();
-    proc->setProgram("ps");
-    proc->setArguments({"-p", pid, "-o", "etime="});
-    proc->start();
-
-    int uptime = -1;
-
-    if (proc->waitForFinished(2000)) {
-        const QString output = QString::fromUtf8(proc->readAllStandardOutput()).trimmed();
-
-        // Parse etime format: [[DD-]HH:]MM:SS
-        const QStringList parts = output.split(':');
-
-        if (parts.size() >= 2) {
-            bool ok = false;
-            int seconds = parts.last().toInt(&ok);
-            if (ok && parts.size() >= 2) {
-                int minutes = parts[parts.size() - 2].toInt(&ok);
-                if (ok) {
-                    uptime = minutes * 60 + seconds;
-
-                    // Handle hours and days if present
-                    if (parts.size() >= 3) {
-                        int hours = parts[parts.size() - 3].toInt(&ok);
-                        if (ok) uptime += hours * 3600;
-                    }
-                    if (parts.size() >= 4) {
-                        int days = parts[0].toInt(&ok);
-                        if (ok) uptime += days * 86400;
-                    }
-                }
-            }
-        }
-    }
-
-    proc->deleteLater();
-    return uptime;
+    const qint64 value = parsePid(pid);
+    ProcessInfo info;
+    if (value <= 0 || !readProcessInfo(value, info)) return -1;
+    return static_cast<int>(processUptimeSeconds(info));
 }
 
 } // namespace opengalaxy::runners
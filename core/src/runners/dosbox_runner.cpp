@@ -1,14 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "opengalaxy/runners/dosbox_runner.h"
+#include "opengalaxy/runners/binary_info.h"
 #include "opengalaxy/runners/dosbox_manager.h"
+#include "opengalaxy/runners/resource_profile.h"
 #include "opengalaxy/util/log.h"
 
 #include <QDir>
-#include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
 #include <QProcess>
-#include <QProcessEnvironment>
 #include <QStandardPaths>
 #include <QTemporaryDir>
 #include <QTextStream>
@@ -16,14 +16,20 @@
 
 namespace opengalaxy::runners {
 
-DOSBoxRunner::DOSBoxRunner(const QString &dosboxPath) : dosboxPath_(dosboxPath) {}
+DOSBoxRunner::DOSBoxRunner(const QString &dosboxPath, const QString &version)
+    : dosboxPath_(dosboxPath), version_(version) {}
 
 QString DOSBoxRunner::name() const { return "DOSBox"; }
 
 QString DOSBoxRunner::version() const {
-    // Try to get DOSBox version
+    // capabilities() is called for every runner listing; only ever spawn DOSBox once
+    if (version_.isEmpty()) version_ = probeVersion(dosboxPath_);
+    return version_;
+}
+
+QString DOSBoxRunner::probeVersion(const QString &dosboxPath) {
     QProcess process;
-    process.setProgram(dosboxPath_);
+    process.setProgram(dosboxPath);
     process.setArguments({"-version"});
     process.start();
 
@@ -176,156 +182,20 @@ std::unique_ptr<QProcess> DOSBoxRunner::launch(const LaunchConfig &config) {
         return nullptr;
     }
 
-    // Determine the actual game path
-    // config.gamePath might be a directory (install path) or an executable
+    // Launches normally pass the indexed executable. A directory means the index
+    // found nothing; only its top level is looked at, never the whole tree.
     QString gamePath = config.gamePath;
-    QFileInfo pathInfo(gamePath);
-
-    // If gamePath is a directory, find the main executable
-    if (pathInfo.isDir()) {
-        LOG_INFO(QString("Game path is a directory, searching for executable: %1").arg(gamePath));
-
-        // Search in multiple locations:
-        // 1. Direct game directory
-        // 2. Wine prefix (.wine/drive_c)
-        // 3. Proton prefix (.proton/pfx/drive_c)
-        // 4. Recursively in subdirectories
-
-        QStringList searchPaths;
-        searchPaths << gamePath;                          // Direct directory
-        searchPaths << gamePath + "/.wine/drive_c";       // Wine prefix
-        searchPaths << gamePath + "/.proton/pfx/drive_c"; // Proton prefix
-
-        QFileInfoList exeFiles;
-
-        // Helper lambda to recursively find executables
-        auto findExecutablesRecursive = [](const QString &rootPath) -> QFileInfoList {
-            QFileInfoList allExes;
-            QStringList exeFilters = {"*.exe", "*.com", "*.bat"};
-
-            QDirIterator it(rootPath, exeFilters, QDir::Files, QDirIterator::Subdirectories);
-            while (it.hasNext()) {
-                allExes.append(QFileInfo(it.next()));
-            }
-
-            // Sort by size (largest first)
-            std::sort(allExes.begin(), allExes.end(),
-                      [](const QFileInfo &a, const QFileInfo &b) { return a.size() > b.size(); });
-
-            return allExes;
-        };
-
-        for (const QString &searchPath : searchPaths) {
-            QDir searchDir(searchPath);
-            if (!searchDir.exists()) {
-                LOG_INFO(QString("Search path does not exist: %1").arg(searchPath));
-                continue;
-            }
-
-            LOG_INFO(QString("Searching for executables in: %1").arg(searchPath));
-
-            // List all files in the directory for debugging
-            QStringList allFiles =
-                searchDir.entryList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
-            if (!allFiles.isEmpty()) {
-                LOG_INFO(QString("Files in %1: %2").arg(searchPath, allFiles.join(", ")));
-            } else {
-                LOG_INFO(QString("Directory is empty: %1").arg(searchPath));
-            }
-
-            // Recursive search for executables
-            exeFiles = findExecutablesRecursive(searchPath);
-
-            // If found in this path, use it
-            if (!exeFiles.isEmpty()) {
-                LOG_INFO(QString("Found %1 executable files in: %2")
-                             .arg(exeFiles.size())
-                             .arg(searchPath));
-                break;
-            }
-        }
-
-        if (!exeFiles.isEmpty()) {
-            // Filter out setup/installer executables
-            QStringList installerPatterns = {"setup", "install", "uninstall", "patch", "update"};
-
-            // First pass: Look for .exe DOS executables that are NOT installers
-            for (const auto &fileInfo : exeFiles) {
-                if (!fileInfo.isFile()) continue;
-
-                QString fileName = fileInfo.fileName().toLower();
-                QString fileExt = QFileInfo(fileName).suffix().toLower();
-
-                // Skip batch files in first pass (prefer .exe)
-                if (fileExt == "bat") continue;
-
-                bool isInstaller = false;
-                for (const auto &pattern : installerPatterns) {
-                    if (fileName.contains(pattern)) {
-                        isInstaller = true;
-                        break;
-                    }
-                }
-
-                if (!isInstaller && isDOSGame(fileInfo.absoluteFilePath())) {
-                    gamePath = fileInfo.absoluteFilePath();
-                    LOG_INFO(QString("Found DOS executable (non-installer): %1").arg(gamePath));
-                    break;
-                }
-            }
-
-            // Second pass: Look for any DOS executable (including installers)
-            if (gamePath == config.gamePath) {
-                for (const auto &fileInfo : exeFiles) {
-                    if (!fileInfo.isFile()) continue;
-
-                    if (isDOSGame(fileInfo.absoluteFilePath())) {
-                        gamePath = fileInfo.absoluteFilePath();
-                        LOG_INFO(QString("Found DOS executable: %1").arg(gamePath));
-                        break;
-                    }
-                }
-            }
-
-            // Third pass: Use largest non-installer file
-            if (gamePath == config.gamePath) {
-                for (const auto &fileInfo : exeFiles) {
-                    if (!fileInfo.isFile()) continue;
-
-                    QString fileName = fileInfo.fileName().toLower();
-                    bool isInstaller = false;
-                    for (const auto &pattern : installerPatterns) {
-                        if (fileName.contains(pattern)) {
-                            isInstaller = true;
-                            break;
-                        }
-                    }
-
-                    if (!isInstaller) {
-                        gamePath = fileInfo.absoluteFilePath();
-                        LOG_WARNING(QString("Using largest non-installer file: %1").arg(gamePath));
-                        break;
-                    }
-                }
-            }
-
-            // Last resort: Use largest file (even if installer)
-            if (gamePath == config.gamePath && !exeFiles.isEmpty()) {
-                for (const auto &fileInfo : exeFiles) {
-                    if (fileInfo.isFile()) {
-                        gamePath = fileInfo.absoluteFilePath();
-                        LOG_WARNING(QString("No suitable executable found, using largest file: %1")
-                                        .arg(gamePath));
-                        break;
-                    }
-                }
-            }
-        } else {
-            LOG_ERROR(
-                QString("No executable files found in game directory or Wine/Proton prefix: %1")
-                    .arg(gamePath));
+    if (QFileInfo(gamePath).isDir()) {
+        const QFileInfoList files =
+            QDir(gamePath).entryInfoList({"*.exe", "*.com"}, QDir::Files, QDir::Name);
+        const auto dosFile = std::find_if(files.begin(), files.end(), [](const QFileInfo &file) {
+            return BinaryInspector::inspect(file.absoluteFilePath()).platform == Platform::DOS;
+        });
+        if (dosFile == files.end()) {
+            LOG_ERROR(QString("No DOS executable found in game directory: %1").arg(gamePath));
             return nullptr;
         }
+        gamePath = dosFile->absoluteFilePath();
     }
 
     // Create a modified config with the actual executable path
@@ -341,11 +211,11 @@ std::unique_ptr<QProcess> DOSBoxRunner::launch(const LaunchConfig &config) {
                             .arg(pid)
                             .arg(DOSBoxManager::getProcessUptime(pid)));
         }
-        if (DOSBoxManager::gracefullyTerminate(pid, 3000)) {
-            LOG_INFO(QString("Terminated old DOSBox process: %1").arg(pid));
-        } else if (DOSBoxManager::forceKill(pid)) {
-            LOG_WARNING(QString("Force killed old DOSBox process: %1").arg(pid));
-        }
+    }
+    if (!oldPids.isEmpty()) {
+        // All at once: the wait is bounded by the timeout, not by timeout per process
+        const int terminated = DOSBoxManager::terminateProcesses(oldPids, 3000);
+        LOG_INFO(QString("Terminated %1 old DOSBox processes").arg(terminated));
     }
 
     // Create DOSBox configuration
@@ -369,14 +239,9 @@ std::unique_ptr<QProcess> DOSBoxRunner::launch(const LaunchConfig &config) {
     process->setArguments(args);
     process->setWorkingDirectory(QFileInfo(modifiedConfig.gamePath).absolutePath());
 
-    // Set environment
-    QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
-    for (auto it = modifiedConfig.environment.begin(); it != modifiedConfig.environment.end();
-         ++it) {
-        env << (it.key() + "=" + it.value());
-    }
-    process->setEnvironment(env);
+    environment(modifiedConfig).applyTo(*process);
 
+    ResourceProfile::applyTo(*process, modifiedConfig.profile, modifiedConfig.gameMode);
     process->start();
 
     if (!process->waitForStarted(3000)) {
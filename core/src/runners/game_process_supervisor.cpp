@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/game_process_supervisor.h"
+#include "opengalaxy/runners/resource_profile.h"
+#include "opengalaxy/util/log.h"
+#include "process_info.h"
+
+#include <QMultiHash>
+#include <QSocketNotifier>
+#include <algorithm>
+#include <utility>
+
+#include <signal.h>
+#include <unistd.h>
+
+namespace opengalaxy::runners {
+
+namespace {
+
+constexpr int kSampleIntervalMs = 2000;
+// Lets a burst of pidfd wakeups (a whole tree going down) share one sample
+constexpr int kCoalesceMs = 100;
+constexpr const char *kGameIdVariable = "OPENGALAXY_GAME_ID";
+
+// Lingers after its clients exit so the next wine start is fast; never keeps a game running
+bool isBackgroundHelper(const QByteArray &comm) { return comm == "wineserver"; }
+
+// Game id from a process's environment; empty for other users' processes
+QString taggedGameId(qint64 pid) {
+    return QString::fromUtf8(processEnvironmentValue(pid, kGameIdVariable));
+}
+
+// SCHED_* values from sched.h, plus SCHED_ISO from the MuQSS/-ck patches
+QString schedPolicyName(int policy) {
+    switch (policy) {
+    case 0:
+        return "normal";
+    case 1:
+        return "fifo";
+    case 2:
+        return "rr";
+    case 3:
+        return "batch";
+    case 4:
+        return "iso";
+    case 5:
+        return "idle";
+    case 6:
+        return "deadline";
+    default:
+        return QString::number(policy);
+    }
+}
+
+// The notifier must stop polling before its pidfd is closed
+void closeExitNotifier(QSocketNotifier *notifier) {
+    notifier->setEnabled(false);
+    ::close(static_cast<int>(notifier->socket()));
+    notifier->deleteLater();
+}
+
+} // namespace
+
+GameProcessSupervisor::GameProcessSupervisor(QObject *parent) : QObject(parent) {
+    sampleTimer_.setInterval(kSampleIntervalMs);
+    connect(&sampleTimer_, &QTimer::timeout, this, &GameProcessSupervisor::sample);
+}
+
+GameProcessSupervisor::~GameProcessSupervisor() {
+    for (const auto &game : std::as_const(games_)) {
+        for (QSocketNotifier *notifier : std::as_const(game->exitNotifiers)) {
+            closeExitNotifier(notifier);
+        }
+        // QProcess's destructor would kill the game; closing the client must not
+        if (game->process) {
+            game->process->disconnect(this);
+            game->process.release();
+        }
+    }
+}
+
+void GameProcessSupervisor::tagLaunch(LaunchConfig &config, const QString &gameId) {
+    config.gameId = gameId;
+    config.environment.insert(kGameIdVariable, gameId);
+}
+
+bool GameProcessSupervisor::supervise(const QString &gameId, std::unique_ptr<QProcess> process) {
+    if (!process || process->state() != QProcess::Running || games_.contains(gameId)) {
+        return false;
+    }
+
+    auto game = std::make_shared<Game>();
+    game->gameId = gameId;
+    game->leader = process->processId();
+    game->startedAt = QDateTime::currentDateTime();
+    game->tree.insert(game->leader);
+    game->process = std::move(process);
+
+    connect(game->process.get(), &QProcess::finished, this,
+            [this, gameId](int exitCode, QProcess::ExitStatus status) {
+                const auto it = games_.constFind(gameId);
+                if (it == games_.constEnd()) return;
+                Game &game = **it;
+                game.leaderFinished = true;
+                game.exitCode = exitCode;
+                game.crashed = status == QProcess::CrashExit && !game.stopping;
+                scheduleSample();
+            });
+
+    watchExit(*game, game->leader);
+    games_.insert(gameId, game);
+    if (!sampleTimer_.isActive()) sampleTimer_.start();
+
+    LOG_INFO(QString("Supervising game %1 (pid %2)").arg(gameId).arg(game->leader));
+    emit gameStarted(gameId, game->leader);
+    return true;
+}
+
+bool GameProcessSupervisor::isRunning(const QString &gameId) const {
+    return games_.contains(gameId);
+}
+
+QStringList GameProcessSupervisor::runningGames() const { return games_.keys(); }
+
+std::vector<qint64> GameProcessSupervisor::processTree(const QString &gameId) const {
+    std::vector<qint64> pids;
+    const auto it = games_.constFind(gameId);
+    if (it == games_.constEnd()) return pids;
+
+    const Game &game = **it;
+    if (game.tree.contains(game.leader)) pids.push_back(game.leader);
+    for (qint64 pid : game.tree) {
+        if (pid != game.leader) pids.push_back(pid);
+    }
+    return pids;
+}
+
+GameProcessStats GameProcessSupervisor::stats(const QString &gameId) const {
+    const auto it = games_.constFind(gameId);
+    return it != games_.constEnd() ? statsFor(**it) : GameProcessStats();
+}
+
+GameProcessStats GameProcessSupervisor::statsFor(const Game &game) const {
+    static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+    GameProcessStats stats;
+    stats.pid = game.leader;
+    stats.startedAt = game.startedAt;
+    stats.wallTimeMs = game.startedAt.msecsTo(QDateTime::currentDateTime());
+    qint64 ticks = 0;
+    for (qint64 t : game.cpuTicks) ticks += t;
+    stats.cpuTimeMs = ticksPerSecond > 0 ? ticks * 1000 / ticksPerSecond : 0;
+    stats.peakRssKb = game.peakRssKb;
+    stats.processCount = static_cast<int>(game.tree.size());
+    stats.cpuAffinity = game.cpuAffinity;
+    stats.nice = game.nice;
+    stats.schedPolicy = schedPolicyName(game.policy);
+    stats.cgroup = game.cgroup;
+    return stats;
+}
+
+void GameProcessSupervisor::stop(const QString &gameId, int timeoutMs) {
+    if (!games_.contains(gameId)) return;
+
+    LOG_INFO(QString("Stopping game %1").arg(gameId));
+    sample(); // Catch processes started since the last sample
+    const auto game = games_.value(gameId);
+    if (!game) return; // Already gone
+
+    game->stopping = true;
+    signalTree(*game, SIGTERM);
+
+    QTimer::singleShot(timeoutMs, this, [this, gameId]() {
+        const auto game = games_.value(gameId);
+        if (!game || !game->stopping) return;
+        sample();
+        if (games_.contains(gameId)) {
+            LOG_WARNING(QString("Game %1 ignored SIGTERM, killing it").arg(gameId));
+            signalTree(*game, SIGKILL);
+        }
+    });
+}
+
+void GameProcessSupervisor::signalTree(Game &game, int signal) {
+    const auto processes = listProcesses();
+    for (qint64 pid : std::as_const(game.tree)) {
+        const auto info = processes.constFind(pid);
+        if (info != processes.constEnd() && isBackgroundHelper(info->comm)) continue;
+
+        QSocketNotifier *notifier = game.exitNotifiers.value(pid);
+        const int pidfd = notifier ? static_cast<int>(notifier->socket()) : -1;
+        signalProcess({pid, pidfd}, signal);
+    }
+}
+
+void GameProcessSupervisor::watchExit(Game &game, qint64 pid) {
+    if (game.exitNotifiers.contains(pid)) return;
+    const int pidfd = openPidfd(pid);
+    if (pidfd < 0) return; // Old kernel: the periodic sample notices the exit
+
+    // A pidfd becomes readable when the process exits
+    auto *notifier = new QSocketNotifier(pidfd, QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, [this, notifier]() {
+        notifier->setEnabled(false);
+        scheduleSample();
+    });
+    game.exitNotifiers.insert(pid, notifier);
+}
+
+void GameProcessSupervisor::scheduleSample() {
+    if (samplePending_) return;
+    samplePending_ = true;
+    QTimer::singleShot(kCoalesceMs, this, [this]() {
+        samplePending_ = false;
+        sample();
+    });
+}
+
+void GameProcessSupervisor::sample() {
+    if (games_.isEmpty()) {
+        sampleTimer_.stop();
+        return;
+    }
+
+    const QHash<qint64, ProcessInfo> processes = listProcesses();
+    QMultiHash<qint64, qint64> children;
+    for (const ProcessInfo &info : processes) {
+        if (info.isAlive()) children.insert(info.ppid, info.pid);
+    }
+
+    // Known members and everything below them
+    QHash<qint64, QString> owner;
+    QHash<QString, QSet<qint64>> reached;
+    auto claim = [&](const QString &gameId, qint64 root) {
+        QList<qint64> queue{root};
+        while (!queue.isEmpty()) {
+            const qint64 pid = queue.takeLast();
+            if (owner.contains(pid)) continue;
+            owner.insert(pid, gameId);
+            reached[gameId].insert(pid);
+            queue += children.values(pid);
+        }
+    };
+
+    for (const auto &game : std::as_const(games_)) {
+        reached[game->gameId];
+        for (qint64 pid : std::as_const(game->tree)) {
+            const auto info = processes.constFind(pid);
+            if (info != processes.constEnd() && info->isAlive()) claim(game->gameId, pid);
+        }
+    }
+
+    // Orphans: reparented away from their game, found by the tag in their environment
+    for (const ProcessInfo &info : processes) {
+        if (!info.isAlive() || owner.contains(info.pid)) continue;
+        if (foreign_.value(info.pid, -1) == info.startTime) continue;
+
+        const QString gameId = taggedGameId(info.pid);
+        if (games_.contains(gameId)) {
+            claim(gameId, info.pid);
+        } else {
+            foreign_.insert(info.pid, info.startTime);
+        }
+    }
+    for (auto it = foreign_.begin(); it != foreign_.end();) {
+        it = processes.contains(it.key()) ? std::next(it) : foreign_.erase(it);
+    }
+
+    static const qint64 pageKb = sysconf(_SC_PAGESIZE) / 1024;
+    QStringList finished;
+    for (const auto &game : std::as_const(games_)) {
+        const QSet<qint64> &alive = reached[game->gameId];
+
+        int running = 0;
+        qint64 rssKb = 0;
+        for (qint64 pid : alive) {
+            const ProcessInfo info = processes.value(pid);
+            game->cpuTicks[pid] = info.cpuTicks;
+            rssKb += info.rssPages * pageKb;
+            if (!isBackgroundHelper(info.comm)) ++running;
+            watchExit(*game, pid);
+        }
+        game->peakRssKb = std::max(game->peakRssKb, rssKb);
+
+        // Followed for as long as the leader lives: systemd-run only moves it into
+        // its scope after the start
+        const auto leader = processes.constFind(game->leader);
+        if (leader != processes.constEnd() && leader->isAlive()) {
+            const QString cpus = ResourceProfile::formatCpuList(processAffinity(game->leader));
+            const QString cgroup = processCgroup(game->leader);
+            if (cpus != game->cpuAffinity || cgroup != game->cgroup || leader->nice != game->nice ||
+                leader->policy != game->policy) {
+                game->cpuAffinity = cpus;
+                game->cgroup = cgroup;
+                game->nice = leader->nice;
+                game->policy = leader->policy;
+                LOG_INFO(QString("Game %1 runs on CPUs %2, nice %3, %4 scheduling, cgroup %5")
+                             .arg(game->gameId, cpus)
+                             .arg(game->nice)
+                             .arg(schedPolicyName(game->policy), cgroup));
+            }
+        }
+
+        // Drop pidfds of processes that are gone
+        for (auto it = game->exitNotifiers.begin(); it != game->exitNotifiers.end();) {
+            if (alive.contains(it.key())) {
+                ++it;
+                continue;
+            }
+            closeExitNotifier(it.value());
+            it = game->exitNotifiers.erase(it);
+        }
+
+        // Without /proc all that is known is the leader
+        if (processes.isEmpty()) {
+            running = game->leaderFinished ? 0 : 1;
+        } else {
+            game->tree = alive;
+        }
+
+        if (game->leaderFinished && running == 0) finished << game->gameId;
+    }
+
+    for (const QString &gameId : finished) {
+        finish(gameId);
+    }
+}
+
+void GameProcessSupervisor::finish(const QString &gameId) {
+    const auto game = games_.take(gameId);
+    if (!game) return;
+
+    for (QSocketNotifier *notifier : std::as_const(game->exitNotifiers)) {
+        closeExitNotifier(notifier);
+    }
+    game->exitNotifiers.clear();
+    game->tree.clear();
+
+    const GameProcessStats stats = statsFor(*game);
+    LOG_INFO(QString("Game %1 exited with code %2 after %3 s (CPU %4 s, peak RSS %5 MiB)")
+                 .arg(gameId)
+                 .arg(game->exitCode)
+                 .arg(stats.wallTimeMs / 1000)
+                 .arg(stats.cpuTimeMs / 1000)
+                 .arg(stats.peakRssKb / 1024));
+
+    if (games_.isEmpty()) sampleTimer_.stop();
+
+    // The QProcess has finished; it may be deleted once its signal handlers return
+    game->process.release()->deleteLater();
+    emit gameExited(gameId, game->exitCode, game->crashed, stats);
+}
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/launch_environment.h"
+#include "opengalaxy/util/config.h"
+#include "opengalaxy/util/log.h"
+
+#include <algorithm>
+
+namespace opengalaxy::runners {
+
+namespace {
+
+const char *layerName(LaunchEnvironment::Layer layer) {
+    switch (layer) {
+    case LaunchEnvironment::Layer::Global:
+        return "global";
+    case LaunchEnvironment::Layer::Runner:
+        return "runner";
+    case LaunchEnvironment::Layer::Game:
+        return "game";
+    }
+    return "";
+}
+
+} // namespace
+
+LaunchEnvironment::LaunchEnvironment() {
+    layers_[size_t(Layer::Global)] = util::Config::instance().launchEnvironment();
+}
+
+LaunchEnvironment::LaunchEnvironment(const QMap<QString, QString> &gameEnvironment)
+    : LaunchEnvironment() {
+    layers_[size_t(Layer::Game)] = gameEnvironment;
+}
+
+const QProcessEnvironment &LaunchEnvironment::systemEnvironment() {
+    // Copies share the data, so a launch only pays for the variables it overrides
+    static const QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    return environment;
+}
+
+void LaunchEnvironment::insert(Layer layer, const QString &name, const QString &value) {
+    layers_[size_t(layer)].insert(name, value);
+}
+
+bool LaunchEnvironment::contains(const QString &name) const {
+    return std::any_of(layers_.begin(), layers_.end(),
+                       [&name](const auto &layer) { return layer.contains(name); }) ||
+           systemEnvironment().contains(name);
+}
+
+QString LaunchEnvironment::value(const QString &name, const QString &defaultValue) const {
+    for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+        const auto found = it->constFind(name);
+        if (found != it->cend()) return found.value();
+    }
+    return systemEnvironment().value(name, defaultValue);
+}
+
+QMap<QString, std::pair<QString, LaunchEnvironment::Layer>> LaunchEnvironment::merged() const {
+    QMap<QString, std::pair<QString, Layer>> result;
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        for (auto it = layers_[i].cbegin(); it != layers_[i].cend(); ++it) {
+            result.insert(it.key(), {it.value(), Layer(i)});
+        }
+    }
+    return result;
+}
+
+QProcessEnvironment LaunchEnvironment::toProcessEnvironment() const {
+    QProcessEnvironment environment = systemEnvironment();
+    const auto overrides = merged();
+    for (auto it = overrides.cbegin(); it != overrides.cend(); ++it) {
+        environment.insert(it.key(), it.value().first);
+    }
+    return environment;
+}
+
+void LaunchEnvironment::applyTo(QProcess &process) const {
+    LOG_DEBUG(QString("Launch environment for %1:\n  %2")
+                  .arg(process.program(), describeOverrides().join("\n  ")));
+    process.setProcessEnvironment(toProcessEnvironment());
+}
+
+QStringList LaunchEnvironment::describe() const {
+    const QProcessEnvironment environment = toProcessEnvironment();
+    const auto overrides = merged();
+
+    QStringList names = environment.keys();
+    names.sort();
+    QStringList lines;
+    lines.reserve(names.size());
+    for (const QString &name : names) {
+        QString line = name + '=' + environment.value(name);
+        const auto found = overrides.constFind(name);
+        if (found != overrides.cend()) {
+            line += QString("  [%1]").arg(layerName(found.value().second));
+        }
+        lines << line;
+    }
+    return lines;
+}
+
+QStringList LaunchEnvironment::describeOverrides() const {
+    QStringList lines;
+    const auto overrides = merged();
+    for (auto it = overrides.cbegin(); it != overrides.cend(); ++it) {
+        lines << QString("%1=%2  [%3]")
+                     .arg(it.key(), it.value().first, layerName(it.value().second));
+    }
+    return lines;
+}
+
+} // namespace opengalaxy::runners
@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/prefix_manager.h"
+#include "opengalaxy/runners/launch_environment.h"
+#include "opengalaxy/util/config.h"
+#include "opengalaxy/util/log.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QStandardPaths>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace opengalaxy::runners {
+
+namespace {
+
+constexpr int kBootTimeoutMs = 180000;
+
+// One template boot at a time; two games installed together share the result
+QMutex templateMutex;
+
+bool isEmptyOrMissing(const QString &path) {
+    const QFileInfo info(path);
+    if (!info.exists()) return true;
+    return info.isDir() && QDir(path).isEmpty(QDir::AllEntries | QDir::NoDotAndDotDot |
+                                              QDir::Hidden | QDir::System);
+}
+
+#ifdef Q_OS_LINUX
+// Reflink, then an in-kernel copy, then a plain read/write loop
+bool copyFile(const QString &source, const QString &destination, mode_t mode,
+              CloneStats &stats) {
+    const int in = ::open(QFile::encodeName(source).constData(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return false;
+    const int out = ::open(QFile::encodeName(destination).constData(),
+                           O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode & 07777);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool ok = true;
+    if (::ioctl(out, FICLONE, in) == 0) {
+        ++stats.reflinked;
+    } else {
+        bool kernelCopy = true;
+        qint64 copied = 0;
+        while (true) {
+            ssize_t n = -1;
+            if (kernelCopy) n = ::copy_file_range(in, nullptr, out, nullptr, 1 << 30, 0);
+            // Unsupported for this pair of files; only safe to switch before any data moved
+            if (n < 0 && kernelCopy && copied == 0 &&
+                (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+                kernelCopy = false;
+            }
+            if (!kernelCopy) {
+                char buffer[1 << 16];
+                n = ::read(in, buffer, sizeof(buffer));
+                if (n > 0 && ::write(out, buffer, n) != n) n = -1;
+            }
+            if (n == 0) break;
+            if (n < 0) {
+                ok = false;
+                break;
+            }
+            copied += n;
+        }
+        stats.bytesCopied += copied;
+    }
+
+    ::close(in);
+    ::close(out);
+    return ok;
+}
+
+bool cloneTree(const QString &source, const QString &destination, CloneStats &stats) {
+    struct stat st;
+    if (::lstat(QFile::encodeName(source).constData(), &st) != 0) return false;
+    if (::mkdir(QFile::encodeName(destination).constData(), st.st_mode & 07777) != 0 &&
+        errno != EEXIST) {
+        return false;
+    }
+
+    const QStringList entries = QDir(source).entryList(
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    for (const QString &name : entries) {
+        const QString from = source + '/' + name;
+        const QString to = destination + '/' + name;
+        const QByteArray fromPath = QFile::encodeName(from);
+        if (::lstat(fromPath.constData(), &st) != 0) return false;
+
+        if (S_ISLNK(st.st_mode)) {
+            // Kept verbatim: dosdevices/c: is relative, z: points at / and must not be followed
+            QByteArray target(st.st_size > 0 ? st.st_size + 1 : PATH_MAX, '\0');
+            const ssize_t n = ::readlink(fromPath.constData(), target.data(), target.size());
+            if (n < 0) return false;
+            target.truncate(n);
+            if (::symlink(target.constData(), QFile::encodeName(to).constData()) != 0) {
+                return false;
+            }
+        } else if (S_ISDIR(st.st_mode)) {
+            if (!cloneTree(from, to, stats)) return false;
+        } else if (S_ISREG(st.st_mode)) {
+            if (!copyFile(from, to, st.st_mode, stats)) return false;
+            ++stats.files;
+        }
+        // Sockets and fifos (wineserver's) are left out
+    }
+    return true;
+}
+#else
+bool cloneTree(const QString &source, const QString &destination, CloneStats &stats) {
+    if (!QDir().mkpath(destination)) return false;
+    const QFileInfoList entries = QDir(source).entryInfoList(
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    for (const QFileInfo &entry : entries) {
+        const QString to = destination + '/' + entry.fileName();
+        if (entry.isSymLink()) {
+            if (!QFile::link(entry.symLinkTarget(), to)) return false;
+        } else if (entry.isDir()) {
+            if (!cloneTree(entry.absoluteFilePath(), to, stats)) return false;
+        } else {
+            if (!QFile::copy(entry.absoluteFilePath(), to)) return false;
+            ++stats.files;
+            stats.bytesCopied += entry.size();
+        }
+    }
+    return true;
+}
+#endif
+
+// Runs a step of the template boot to completion
+bool runStep(const QString &program, const QStringList &args, const QProcessEnvironment &env) {
+    QProcess process;
+    process.setProgram(program);
+    process.setArguments(args);
+    process.setProcessEnvironment(env);
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start();
+    if (!process.waitForStarted(5000) || !process.waitForFinished(kBootTimeoutMs)) {
+        LOG_ERROR(QString("Prefix setup step %1 %2 did not finish: %3")
+                      .arg(program, args.join(' '), process.errorString()));
+        process.kill();
+        process.waitForFinished(1000);
+        return false;
+    }
+    return process.exitStatus() == QProcess::NormalExit;
+}
+
+} // namespace
+
+PrefixManager::PrefixManager(QObject *parent) : QObject(parent) {
+    // wineboot is heavy; booting two templates at once only slows both down
+    pool_.setMaxThreadCount(1);
+}
+
+PrefixManager::~PrefixManager() { pool_.waitForDone(); }
+
+QString PrefixManager::containingPrefix(PrefixSpec::Type type, const QString &gamePath) {
+    const QStringList parts = QFileInfo(gamePath).absoluteFilePath().split('/');
+    int end = parts.lastIndexOf("drive_c");
+    // A Proton compat data directory holds the prefix as pfx/
+    if (type == PrefixSpec::Type::Proton) end = end > 0 && parts[end - 1] == "pfx" ? end - 1 : -1;
+    if (end < 1) return {};
+    return parts.mid(0, end).join('/');
+}
+
+QString PrefixManager::winePrefix(const PrefixSpec &spec) {
+    return spec.type == PrefixSpec::Type::Proton ? spec.path + "/pfx" : spec.path;
+}
+
+QString PrefixManager::wineserverPath(const PrefixSpec &spec) {
+    const QDir dir = QFileInfo(spec.runnerExecutable).dir();
+    const QStringList candidates = spec.type == PrefixSpec::Type::Proton
+                                       ? QStringList{dir.filePath("files/bin/wineserver"),
+                                                     dir.filePath("dist/bin/wineserver")}
+                                       : QStringList{dir.filePath("wineserver")};
+    for (const QString &candidate : candidates) {
+        if (QFileInfo(candidate).isExecutable()) return candidate;
+    }
+    return QStandardPaths::findExecutable("wineserver");
+}
+
+QString PrefixManager::templatePath(const PrefixSpec &spec) {
+    const QFileInfo runner(spec.runnerExecutable);
+    const QByteArray identity = QString("%1|%2|%3")
+                                    .arg(runner.absoluteFilePath())
+                                    .arg(runner.size())
+                                    .arg(runner.lastModified().toMSecsSinceEpoch())
+                                    .toUtf8();
+    const QString hash =
+        QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex().left(16);
+    const QString kind = spec.type == PrefixSpec::Type::Proton ? "proton" : "wine";
+    return util::Config::instance().prefixTemplateDir() + '/' + kind + '-' + hash;
+}
+
+bool PrefixManager::isInitialised(PrefixSpec::Type type, const QString &path) {
+    if (path.isEmpty()) return false;
+    const QString root = winePrefix({type, QString(), path});
+    return QFileInfo::exists(root + "/system.reg") && QFileInfo(root + "/drive_c").isDir();
+}
+
+bool PrefixManager::cloneTemplate(const PrefixSpec &spec) {
+    if (spec.path.isEmpty() || !isEmptyOrMissing(spec.path)) return false;
+
+    const QString source = templatePath(spec);
+    if (!isInitialised(spec.type, source)) return false;
+
+    const auto result = clone(source, spec.path);
+    if (result.isError()) {
+        LOG_WARNING(QString("Could not clone prefix template %1 to %2: %3")
+                        .arg(source, spec.path, result.errorMessage()));
+        return false;
+    }
+    return true;
+}
+
+util::Result<QString> PrefixManager::prepare(const PrefixSpec &spec) {
+    if (spec.path.isEmpty()) return util::Result<QString>::error("No prefix path");
+    if (isInitialised(spec.type, spec.path)) return util::Result<QString>::success(spec.path);
+    if (!isEmptyOrMissing(spec.path)) {
+        // Half-made by something else; the runner finishes it on launch
+        return util::Result<QString>::error(
+            QString("Prefix %1 exists but is not initialised").arg(spec.path));
+    }
+
+    const auto boot = bootTemplate(spec);
+    if (boot.isError()) return boot;
+    if (!cloneTemplate(spec)) {
+        return util::Result<QString>::error(QString("Could not clone prefix to %1").arg(spec.path));
+    }
+    return util::Result<QString>::success(spec.path);
+}
+
+util::Result<QString> PrefixManager::bootTemplate(const PrefixSpec &spec) {
+    QMutexLocker locker(&templateMutex);
+
+    const QString target = templatePath(spec);
+    if (isInitialised(spec.type, target)) return util::Result<QString>::success(target);
+    if (!QFileInfo(spec.runnerExecutable).isExecutable()) {
+        return util::Result<QString>::error(
+            QString("Runner %1 is not executable").arg(spec.runnerExecutable));
+    }
+
+    // Booted under a temporary name and renamed, so a crash never leaves a
+    // half-made template that looks usable
+    const QString staging =
+        QString("%1.tmp-%2").arg(target).arg(QCoreApplication::applicationPid());
+    QDir(staging).removeRecursively();
+    QDir().mkpath(staging);
+
+    LOG_INFO(QString("Creating prefix template %1 with %2").arg(target, spec.runnerExecutable));
+    const qint64 started = QDateTime::currentMSecsSinceEpoch();
+
+    QProcessEnvironment env = LaunchEnvironment::systemEnvironment();
+    env.insert("WINEDEBUG", "-all");
+    bool ok = false;
+    if (spec.type == PrefixSpec::Type::Proton) {
+        env.insert("STEAM_COMPAT_DATA_PATH", staging);
+        env.insert("STEAM_COMPAT_CLIENT_INSTALL_PATH", QDir::homePath() + "/.steam/steam");
+        ok = runStep(spec.runnerExecutable, {"run", "wineboot", "--init"}, env);
+        env.insert("WINEPREFIX", staging + "/pfx");
+    } else {
+        env.insert("WINEPREFIX", staging);
+        ok = runStep(spec.runnerExecutable, {"wineboot", "--init"}, env);
+    }
+
+    // wineboot returns before the registry is written out; wineserver -w waits for that
+    const QString wineserver = wineserverPath(spec);
+    if (ok && !wineserver.isEmpty()) runStep(wineserver, {"-w"}, env);
+
+    if (!ok || !isInitialised(spec.type, staging) || !QDir().rename(staging, target)) {
+        QDir(staging).removeRecursively();
+        return util::Result<QString>::error(
+            QString("Could not create prefix template with %1").arg(spec.runnerExecutable));
+    }
+
+    LOG_INFO(QString("Prefix template %1 ready in %2 ms")
+                 .arg(target)
+                 .arg(QDateTime::currentMSecsSinceEpoch() - started));
+    return util::Result<QString>::success(target);
+}
+
+util::Result<CloneStats> PrefixManager::clone(const QString &source, const QString &destination) {
+    if (!QFileInfo(source).isDir()) {
+        return util::Result<CloneStats>::error(QString("%1 is not a directory").arg(source));
+    }
+
+    // Cloned next to the destination and renamed, so nobody sees a partial prefix
+    const QString staging =
+        QString("%1.tmp-%2").arg(destination).arg(QCoreApplication::applicationPid());
+    QDir(staging).removeRecursively();
+    QDir().mkpath(QFileInfo(destination).absolutePath());
+
+    const qint64 started = QDateTime::currentMSecsSinceEpoch();
+    CloneStats stats;
+    if (!cloneTree(source, staging, stats)) {
+        QDir(staging).removeRecursively();
+        return util::Result<CloneStats>::error(QString("Could not copy %1").arg(source));
+    }
+
+    // An empty directory may already sit where the prefix goes
+    if (QFileInfo(destination).isDir()) QDir().rmdir(destination);
+    if (!QDir().rename(staging, destination)) {
+        QDir(staging).removeRecursively();
+        return util::Result<CloneStats>::error(QString("Could not create %1").arg(destination));
+    }
+
+    LOG_INFO(QString("Cloned prefix to %1 in %2 ms: %3 files, %4 reflinked, %5 MiB copied")
+                 .arg(destination)
+                 .arg(QDateTime::currentMSecsSinceEpoch() - started)
+                 .arg(stats.files)
+                 .arg(stats.reflinked)
+                 .arg(stats.bytesCopied >> 20));
+    return util::Result<CloneStats>::success(stats);
+}
+
+void PrefixManager::prewarm(const PrefixSpec &spec) {
+    if (isInitialised(spec.type, spec.path)) return;
+
+    pool_.start([this, spec]() {
+        const auto result = prepare(spec);
+        const bool success = result.isOk();
+        const QString error = success ? QString() : result.errorMessage();
+        if (!success) LOG_WARNING(QString("Prefix pre-warm failed: %1").arg(error));
+        const QString path = spec.path;
+        QMetaObject::invokeMethod(
+            this, [this, path, success, error]() { emit prefixPrepared(path, success, error); },
+            Qt::QueuedConnection);
+    });
+}
+
+} // namespace opengalaxy::runners
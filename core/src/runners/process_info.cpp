@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "process_info.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <algorithm>
+
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#ifdef Q_OS_LINUX
+#include <poll.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+namespace opengalaxy::runners {
+
+namespace {
+
+// Without pidfds the wait falls back to checking this often
+constexpr int kPollFallbackMs = 50;
+
+QByteArray readProcFile(qint64 pid, const char *name) {
+    QFile file(QString("/proc/%1/%2").arg(pid).arg(name));
+    if (!file.open(QIODevice::ReadOnly)) return {};
+    return file.readAll();
+}
+
+} // namespace
+
+// "pid (comm) state ppid ..." as in proc(5); comm may itself contain spaces and parentheses
+bool readProcessInfo(qint64 pid, ProcessInfo &info) {
+    const QByteArray line = readProcFile(pid, "stat");
+    const int open = line.indexOf('(');
+    const int close = line.lastIndexOf(')');
+    if (open < 0 || close < open) return false;
+
+    // fields[0] is field 3 (state); field n is fields[n - 3]
+    const QList<QByteArray> fields = line.mid(close + 2).split(' ');
+    if (fields.size() < 22) return false;
+
+    info.pid = pid;
+    info.comm = line.mid(open + 1, close - open - 1);
+    info.state = fields[0].isEmpty() ? 0 : fields[0][0];
+    info.ppid = fields[1].toLongLong();
+    info.cpuTicks = fields[11].toLongLong() + fields[12].toLongLong();
+    info.startTime = fields[19].toLongLong();
+    info.rssPages = fields[21].toLongLong();
+    info.nice = fields[16].toInt();
+    info.policy = fields.size() > 38 ? fields[38].toInt() : 0;
+    return true;
+}
+
+QHash<qint64, ProcessInfo> listProcesses() {
+    QHash<qint64, ProcessInfo> processes;
+    const QStringList entries = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &entry : entries) {
+        bool ok = false;
+        const qint64 pid = entry.toLongLong(&ok);
+        ProcessInfo info;
+        if (ok && readProcessInfo(pid, info)) processes.insert(pid, info);
+    }
+    return processes;
+}
+
+QStringList processCommandLine(qint64 pid) {
+    QStringList args;
+    for (const QByteArray &arg : readProcFile(pid, "cmdline").split('\0')) {
+        if (!arg.isEmpty()) args << QString::fromLocal8Bit(arg);
+    }
+    return args;
+}
+
+// Empty for other users' processes, whose environment is not readable
+QByteArray processEnvironmentValue(qint64 pid, const QByteArray &name) {
+    const QByteArray prefix = name + '=';
+    for (const QByteArray &variable : readProcFile(pid, "environ").split('\0')) {
+        if (variable.startsWith(prefix)) return variable.mid(prefix.size());
+    }
+    return {};
+}
+
+bool isOwnProcess(qint64 pid) {
+    const QFileInfo dir(QString("/proc/%1").arg(pid));
+    return dir.exists() && dir.ownerId() == ::getuid();
+}
+
+QString processCgroup(qint64 pid) {
+    for (const QByteArray &line : readProcFile(pid, "cgroup").split('\n')) {
+        if (line.startsWith("0::")) return QString::fromUtf8(line.mid(3));
+    }
+    return {};
+}
+
+QList<int> processAffinity(qint64 pid) {
+    QList<int> cpus;
+#ifdef Q_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(static_cast<pid_t>(pid), sizeof(set), &set) != 0) return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) cpus << cpu;
+    }
+#else
+    Q_UNUSED(pid);
+#endif
+    return cpus;
+}
+
+qint64 processUptimeSeconds(const ProcessInfo &info) {
+    static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+    QFile file("/proc/uptime");
+    if (!file.open(QIODevice::ReadOnly)) return -1;
+
+    // First field: seconds since boot
+    bool ok = false;
+    const double bootSeconds = file.readAll().split(' ').value(0).toDouble(&ok);
+    if (!ok || ticksPerSecond <= 0) return -1;
+    return std::max<qint64>(0, static_cast<qint64>(bootSeconds) - info.startTime / ticksPerSecond);
+}
+
+bool isProcessAlive(qint64 pid) {
+    ProcessInfo info;
+    if (readProcessInfo(pid, info)) return info.isAlive();
+    if (QFileInfo::exists("/proc/self")) return false;
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
+int openPidfd(qint64 pid) {
+#if defined(Q_OS_LINUX) && defined(SYS_pidfd_open)
+    return static_cast<int>(syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+#else
+    Q_UNUSED(pid);
+    return -1;
+#endif
+}
+
+bool signalProcess(const ProcessHandle &process, int signal) {
+#if defined(Q_OS_LINUX) && defined(SYS_pidfd_send_signal)
+    if (process.pidfd >= 0) {
+        return syscall(SYS_pidfd_send_signal, process.pidfd, signal, nullptr, 0) == 0;
+    }
+#endif
+    return ::kill(static_cast<pid_t>(process.pid), signal) == 0;
+}
+
+std::vector<qint64> waitForExit(const std::vector<ProcessHandle> &processes, int timeoutMs) {
+    std::vector<ProcessHandle> pending = processes;
+    QElapsedTimer timer;
+    timer.start();
+
+    while (true) {
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                     [](const auto &p) { return !isProcessAlive(p.pid); }),
+                      pending.end());
+        const qint64 remaining = timeoutMs - timer.elapsed();
+        if (pending.empty() || remaining <= 0) break;
+
+        const bool allHavePidfds = std::all_of(pending.begin(), pending.end(),
+                                               [](const auto &p) { return p.pidfd >= 0; });
+        const int waitMs = static_cast<int>(
+            allHavePidfds ? remaining : std::min<qint64>(remaining, kPollFallbackMs));
+#ifdef Q_OS_LINUX
+        // A pidfd turns readable when its process exits
+        std::vector<pollfd> fds;
+        for (const auto &p : pending) {
+            if (p.pidfd >= 0) fds.push_back({p.pidfd, POLLIN, 0});
+        }
+        if (!fds.empty()) {
+            ::poll(fds.data(), fds.size(), waitMs);
+            continue;
+        }
+#endif
+        QThread::msleep(waitMs);
+    }
+
+    std::vector<qint64> alive;
+    for (const auto &p : pending) {
+        alive.push_back(p.pid);
+    }
+    return alive;
+}
+
+} // namespace opengalaxy::runners
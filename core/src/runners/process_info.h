@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QtGlobal>
+#include <vector>
+
+namespace opengalaxy::runners {
+
+// One line of /proc/<pid>/stat
+struct ProcessInfo {
+    qint64 pid = 0;
+    qint64 ppid = 0;
+    QByteArray comm; // Truncated to 15 characters by the kernel
+    char state = 0;
+    qint64 cpuTicks = 0;  // utime + stime
+    qint64 startTime = 0; // Clock ticks after boot
+    qint64 rssPages = 0;
+    int nice = 0;
+    int policy = 0; // SCHED_* scheduling policy
+
+    bool isAlive() const { return state != 'Z' && state != 'X'; }
+};
+
+// A process to wait on; pidfd is -1 where the kernel has no pidfd_open
+struct ProcessHandle {
+    qint64 pid = 0;
+    int pidfd = -1;
+};
+
+// All of these read /proc and fail (false, empty) on systems without it
+bool readProcessInfo(qint64 pid, ProcessInfo &info);
+QHash<qint64, ProcessInfo> listProcesses();
+QStringList processCommandLine(qint64 pid);
+QByteArray processEnvironmentValue(qint64 pid, const QByteArray &name);
+bool isOwnProcess(qint64 pid);
+// cgroup v2 path ("/user.slice/..."); empty on v1-only hierarchies
+QString processCgroup(qint64 pid);
+// CPUs the process may run on; empty where the kernel does not tell
+QList<int> processAffinity(qint64 pid);
+qint64 processUptimeSeconds(const ProcessInfo &info);
+
+// Not a zombie; falls back to kill(pid, 0) without /proc
+bool isProcessAlive(qint64 pid);
+
+int openPidfd(qint64 pid);
+// Through the pidfd when there is one, so a recycled pid is never hit
+bool signalProcess(const ProcessHandle &process, int signal);
+
+// Blocks until every process has exited or timeoutMs passed, sleeping in poll()
+// on the pidfds. Returns the pids still alive.
+std::vector<qint64> waitForExit(const std::vector<ProcessHandle> &processes, int timeoutMs);
+
+} // namespace opengalaxy::runners
@@ -25,18 +25,21 @@ static void scanCompatToolsDir(const QString &dirPath, std::vector<ProtonInstall
     }
 }
 
-std::vector<ProtonInstall> discoverProtonGE() {
-    std::vector<ProtonInstall> installs;
-
-    // Standard Steam locations
-    scanCompatToolsDir(QDir::home().filePath(".steam/root/compatibilitytools.d"), installs);
-    scanCompatToolsDir(QDir::home().filePath(".local/share/Steam/compatibilitytools.d"), installs);
-
-    // Flatpak Steam
-    scanCompatToolsDir(
+QStringList compatToolsDirs() {
+    return {
+        // Standard Steam locations
+        QDir::home().filePath(".steam/root/compatibilitytools.d"),
+        QDir::home().filePath(".local/share/Steam/compatibilitytools.d"),
+        // Flatpak Steam
         QDir::home().filePath(".var/app/com.valvesoftware.Steam/data/Steam/compatibilitytools.d"),
-        installs);
+    };
+}
 
+std::vector<ProtonInstall> discoverProtonGE() {
+    std::vector<ProtonInstall> installs;
+    for (const QString &dir : compatToolsDirs()) {
+        scanCompatToolsDir(dir, installs);
+    }
     return installs;
 }
 
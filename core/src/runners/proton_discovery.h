@@ -12,6 +12,9 @@ struct ProtonInstall {
     QString protonDir; // directory that contains the 'proton' script
 };
 
+// Steam compatibility tool directories that are searched (native and Flatpak Steam)
+QStringList compatToolsDirs();
+
 std::vector<ProtonInstall> discoverProtonGE();
 
 } // namespace opengalaxy::runners
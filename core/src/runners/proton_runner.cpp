@@ -1,10 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "proton_runner.h"
+#include "opengalaxy/runners/prefix_manager.h"
+#include "opengalaxy/runners/resource_profile.h"
+#include "opengalaxy/runners/shader_cache.h"
+#include "opengalaxy/runners/wineserver_keepalive.h"
 #include "opengalaxy/util/log.h"
 
 #include <QDir>
 #include <QFileInfo>
-#include <QProcessEnvironment>
 
 namespace opengalaxy::runners {
 
@@ -39,29 +42,16 @@ bool ProtonRunner::canRun(const LaunchConfig &config) const {
 std::unique_ptr<QProcess> ProtonRunner::launch(const LaunchConfig &config) {
     auto process = std::make_unique<QProcess>();
 
-    // Merge env
-    QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
-    for (auto it = config.environment.begin(); it != config.environment.end(); ++it) {
-        env << (it.key() + "=" + it.value());
+    // A template clone is much quicker than letting proton build a new prefix
+    const PrefixSpec spec = *prefix(config);
+    PrefixManager::cloneTemplate(spec);
+    if (const auto serverEnv = serverEnvironment(config)) {
+        WineserverKeepAlive::acquire(spec, *serverEnv);
     }
-
-    // Required for non-Steam Proton usage: compat data path provides a prefix location.
-    // If user did not specify one, we fallback to workingDirectory/.opengalaxy-proton-prefix
-    QString compatPath;
-    for (const QString &e : env) {
-        if (e.startsWith("STEAM_COMPAT_DATA_PATH=")) {
-            compatPath = e.mid(QString("STEAM_COMPAT_DATA_PATH=").size());
-            break;
-        }
-    }
-    if (compatPath.isEmpty()) {
-        compatPath = QDir(config.workingDirectory).filePath(".opengalaxy-proton-prefix");
-        env << ("STEAM_COMPAT_DATA_PATH=" + compatPath);
-    }
-
-    process->setEnvironment(env);
+    ShaderCache::markUsed(config.gameId);
 
     process->setProgram(protonScriptPath_());
+    environment(config).applyTo(*process);
     QStringList args;
     args << "run";
     args << config.gamePath;
@@ -69,6 +59,7 @@ std::unique_ptr<QProcess> ProtonRunner::launch(const LaunchConfig &config) {
     process->setArguments(args);
     process->setWorkingDirectory(config.workingDirectory);
 
+    ResourceProfile::applyTo(*process, config.profile, config.gameMode);
     process->start();
 
     if (!process->waitForStarted(3000)) {
@@ -80,4 +71,70 @@ std::unique_ptr<QProcess> ProtonRunner::launch(const LaunchConfig &config) {
     return process;
 }
 
+LaunchEnvironment ProtonRunner::environment(const LaunchConfig &config) const {
+    LaunchEnvironment env = Runner::environment(config);
+
+    // Required for non-Steam Proton usage: compat data path provides a prefix location
+    env.insert(LaunchEnvironment::Layer::Runner, "STEAM_COMPAT_DATA_PATH", prefix(config)->path);
+    ShaderCache::applyTo(env, config.gameId, PrefixSpec::Type::Proton);
+    return env;
+}
+
+std::optional<QProcessEnvironment>
+ProtonRunner::serverEnvironment(const LaunchConfig &config) const {
+    // Settings in user_settings.py are only known by running it
+    if (QFileInfo::exists(QDir(protonDir_).filePath("user_settings.py"))) return std::nullopt;
+
+    QProcessEnvironment env = environment(config).toProcessEnvironment();
+
+    // As the proton script reads its options: a PROTON_* variable, when set,
+    // overrides PROTON_CONFIG, and only an empty value or "0" turns it off
+    QStringList compatConfig;
+    for (const QString &option : env.value("PROTON_CONFIG").split(',', Qt::SkipEmptyParts)) {
+        compatConfig << option.trimmed();
+    }
+    const auto enabled = [&env, &compatConfig](const QString &variable, const QString &option) {
+        if (!env.contains(variable)) return compatConfig.contains(option);
+        const QString value = env.value(variable);
+        return !value.isEmpty() && value != "0";
+    };
+
+    // NTSync replaces the server's own synchronisation; not mirrored here
+    if (enabled("PROTON_USE_NTSYNC", "ntsync")) return std::nullopt;
+
+    // The script turns esync and fsync on for the game unless told not to
+    const auto setSync = [&](const QString &sync, const QString &variable, const QString &option) {
+        if (enabled(variable, option)) {
+            env.remove(sync);
+        } else {
+            env.insert(sync, "1");
+        }
+    };
+    setSync("WINEESYNC", "PROTON_NO_ESYNC", "noesync");
+    setSync("WINEFSYNC", "PROTON_NO_FSYNC", "nofsync");
+    return env;
+}
+
+std::optional<PrefixSpec> ProtonRunner::prefix(const LaunchConfig &config) const {
+    PrefixSpec spec;
+    spec.type = PrefixSpec::Type::Proton;
+    spec.runnerExecutable = protonScriptPath_();
+
+    // Explicit setting, then the prefix the game was installed into, then the one
+    // shared by the games next to its install directory. Keyed on the install path
+    // rather than the working directory, which differs between a game's executables.
+    spec.path = config.environment.value("STEAM_COMPAT_DATA_PATH",
+                                         qEnvironmentVariable("STEAM_COMPAT_DATA_PATH"));
+    if (spec.path.isEmpty()) {
+        spec.path = PrefixManager::containingPrefix(spec.type, config.gamePath);
+    }
+    if (spec.path.isEmpty()) {
+        const QString parent = config.installPath.isEmpty()
+                                   ? config.workingDirectory
+                                   : QFileInfo(config.installPath).absolutePath();
+        spec.path = QDir(parent).filePath(".opengalaxy-proton-prefix");
+    }
+    return spec;
+}
+
 } // namespace opengalaxy::runners
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "opengalaxy/runners/runner.h"
+#include <QProcessEnvironment>
+#include <optional>
 
 namespace opengalaxy::runners {
 
@@ -16,6 +18,12 @@ class ProtonRunner : public Runner {
 
     bool canRun(const LaunchConfig &config) const override;
     std::unique_ptr<QProcess> launch(const LaunchConfig &config) override;
+    LaunchEnvironment environment(const LaunchConfig &config) const override;
+    std::optional<PrefixSpec> prefix(const LaunchConfig &config) const override;
+
+    // Environment the proton script will give the game, for starting its
+    // wineserver ahead of it; nullopt when that cannot be predicted
+    std::optional<QProcessEnvironment> serverEnvironment(const LaunchConfig &config) const;
 
   private:
     QString runnerName_;
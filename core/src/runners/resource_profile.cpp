@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/resource_profile.h"
+#include "opengalaxy/util/log.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMap>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace opengalaxy::runners {
+
+namespace {
+
+// Not in glibc's headers: linux/ioprio.h, and SCHED_ISO from the MuQSS/-ck
+// patches, which mainline reserves and rejects
+constexpr int kIoprioWhoProcess = 1;
+constexpr int kIoprioClassShift = 13;
+constexpr int kSchedIso = 4;
+
+constexpr int kMaxCpus = 1024; // CPU_SETSIZE
+
+QString readSysFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return {};
+    return QString::fromLatin1(file.readAll()).trimmed();
+}
+
+// The scope is created through the user's systemd instance; without one
+// (no systemd, or no session bus) systemd-run fails and would take the game with it
+QString systemdRun() {
+    static const QString path = []() -> QString {
+        const QString systemdRun = QStandardPaths::findExecutable("systemd-run");
+        if (systemdRun.isEmpty()) return {};
+        QProcess probe;
+        probe.start(systemdRun, {"--user", "--scope", "--quiet", "--collect", "true"});
+        if (!probe.waitForFinished(5000)) {
+            probe.kill();
+            probe.waitForFinished(1000);
+            return {};
+        }
+        return probe.exitStatus() == QProcess::NormalExit && probe.exitCode() == 0 ? systemdRun
+                                                                                    : QString();
+    }();
+    return path;
+}
+
+} // namespace
+
+std::vector<ResourceProfile::CpuGroup> ResourceProfile::cpuGroups() {
+    std::vector<CpuGroup> groups;
+
+    // Intel hybrid parts expose each core type as its own PMU
+    const QString performance = readSysFile("/sys/devices/cpu_core/cpus");
+    const QString efficiency = readSysFile("/sys/devices/cpu_atom/cpus");
+    if (!performance.isEmpty() && !efficiency.isEmpty()) {
+        groups.push_back({"Performance cores", performance});
+        groups.push_back({"Efficiency cores", efficiency});
+    }
+
+    // CPUs sharing an L3 cache: one per CCD on multi-CCD Ryzen and EPYC
+    QMap<int, std::pair<QString, QString>> domains; // first CPU -> list, cache size
+    const QDir cpuDir("/sys/devices/system/cpu");
+    const QStringList cpus = cpuDir.entryList({"cpu[0-9]*"}, QDir::Dirs);
+    for (const QString &cpu : cpus) {
+        for (int index = 0; index < 8; ++index) {
+            const QString cache = cpuDir.filePath(QString("%1/cache/index%2").arg(cpu).arg(index));
+            if (!QFile::exists(cache)) break;
+            if (readSysFile(cache + "/level") != "3") continue;
+
+            const QString shared = readSysFile(cache + "/shared_cpu_list");
+            const QList<int> members = parseCpuList(shared);
+            if (!members.isEmpty()) {
+                domains.insert(members.first(), {shared, readSysFile(cache + "/size")});
+            }
+            break;
+        }
+    }
+    if (domains.size() > 1) {
+        int n = 0;
+        for (const auto &[list, size] : std::as_const(domains)) {
+            groups.push_back({QString("CCD %1 (%2 L3)").arg(n++).arg(size), list});
+        }
+    }
+    return groups;
+}
+
+QList<int> ResourceProfile::parseCpuList(const QString &list) {
+    QList<int> cpus;
+    for (const QString &part : list.split(',', Qt::SkipEmptyParts)) {
+        const QStringList bounds = part.trimmed().split('-');
+        bool firstOk = false;
+        bool lastOk = bounds.size() == 1;
+        const int first = bounds.first().toInt(&firstOk);
+        const int last = bounds.size() == 2 ? bounds.last().toInt(&lastOk) : first;
+        if (!firstOk || !lastOk || bounds.size() > 2 || first < 0 || last < first ||
+            last >= kMaxCpus) {
+            return {};
+        }
+        for (int cpu = first; cpu <= last; ++cpu) cpus << cpu;
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+QString ResourceProfile::formatCpuList(QList<int> cpus) {
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+    QStringList ranges;
+    for (qsizetype i = 0; i < cpus.size();) {
+        qsizetype j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        ranges << (i == j ? QString::number(cpus[i])
+                          : QString("%1-%2").arg(cpus[i]).arg(cpus[j]));
+        i = j + 1;
+    }
+    return ranges.join(',');
+}
+
+QString ResourceProfile::validate(const api::LaunchProfile &profile) {
+    if (!profile.cpuAffinity.trimmed().isEmpty() && parseCpuList(profile.cpuAffinity).isEmpty()) {
+        return QString("Invalid CPU list '%1' (expected e.g. 0-7,16-23)").arg(profile.cpuAffinity);
+    }
+    if (profile.niceLevel < -20 || profile.niceLevel > 19) {
+        return "Nice level must be between -20 and 19";
+    }
+    if (profile.ioClass < 0 || profile.ioClass > 3 || profile.ioLevel < 0 || profile.ioLevel > 7) {
+        return "I/O priority must be a class from 0 to 3 and a level from 0 to 7";
+    }
+    if (profile.cpuQuotaPercent < 0) {
+        return "CPU quota cannot be negative";
+    }
+
+    // What systemd accepts for these; anything else would make systemd-run fail the launch
+    static const QRegularExpression memory(R"(^(\d+[KMGT]?|\d{1,3}%|infinity)$)");
+    if (!profile.memoryMax.isEmpty() && !memory.match(profile.memoryMax).hasMatch()) {
+        return QString("Invalid memory limit '%1' (expected e.g. 8G or 50%)")
+            .arg(profile.memoryMax);
+    }
+    static const QRegularExpression slice(R"(^[A-Za-z0-9:_.-]+\.slice$)");
+    if (!profile.slice.isEmpty() && !slice.match(profile.slice).hasMatch()) {
+        return QString("Invalid slice name '%1' (expected e.g. games.slice)").arg(profile.slice);
+    }
+    return {};
+}
+
+void ResourceProfile::applyTo(QProcess &process, const api::LaunchProfile &profile,
+                              bool gameMode) {
+    if (const QString error = validate(profile); !error.isEmpty()) {
+        LOG_WARNING(QString("Ignoring launch profile: %1").arg(error));
+        return;
+    }
+
+    QString program = process.program();
+    QStringList arguments = process.arguments();
+    QStringList applied;
+
+    bool priorities = true;
+    if (gameMode) {
+        const QString gamemoderun = QStandardPaths::findExecutable("gamemoderun");
+        if (!gamemoderun.isEmpty()) {
+            arguments.prepend(program);
+            program = gamemoderun;
+            priorities = false;
+            applied << "GameMode";
+        } else {
+            LOG_WARNING("GameMode is enabled but gamemoderun is not installed");
+        }
+    }
+
+    // Outermost, so the scope holds gamemoderun and the game alike
+    if (profile.usesCgroup()) {
+        const QString scope = systemdRun();
+        if (!scope.isEmpty()) {
+            QStringList scopeArguments = {"--user", "--scope", "--quiet", "--collect"};
+            if (!profile.slice.isEmpty()) scopeArguments << ("--slice=" + profile.slice);
+            if (!profile.memoryMax.isEmpty()) {
+                scopeArguments << "-p" << ("MemoryMax=" + profile.memoryMax);
+            }
+            if (profile.cpuQuotaPercent > 0) {
+                scopeArguments << "-p" << QString("CPUQuota=%1%").arg(profile.cpuQuotaPercent);
+            }
+            scopeArguments << "--" << program;
+            arguments = scopeArguments + arguments;
+            program = scope;
+            applied << "systemd scope";
+        } else {
+            LOG_WARNING("Resource limits need systemd-run and a systemd user session; "
+                        "launching without them");
+        }
+    }
+
+    process.setProgram(program);
+    process.setArguments(arguments);
+
+#ifdef Q_OS_LINUX
+    const QList<int> cpus = parseCpuList(profile.cpuAffinity);
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) CPU_SET(cpu, &cpuSet);
+
+    const bool pin = !cpus.isEmpty();
+    const int nice = priorities ? profile.niceLevel : 0;
+    const int ioprio = priorities && profile.ioClass > 0
+                           ? (profile.ioClass << kIoprioClassShift) | profile.ioLevel
+                           : 0;
+    const bool iso = priorities && profile.schedIso;
+    if (!pin && nice == 0 && ioprio == 0 && !iso) {
+        if (!applied.isEmpty()) LOG_INFO(QString("Launching under %1").arg(applied.join(", ")));
+        return;
+    }
+
+    if (pin) applied << ("CPUs " + formatCpuList(cpus));
+    if (nice != 0) applied << QString("nice %1").arg(nice);
+    if (ioprio != 0) applied << QString("I/O %1/%2").arg(profile.ioClass).arg(profile.ioLevel);
+    if (iso) applied << "SCHED_ISO";
+    LOG_INFO(QString("Launching under %1").arg(applied.join(", ")));
+
+    // Runs in the forked child: plain system calls only, failures leave the default
+    process.setChildProcessModifier([cpuSet, pin, nice, ioprio, iso]() {
+        if (pin) sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+        if (nice != 0) setpriority(PRIO_PROCESS, 0, nice);
+        if (ioprio != 0) syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, ioprio);
+        if (iso) {
+            sched_param param{};
+            sched_setscheduler(0, kSchedIso, &param);
+        }
+    });
+#else
+    if (!applied.isEmpty()) LOG_INFO(QString("Launching under %1").arg(applied.join(", ")));
+#endif
+}
+
+} // namespace opengalaxy::runners
@@ -2,18 +2,17 @@
 #include "opengalaxy/runners/runner_manager.h"
 #include "opengalaxy/util/log.h"
 
+#include "opengalaxy/runners/binary_info.h"
 #include "opengalaxy/runners/dosbox_runner.h"
-#include "proton_discovery.h"
+#include "opengalaxy/runners/resource_profile.h"
+#include "opengalaxy/runners/runner_registry.h"
+#include "opengalaxy/runners/wineserver_keepalive.h"
 #include "proton_runner.h"
 #include "wine_runner.h"
 #include "wrapper_runner.h"
 
-#include <QDir>
-#include <QFileInfo>
 #include <QProcess>
-#include <QProcessEnvironment>
-#include <QStandardPaths>
-#include <QSysInfo>
+#include <algorithm>
 
 namespace opengalaxy::runners {
 
@@ -41,43 +40,6 @@ static QString architectureToString(Architecture arch) {
     }
 }
 
-// Helper to detect host architecture
-static Architecture hostArchitecture() {
-    const QString arch = QSysInfo::currentCpuArchitecture().toLower();
-
-    // x86 family
-    if (arch == "x86_64" || arch == "amd64") return Architecture::X86_64;
-    if (arch == "i386" || arch == "i686" || arch == "x86") return Architecture::X86;
-
-    // ARM family
-    if (arch == "arm64" || arch == "aarch64") return Architecture::ARM64;
-    if (arch.startsWith("arm")) return Architecture::ARM;
-
-    // RISC-V
-    if (arch == "riscv64" || arch == "riscv") return Architecture::RISCV64;
-
-    // PowerPC
-    if (arch == "ppc64" || arch == "ppc64le" || arch == "powerpc64" || arch == "powerpc64le")
-        return Architecture::PPC64;
-
-    // MIPS
-    if (arch == "mips64" || arch == "mips64el") return Architecture::MIPS64;
-
-    // LoongArch
-    if (arch == "loongarch64") return Architecture::LoongArch64;
-
-    return Architecture::Unknown;
-}
-
-// Helper to find executable in PATH
-static QString findExe(const QStringList &names) {
-    for (const auto &n : names) {
-        const QString p = QStandardPaths::findExecutable(n);
-        if (!p.isEmpty()) return p;
-    }
-    return {};
-}
-
 // Simple native runner implementation
 class NativeRunner : public Runner {
   public:
@@ -106,13 +68,9 @@ class NativeRunner : public Runner {
         process->setProgram(config.gamePath);
         process->setArguments(config.arguments);
         process->setWorkingDirectory(config.workingDirectory);
+        environment(config).applyTo(*process);
 
-        QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
-        for (auto it = config.environment.begin(); it != config.environment.end(); ++it) {
-            env << (it.key() + "=" + it.value());
-        }
-        process->setEnvironment(env);
-
+        ResourceProfile::applyTo(*process, config.profile, config.gameMode);
         process->start();
 
         if (!process->waitForStarted(3000)) {
@@ -125,84 +83,138 @@ class NativeRunner : public Runner {
     }
 };
 
-RunnerManager::RunnerManager(QObject *parent) : QObject(parent) { discoverRunners(); }
+RunnerManager::RunnerManager(QObject *parent)
+    : QObject(parent), registryPath_(RunnerRegistry::defaultPath()) {
+    registerRunner(std::make_unique<NativeRunner>());
+
+    // Last run's result is good enough to start with; a stat per runner weeds out
+    // anything that was removed or upgraded since
+    const auto cached = RunnerRegistry::load(registryPath_);
+    if (cached.isOk()) {
+        std::vector<RunnerRecord> current;
+        for (const auto &record : cached.value()) {
+            if (RunnerRegistry::isCurrent(record)) current.push_back(record);
+        }
+        applyRecords(current);
+        records_ = cached.value();
+        ready_ = true;
+    }
+
+    // Installing or removing a runner shows up as a change in one of these
+    rescanTimer_.setSingleShot(true);
+    rescanTimer_.setInterval(1000);
+    connect(&rescanTimer_, &QTimer::timeout, this, &RunnerManager::refreshRunners);
+    connect(&watcher_, &QFileSystemWatcher::directoryChanged, &rescanTimer_,
+            qOverload<>(&QTimer::start));
+    watchDirectories();
+
+    scanPool_.setMaxThreadCount(1);
+    refreshRunners();
+}
+
+RunnerManager::~RunnerManager() {
+    // The scan posts its result back to this object
+    scanPool_.waitForDone();
+
+    // Kept-alive servers would otherwise linger for their whole idle timeout
+    if (stopIdleWineservers_) WineserverKeepAlive::shutdownIdle();
+}
 
-RunnerManager::~RunnerManager() = default;
 void RunnerManager::discoverRunners() {
     LOG_INFO("Discovering runners...");
+    updateRecords(RunnerRegistry::scan(records_));
+}
 
-    // Always add native runner
-    registerRunner(std::make_unique<NativeRunner>());
-
-#ifdef Q_OS_LINUX
-    // DOS compatibility (all platforms)
-    const QString dosbox = findExe({"dosbox", "dosbox-x"});
-    if (!dosbox.isEmpty()) {
-        LOG_INFO(QString("Found DOSBox: %1").arg(dosbox));
-        registerRunner(std::make_unique<DOSBoxRunner>(dosbox));
+void RunnerManager::refreshRunners() {
+    if (scanning_) {
+        rescanQueued_ = true;
+        return;
     }
+    scanning_ = true;
+
+    scanPool_.start([this, previous = records_]() {
+        auto records = RunnerRegistry::scan(previous);
+        QMetaObject::invokeMethod(
+            this, [this, records = std::move(records)]() { onScanFinished(records); },
+            Qt::QueuedConnection);
+    });
+}
 
-    // Windows compatibility on Linux
-    const QString wine = findExe({"wine", "wine64"});
-    if (!wine.isEmpty()) {
-        registerRunner(std::make_unique<WineRunner>(wine));
-    }
+void RunnerManager::onScanFinished(const std::vector<RunnerRecord> &records) {
+    scanning_ = false;
+    updateRecords(records);
 
-    // Proton-GE (Steam compatibility tools)
-    for (const auto &p : discoverProtonGE()) {
-        registerRunner(std::make_unique<ProtonRunner>(p.name, p.protonDir));
+    if (rescanQueued_) {
+        rescanQueued_ = false;
+        refreshRunners();
     }
+}
 
-    // ISA translators / wrappers (register only on ARM64 hosts for x86_64 translation)
-    const Architecture hostArch = hostArchitecture();
-    if (hostArch == Architecture::ARM64) {
-        LOG_INFO("ARM64 host detected, discovering ISA translators...");
+void RunnerManager::updateRecords(const std::vector<RunnerRecord> &records) {
+    applyRecords(records);
+    ready_ = true;
 
-        const QString box64 = findExe({"box64"});
-        if (!box64.isEmpty()) {
-            LOG_INFO(QString("Found Box64: %1").arg(box64));
-            registerRunner(std::make_unique<WrapperRunner>(
-                "Box64", box64, Platform::Linux, Architecture::ARM64, Architecture::X86_64, true));
-        }
+    if (records != records_) {
+        records_ = records;
+        const auto saved = RunnerRegistry::save(registryPath_, records_);
+        if (!saved.isOk()) LOG_WARNING(saved.errorMessage());
+    }
+    watchDirectories(); // PATH entries may have appeared since
 
-        const QString fex = findExe({"FEXInterpreter", "FEXLoader"});
-        if (!fex.isEmpty()) {
-            LOG_INFO(QString("Found FEX-Emu: %1").arg(fex));
-            registerRunner(std::make_unique<WrapperRunner>(
-                "FEX", fex, Platform::Linux, Architecture::ARM64, Architecture::X86_64, true));
-        }
+    emit runnersDiscovered(static_cast<int>(runners_.size()));
+}
 
-        const QString qemu = findExe({"qemu-x86_64", "qemu-x86_64-static"});
-        if (!qemu.isEmpty()) {
-            LOG_INFO(QString("Found QEMU: %1").arg(qemu));
-            registerRunner(std::make_unique<WrapperRunner>(
-                "QEMU", qemu, Platform::Linux, Architecture::ARM64, Architecture::X86_64, true));
-        }
+void RunnerManager::watchDirectories() {
+    const QStringList dirs = RunnerRegistry::watchedDirectories();
+    const QStringList watched = watcher_.directories();
+    for (const QString &dir : dirs) {
+        if (!watched.contains(dir)) watcher_.addPath(dir);
+    }
+}
+
+std::unique_ptr<Runner> RunnerManager::createRunner(const RunnerRecord &record) {
+    if (record.kind == "dosbox") return std::make_unique<DOSBoxRunner>(record.path, record.version);
+    if (record.kind == "wine") return std::make_unique<WineRunner>(record.path);
+    if (record.kind == "proton") return std::make_unique<ProtonRunner>(record.name, record.path);
+    if (record.kind == "box64" || record.kind == "fex" || record.kind == "qemu") {
+        return std::make_unique<WrapperRunner>(record.name, record.path, Platform::Linux,
+                                               Architecture::ARM64, Architecture::X86_64, true);
     }
-#endif
-
-#ifdef Q_OS_MACOS
-    // DOS compatibility (all platforms)
-    const QString dosbox = findExe({"dosbox", "dosbox-x"});
-    if (!dosbox.isEmpty()) {
-        LOG_INFO(QString("Found DOSBox: %1").arg(dosbox));
-        registerRunner(std::make_unique<DOSBoxRunner>(dosbox));
+    if (record.kind == "rosetta2") {
+        return std::make_unique<WrapperRunner>(record.name, record.path, Platform::MacOS,
+                                               Architecture::ARM64, Architecture::X86_64, true);
     }
+    LOG_WARNING(QString("Unknown runner kind in registry: %1").arg(record.kind));
+    return nullptr;
+}
 
-    // Rosetta 2 on Apple Silicon (ARM64 only)
-    const Architecture hostArch = hostArchitecture();
-    if (hostArch == Architecture::ARM64) {
-        const QString arch = findExe({"arch"});
-        if (!arch.isEmpty()) {
-            LOG_INFO(QString("Found Rosetta2 (via arch): %1").arg(arch));
-            registerRunner(std::make_unique<WrapperRunner>("Rosetta2", arch, Platform::MacOS,
-                                                           Architecture::ARM64,
-                                                           Architecture::X86_64, true));
+void RunnerManager::applyRecords(const std::vector<RunnerRecord> &records) {
+    // Runners that are still there keep their object, so pointers handed out stay valid
+    std::vector<RunnerRecord> kept;
+    for (auto it = discovered_.begin(); it != discovered_.end();) {
+        if (std::find(records.begin(), records.end(), it->first) != records.end()) {
+            kept.push_back(it->first);
+            ++it;
+            continue;
         }
+
+        Runner *runner = it->second;
+        const QString name = runner->name();
+        runners_.erase(std::remove_if(runners_.begin(), runners_.end(),
+                                      [runner](const auto &r) { return r.get() == runner; }),
+                       runners_.end());
+        it = discovered_.erase(it);
+        LOG_INFO(QString("Runner removed: %1").arg(name));
+        emit runnerRemoved(name);
     }
-#endif
 
-    emit runnersDiscovered(static_cast<int>(runners_.size()));
+    for (const auto &record : records) {
+        if (std::find(kept.begin(), kept.end(), record) != kept.end()) continue;
+        auto runner = createRunner(record);
+        if (!runner) continue;
+        discovered_.emplace_back(record, runner.get());
+        registerRunner(std::move(runner));
+    }
 }
 
 std::vector<RunnerCapabilities> RunnerManager::availableRunners() const {
@@ -217,6 +229,13 @@ Runner *RunnerManager::findBestRunner(const LaunchConfig &config) {
     Runner *best = nullptr;
     int bestScore = -1000000;
 
+    // Cached by path and mtime, so callers that already detected the architecture pay one stat()
+    const BinaryInfo binary = BinaryInspector::inspect(config.gamePath);
+    const Architecture gameArch =
+        config.gameArch != Architecture::Unknown ? config.gameArch : binary.arch;
+    const bool usesDirect3D =
+        binary.usesDirect3D9() || binary.usesDirect3D11() || binary.usesDirect3D12();
+
     for (const auto &runner : runners_) {
         if (!runner->isAvailable()) continue;
         if (!runner->canRun(config)) continue;
@@ -230,8 +249,8 @@ Runner *RunnerManager::findBestRunner(const LaunchConfig &config) {
         }
 
         // If the game arch is known, prefer exact target arch match
-        if (config.gameArch != Architecture::Unknown) {
-            if (caps.targetArch == config.gameArch) {
+        if (gameArch != Architecture::Unknown) {
+            if (caps.targetArch == gameArch) {
                 score += 50;
             } else {
                 // Penalize non-matching target arch
@@ -239,11 +258,11 @@ Runner *RunnerManager::findBestRunner(const LaunchConfig &config) {
             }
 
             // Prefer not translating when unnecessary (native execution)
-            if (!caps.requiresISATranslation && caps.hostArch == config.gameArch) {
+            if (!caps.requiresISATranslation && caps.hostArch == gameArch) {
                 score += 10;
             }
             // Slight penalty for translation when not needed
-            if (caps.requiresISATranslation && caps.hostArch == config.gameArch) {
+            if (caps.requiresISATranslation && caps.hostArch == gameArch) {
                 score -= 10;
             }
         }
@@ -256,6 +275,8 @@ Runner *RunnerManager::findBestRunner(const LaunchConfig &config) {
         // Prefer Proton over Wine for Windows games (better compatibility)
         if (config.gamePlatform == Platform::Windows) {
             if (caps.name.contains("Proton")) score += 5;
+            // Proton ships DXVK/VKD3D; plain Wine falls back to its slower OpenGL path
+            if (usesDirect3D && caps.name.contains("Proton")) score += 5;
         }
 
         if (score > bestScore) {
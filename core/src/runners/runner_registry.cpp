@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/runner_registry.h"
+#include "opengalaxy/runners/dosbox_runner.h"
+#include "opengalaxy/util/log.h"
+#include "proton_discovery.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <optional>
+
+namespace opengalaxy::runners {
+
+namespace {
+constexpr int kFormatVersion = 1;
+
+Architecture hostArchitecture() {
+    const QString arch = QSysInfo::currentCpuArchitecture().toLower();
+    if (arch == "arm64" || arch == "aarch64") return Architecture::ARM64;
+    if (arch == "x86_64" || arch == "amd64") return Architecture::X86_64;
+    return Architecture::Unknown; // Only ARM64 hosts change what is discovered
+}
+
+// First of names found in PATH
+QString findExe(const QStringList &names) {
+    for (const auto &n : names) {
+        const QString p = QStandardPaths::findExecutable(n);
+        if (!p.isEmpty()) return p;
+    }
+    return {};
+}
+
+// The file whose mtime identifies the runner's installed version
+QString stampFile(const QString &kind, const QString &path) {
+    return kind == "proton" ? QDir(path).filePath("proton") : path;
+}
+
+qint64 mtimeOf(const QString &kind, const QString &path) {
+    const QFileInfo info(stampFile(kind, path));
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+RunnerRecord makeRecord(const QString &kind, const QString &name, const QString &path,
+                        const QString &version = QString()) {
+    RunnerRecord record;
+    record.kind = kind;
+    record.name = name;
+    record.path = path;
+    record.mtime = mtimeOf(kind, path);
+    record.version = version;
+    return record;
+}
+
+// Version of an unchanged binary from an earlier scan, or nothing
+std::optional<QString> knownVersion(const std::vector<RunnerRecord> &previous, const QString &kind,
+                                    const QString &path) {
+    for (const RunnerRecord &record : previous) {
+        if (record.kind == kind && record.path == path && RunnerRegistry::isCurrent(record)) {
+            return record.version;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace
+
+std::vector<RunnerRecord> RunnerRegistry::scan(const std::vector<RunnerRecord> &previous) {
+    std::vector<RunnerRecord> records;
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    // DOS compatibility (all platforms)
+    const QString dosbox = findExe({"dosbox", "dosbox-x"});
+    if (!dosbox.isEmpty()) {
+        LOG_INFO(QString("Found DOSBox: %1").arg(dosbox));
+        const auto known = knownVersion(previous, "dosbox", dosbox);
+        records.push_back(makeRecord("dosbox", "DOSBox", dosbox,
+                                     known ? *known : DOSBoxRunner::probeVersion(dosbox)));
+    }
+#endif
+
+#ifdef Q_OS_LINUX
+    // Windows compatibility on Linux
+    const QString wine = findExe({"wine", "wine64"});
+    if (!wine.isEmpty()) {
+        records.push_back(makeRecord("wine", "Wine", wine));
+    }
+
+    // Proton-GE (Steam compatibility tools)
+    for (const auto &p : discoverProtonGE()) {
+        records.push_back(makeRecord("proton", p.name, p.protonDir));
+    }
+
+    // ISA translators / wrappers (only on ARM64 hosts, for x86_64 translation)
+    if (hostArchitecture() == Architecture::ARM64) {
+        const QString box64 = findExe({"box64"});
+        if (!box64.isEmpty()) records.push_back(makeRecord("box64", "Box64", box64));
+
+        const QString fex = findExe({"FEXInterpreter", "FEXLoader"});
+        if (!fex.isEmpty()) records.push_back(makeRecord("fex", "FEX", fex));
+
+        const QString qemu = findExe({"qemu-x86_64", "qemu-x86_64-static"});
+        if (!qemu.isEmpty()) records.push_back(makeRecord("qemu", "QEMU", qemu));
+    }
+#endif
+
+#ifdef Q_OS_MACOS
+    // Rosetta 2 on Apple Silicon
+    if (hostArchitecture() == Architecture::ARM64) {
+        const QString arch = findExe({"arch"});
+        if (!arch.isEmpty()) records.push_back(makeRecord("rosetta2", "Rosetta2", arch));
+    }
+#endif
+
+    return records;
+}
+
+QStringList RunnerRegistry::watchedDirectories() {
+    QStringList dirs;
+    const QString path = qEnvironmentVariable("PATH");
+    for (const QString &dir : path.split(QDir::listSeparator(), Qt::SkipEmptyParts)) {
+        dirs << QDir::cleanPath(dir);
+    }
+#ifdef Q_OS_LINUX
+    dirs << compatToolsDirs();
+#endif
+
+    QStringList existing;
+    for (const QString &dir : dirs) {
+        if (!existing.contains(dir) && QFileInfo(dir).isDir()) existing << dir;
+    }
+    return existing;
+}
+
+bool RunnerRegistry::isCurrent(const RunnerRecord &record) {
+    return record.mtime != 0 && mtimeOf(record.kind, record.path) == record.mtime;
+}
+
+util::Result<std::vector<RunnerRecord>> RunnerRegistry::load(const QString &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return util::Result<std::vector<RunnerRecord>>::error("No runner registry");
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kFormatVersion) {
+        return util::Result<std::vector<RunnerRecord>>::error("Unsupported runner registry");
+    }
+
+    std::vector<RunnerRecord> records;
+    for (const QJsonValue &value : root.value("runners").toArray()) {
+        const QJsonObject obj = value.toObject();
+        RunnerRecord record;
+        record.kind = obj.value("kind").toString();
+        record.name = obj.value("name").toString();
+        record.path = obj.value("path").toString();
+        record.mtime = obj.value("mtime").toInteger();
+        record.version = obj.value("version").toString();
+        if (record.kind.isEmpty() || record.path.isEmpty()) continue;
+        records.push_back(record);
+    }
+    return util::Result<std::vector<RunnerRecord>>::success(std::move(records));
+}
+
+util::Result<void> RunnerRegistry::save(const QString &filePath,
+                                        const std::vector<RunnerRecord> &records) {
+    QJsonArray runners;
+    for (const auto &record : records) {
+        QJsonObject obj;
+        obj["kind"] = record.kind;
+        obj["name"] = record.name;
+        obj["path"] = record.path;
+        obj["mtime"] = record.mtime;
+        obj["version"] = record.version;
+        runners.append(obj);
+    }
+
+    QJsonObject root;
+    root["version"] = kFormatVersion;
+    root["runners"] = runners;
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath); // Readers never see a half-written registry
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0 || !file.commit()) {
+        return util::Result<void>::error(QString("Failed to write %1").arg(filePath));
+    }
+    return util::Result<void>::success();
+}
+
+QString RunnerRegistry::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/runners.json";
+}
+
+} // namespace opengalaxy::runners
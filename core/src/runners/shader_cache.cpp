@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/shader_cache.h"
+#include "opengalaxy/util/config.h"
+#include "opengalaxy/util/log.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <vector>
+
+namespace opengalaxy::runners {
+
+namespace {
+
+// Touched on every launch; its mtime orders caches for pruning
+constexpr const char *kLastUsedFile = ".last-used";
+
+struct CacheVariable {
+    const char *name;
+    const char *subdirectory;
+};
+
+// DXVK's state cache, VKD3D-Proton's pipeline cache, Mesa's (RADV, ANV, Zink)
+// and NVIDIA's shader disk caches
+constexpr CacheVariable kVariables[] = {
+    {"DXVK_STATE_CACHE_PATH", "dxvk"},
+    {"VKD3D_SHADER_CACHE_PATH", "vkd3d"},
+    {"MESA_SHADER_CACHE_DIR", "mesa"},
+    {"__GL_SHADER_DISK_CACHE_PATH", "nvidia"},
+};
+
+QString rootPath() { return util::Config::instance().shaderCacheDir(); }
+
+// Ids come from the GOG API; anything that could escape the root is refused
+bool isValidGameId(const QString &gameId) {
+    return !gameId.isEmpty() && !gameId.contains('/') && !gameId.contains('\\') &&
+           gameId != "." && gameId != "..";
+}
+
+qint64 directorySize(const QString &path) {
+    qint64 total = 0;
+    QDirIterator it(path, QDir::Files | QDir::Hidden | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        total += it.fileInfo().size();
+    }
+    return total;
+}
+
+} // namespace
+
+QString ShaderCache::path(const QString &gameId) {
+    return isValidGameId(gameId) ? rootPath() + '/' + gameId : QString();
+}
+
+void ShaderCache::applyTo(LaunchEnvironment &environment, const QString &gameId,
+                          PrefixSpec::Type type) {
+    const QString dir = path(gameId);
+    if (dir.isEmpty()) return;
+
+    const auto setDefault = [&environment](const QString &name, const QString &value) {
+        if (!environment.contains(name)) {
+            environment.insert(LaunchEnvironment::Layer::Runner, name, value);
+        }
+    };
+
+    for (const CacheVariable &variable : kVariables) {
+        setDefault(variable.name, dir + '/' + variable.subdirectory);
+    }
+
+    // The NVIDIA driver caps its cache at 128 MiB and evicts unless told not to
+    setDefault("__GL_SHADER_DISK_CACHE", "1");
+    setDefault("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP", "1");
+
+    // Proton replaces the variables above with paths below this one
+    if (type == PrefixSpec::Type::Proton) setDefault("STEAM_COMPAT_SHADER_PATH", dir);
+}
+
+void ShaderCache::markUsed(const QString &gameId) {
+    const QString dir = path(gameId);
+    if (dir.isEmpty()) return;
+
+    for (const CacheVariable &variable : kVariables) {
+        QDir().mkpath(dir + '/' + variable.subdirectory);
+    }
+    QFile marker(dir + '/' + kLastUsedFile);
+    if (marker.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        marker.write(QDateTime::currentDateTimeUtc().toString(Qt::ISODate).toUtf8());
+    }
+}
+
+qint64 ShaderCache::size(const QString &gameId) {
+    const QString dir = path(gameId);
+    return dir.isEmpty() ? 0 : directorySize(dir);
+}
+
+qint64 ShaderCache::totalSize() { return directorySize(rootPath()); }
+
+bool ShaderCache::clear(const QString &gameId) {
+    const QString dir = path(gameId);
+    return !dir.isEmpty() && QDir(dir).removeRecursively();
+}
+
+bool ShaderCache::clearAll(const QStringList &except) {
+    if (except.isEmpty()) return QDir(rootPath()).removeRecursively();
+
+    bool cleared = true;
+    const QDir root(rootPath());
+    for (const QString &gameId : root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (!except.contains(gameId)) cleared = clear(gameId) && cleared;
+    }
+    return cleared;
+}
+
+qint64 ShaderCache::prune(qint64 maxBytes, const QStringList &knownGameIds) {
+    struct Entry {
+        QString gameId;
+        qint64 size = 0;
+        qint64 lastUsed = 0;
+        bool known = false;
+    };
+
+    std::vector<Entry> entries;
+    qint64 total = 0;
+    const QDir root(rootPath());
+    for (const QString &gameId : root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString dir = root.filePath(gameId);
+        const QFileInfo marker(dir + '/' + kLastUsedFile);
+        Entry entry;
+        entry.gameId = gameId;
+        entry.size = directorySize(dir);
+        entry.lastUsed = (marker.exists() ? marker : QFileInfo(dir))
+                             .lastModified()
+                             .toMSecsSinceEpoch();
+        entry.known = knownGameIds.contains(gameId);
+        total += entry.size;
+        entries.push_back(entry);
+    }
+
+    // Games gone from the library first, then oldest first
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        if (a.known != b.known) return !a.known;
+        return a.lastUsed < b.lastUsed;
+    });
+
+    qint64 freed = 0;
+    for (const Entry &entry : entries) {
+        if (entry.known && total - freed <= maxBytes) break;
+        if (clear(entry.gameId)) freed += entry.size;
+    }
+
+    if (freed > 0) {
+        LOG_INFO(QString("Pruned shader caches: freed %1 MiB, %2 MiB left")
+                     .arg(freed >> 20)
+                     .arg((total - freed) >> 20));
+    }
+    return freed;
+}
+
+} // namespace opengalaxy::runners
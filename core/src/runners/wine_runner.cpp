@@ -1,9 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "wine_runner.h"
+#include "opengalaxy/runners/prefix_manager.h"
+#include "opengalaxy/runners/resource_profile.h"
+#include "opengalaxy/runners/shader_cache.h"
+#include "opengalaxy/runners/wineserver_keepalive.h"
 #include "opengalaxy/util/log.h"
 
+#include <QDir>
 #include <QFileInfo>
-#include <QProcessEnvironment>
 
 namespace opengalaxy::runners {
 
@@ -36,14 +40,19 @@ bool WineRunner::canRun(const LaunchConfig &config) const {
 std::unique_ptr<QProcess> WineRunner::launch(const LaunchConfig &config) {
     auto process = std::make_unique<QProcess>();
 
-    // env: start from system and append overrides
-    QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
-    for (auto it = config.environment.begin(); it != config.environment.end(); ++it) {
-        env << (it.key() + "=" + it.value());
-    }
-    process->setEnvironment(env);
+    const LaunchEnvironment env = environment(config);
+    const auto spec = prefix(config);
+    if (spec) PrefixManager::cloneTemplate(*spec);
+
+    // A server already up for the prefix saves its bootstrap on every relaunch
+    WineserverKeepAlive::acquire(
+        spec.value_or(PrefixSpec{PrefixSpec::Type::Wine, winePath_,
+                                 env.value("WINEPREFIX", QDir::homePath() + "/.wine")}),
+        env.toProcessEnvironment());
+    ShaderCache::markUsed(config.gameId);
 
     process->setProgram(winePath_);
+    env.applyTo(*process);
 
     QStringList args;
     args << config.gamePath;
@@ -52,6 +61,7 @@ std::unique_ptr<QProcess> WineRunner::launch(const LaunchConfig &config) {
     process->setArguments(args);
     process->setWorkingDirectory(config.workingDirectory);
 
+    ResourceProfile::applyTo(*process, config.profile, config.gameMode);
     process->start();
 
     if (!process->waitForStarted(3000)) {
@@ -63,4 +73,29 @@ std::unique_ptr<QProcess> WineRunner::launch(const LaunchConfig &config) {
     return process;
 }
 
+LaunchEnvironment WineRunner::environment(const LaunchConfig &config) const {
+    LaunchEnvironment env = Runner::environment(config);
+
+    // Games installed into a prefix must run in it, not in the default ~/.wine
+    if (const auto spec = prefix(config)) {
+        env.insert(LaunchEnvironment::Layer::Runner, "WINEPREFIX", spec->path);
+    }
+    ShaderCache::applyTo(env, config.gameId, PrefixSpec::Type::Wine);
+    return env;
+}
+
+std::optional<PrefixSpec> WineRunner::prefix(const LaunchConfig &config) const {
+    PrefixSpec spec;
+    spec.type = PrefixSpec::Type::Wine;
+    spec.runnerExecutable = winePath_;
+    spec.path = config.environment.value("WINEPREFIX");
+    if (spec.path.isEmpty()) {
+        spec.path = PrefixManager::containingPrefix(spec.type, config.gamePath);
+    }
+
+    // Otherwise wine uses the user's own prefix, which is not ours to create
+    if (spec.path.isEmpty()) return std::nullopt;
+    return spec;
+}
+
 } // namespace opengalaxy::runners
@@ -16,6 +16,8 @@ class WineRunner : public Runner {
 
     bool canRun(const LaunchConfig &config) const override;
     std::unique_ptr<QProcess> launch(const LaunchConfig &config) override;
+    LaunchEnvironment environment(const LaunchConfig &config) const override;
+    std::optional<PrefixSpec> prefix(const LaunchConfig &config) const override;
 
   private:
     QString winePath_;
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/wineserver_keepalive.h"
+#include "opengalaxy/runners/prefix_manager.h"
+#include "opengalaxy/util/config.h"
+#include "opengalaxy/util/log.h"
+#include "process_info.h"
+
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QSet>
+#include <algorithm>
+
+namespace opengalaxy::runners {
+
+namespace {
+
+// The server daemonizes as soon as its socket is up, so this is only a safety net
+constexpr int kServerCommandTimeoutMs = 5000;
+
+struct KeptServer {
+    QString wineserver;
+    QProcessEnvironment environment;
+};
+
+QMutex keptMutex;
+QHash<QString, KeptServer> kept; // WINEPREFIX -> server
+
+QString defaultPrefix() { return QDir::homePath() + "/.wine"; }
+
+// Wine's own background programs; they stay up as long as the server does
+bool isWineService(const QString &exe) {
+    static const QStringList services = {
+        "services.exe", "winedevice.exe", "plugplay.exe", "explorer.exe", "rpcss.exe",
+        "svchost.exe",  "conhost.exe",    "tabtip.exe",   "steam.exe",    "wineboot.exe"};
+    return services.contains(exe.toLower());
+}
+
+// File name of the Windows program a process runs, or empty for anything else.
+// Wine rewrites argv to the Windows path; during startup the preloader's argv
+// still names it further along.
+QString windowsProgram(const QStringList &args) {
+    for (int i = 0; i < std::min<int>(args.size(), 3); ++i) {
+        if (!args[i].endsWith(".exe", Qt::CaseInsensitive)) continue;
+        QString exe = args[i];
+        exe.replace('\\', '/');
+        return exe.section('/', -1);
+    }
+    return {};
+}
+
+bool runServerCommand(const KeptServer &server, const QString &prefix, const QStringList &args) {
+    QProcess process;
+    QProcessEnvironment env = server.environment;
+    env.insert("WINEPREFIX", prefix);
+    process.setProcessEnvironment(env);
+    // The daemonized server keeps these; it must not be left holding our pipes
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.setStandardErrorFile(QProcess::nullDevice());
+    process.start(server.wineserver, args);
+    if (!process.waitForFinished(kServerCommandTimeoutMs)) {
+        process.kill();
+        process.waitForFinished(1000);
+        return false;
+    }
+    return process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0;
+}
+
+} // namespace
+
+int WineserverKeepAlive::idleTimeout() { return util::Config::instance().wineserverKeepAlive(); }
+
+bool WineserverKeepAlive::acquire(const PrefixSpec &spec, const QProcessEnvironment &environment) {
+    const int timeout = idleTimeout();
+    if (timeout <= 0 || !PrefixManager::isInitialised(spec.type, spec.path)) return false;
+
+    const KeptServer server{PrefixManager::wineserverPath(spec), environment};
+    if (server.wineserver.isEmpty()) return false;
+    const QString prefix = QDir::cleanPath(PrefixManager::winePrefix(spec));
+
+    // Fails fast if a server already runs for the prefix; the game attaches to that one
+    const bool started = runServerCommand(server, prefix, {QString("-p%1").arg(timeout)});
+    LOG_DEBUG(QString("wineserver for %1 %2 (idle timeout %3 s)")
+                  .arg(prefix, started ? "started" : "already running")
+                  .arg(timeout));
+
+    QMutexLocker locker(&keptMutex);
+    kept.insert(prefix, server);
+    return true;
+}
+
+QStringList WineserverKeepAlive::activePrefixes() {
+    QMutexLocker locker(&keptMutex);
+    return kept.keys();
+}
+
+int WineserverKeepAlive::shutdownIdle() {
+    QHash<QString, KeptServer> servers;
+    {
+        QMutexLocker locker(&keptMutex);
+        servers = kept;
+    }
+    if (servers.isEmpty()) return 0;
+
+    // Without /proc nothing tells a running game apart; let the servers time out
+    const auto processes = listProcesses();
+    if (processes.isEmpty()) return 0;
+
+    QSet<QString> busy;
+    for (const ProcessInfo &info : processes) {
+        if (!info.isAlive() || !isOwnProcess(info.pid)) continue;
+        const QString exe = windowsProgram(processCommandLine(info.pid));
+        if (exe.isEmpty() || isWineService(exe)) continue;
+
+        const QByteArray prefix = processEnvironmentValue(info.pid, "WINEPREFIX");
+        busy.insert(prefix.isEmpty() ? defaultPrefix()
+                                     : QDir::cleanPath(QString::fromLocal8Bit(prefix)));
+    }
+
+    int stopped = 0;
+    for (auto it = servers.cbegin(); it != servers.cend(); ++it) {
+        if (busy.contains(it.key())) continue;
+        // -k only reaches Wine's services here, nothing of the user's
+        if (runServerCommand(it.value(), it.key(), {"-k"})) {
+            LOG_INFO(QString("Stopped idle wineserver for %1").arg(it.key()));
+            ++stopped;
+        }
+        QMutexLocker locker(&keptMutex);
+        kept.remove(it.key());
+    }
+    return stopped;
+}
+
+} // namespace opengalaxy::runners
@@ -1,9 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "wrapper_runner.h"
+#include "opengalaxy/runners/resource_profile.h"
 #include "opengalaxy/util/log.h"
 
 #include <QFileInfo>
-#include <QProcessEnvironment>
 
 namespace opengalaxy::runners {
 static QString platformToString(Platform p) {
@@ -66,13 +66,6 @@ std::unique_ptr<QProcess> WrapperRunner::launch(const LaunchConfig &config) {
         return nullptr;
     }
 
-    // env: start from current environment and override
-    QStringList env = QProcessEnvironment::systemEnvironment().toStringList();
-    for (auto it = config.environment.begin(); it != config.environment.end(); ++it) {
-        env << (it.key() + "=" + it.value());
-    }
-    process->setEnvironment(env);
-
     QStringList args;
 
     if (runnerName_ == "Rosetta2") {
@@ -89,9 +82,11 @@ std::unique_ptr<QProcess> WrapperRunner::launch(const LaunchConfig &config) {
     }
 
     process->setProgram(chosenWrapper);
+    environment(config).applyTo(*process);
     process->setArguments(args);
     process->setWorkingDirectory(config.workingDirectory);
 
+    ResourceProfile::applyTo(*process, config.profile, config.gameMode);
     process->start();
 
     if (!process->waitForStarted(3000)) {
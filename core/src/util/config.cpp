@@ -81,6 +81,16 @@ QString Config::libraryDbPath() const { return dataDir_ + "/library.db"; }
 
 QString Config::logFilePath() const { return dataDir_ + "/opengalaxy.log"; }
 
+QString Config::imageCacheDir() const {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/images";
+}
+
+QString Config::prefixTemplateDir() const { return dataDir_ + "/prefix-templates"; }
+
+QString Config::shaderCacheDir() const {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shader-cache";
+}
+
 QString Config::defaultGamesDir() const { return defaultGamesDir_; }
 
 // Settings accessors
@@ -139,6 +149,67 @@ void Config::setShowHiddenGames(bool enabled) {
     settings_.sync();
 }
 
+bool Config::enableAnimations() const { return settings_.value("ui/animations", true).toBool(); }
+
+void Config::setEnableAnimations(bool enabled) {
+    settings_.setValue("ui/animations", enabled);
+    settings_.sync();
+}
+
+bool Config::showFrameStats() const {
+    return settings_.value("debug/frameStats", false).toBool();
+}
+
+void Config::setShowFrameStats(bool enabled) {
+    settings_.setValue("debug/frameStats", enabled);
+    settings_.sync();
+}
+
+bool Config::prewarmPrefixes() const {
+    return settings_.value("runners/prewarmPrefixes", true).toBool();
+}
+
+void Config::setPrewarmPrefixes(bool enabled) {
+    settings_.setValue("runners/prewarmPrefixes", enabled);
+    settings_.sync();
+}
+
+int Config::wineserverKeepAlive() const {
+    return settings_.value("runners/wineserverKeepAlive", 0).toInt();
+}
+
+void Config::setWineserverKeepAlive(int seconds) {
+    settings_.setValue("runners/wineserverKeepAlive", seconds);
+    settings_.sync();
+}
+
+int Config::shaderCacheLimitMb() const {
+    return settings_.value("runners/shaderCacheLimitMb", 4096).toInt();
+}
+
+void Config::setShaderCacheLimitMb(int megabytes) {
+    settings_.setValue("runners/shaderCacheLimitMb", megabytes);
+    settings_.sync();
+}
+
+QMap<QString, QString> Config::launchEnvironment() const {
+    QMap<QString, QString> environment;
+    const QVariantMap stored = settings_.value("runners/environment").toMap();
+    for (auto it = stored.cbegin(); it != stored.cend(); ++it) {
+        environment.insert(it.key(), it.value().toString());
+    }
+    return environment;
+}
+
+void Config::setLaunchEnvironment(const QMap<QString, QString> &environment) {
+    QVariantMap stored;
+    for (auto it = environment.cbegin(); it != environment.cend(); ++it) {
+        stored.insert(it.key(), it.value());
+    }
+    settings_.setValue("runners/environment", stored);
+    settings_.sync();
+}
+
 QByteArray Config::windowGeometry() const {
     return settings_.value("window/geometry").toByteArray();
 }
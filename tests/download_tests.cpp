@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "opengalaxy/api/gog_client.h"
 #include "opengalaxy/install/install_service.h"
+#include "opengalaxy/install/progress_throttle.h"
+#include "opengalaxy/install/transfer_stats.h"
 #include <QFile>
 #include <QTemporaryDir>
 #include <QtTest/QtTest>
@@ -155,6 +157,112 @@ class DownloadTests : public QObject {
         QVERIFY(errorOccurred);
     }
 
+    // ========== Progress Throttling Tests ==========
+
+    void testProgressThrottleCoalescesTicks() {
+        install::ProgressThrottle throttle(10); // At most one update per 100 ms
+        const qint64 total = 1000000;
+
+        QVERIFY(throttle.update(0, total, 0)); // First tick always goes out
+
+        // 1 ms ticks of 1 KB: percentage moves every 10 ticks, updates every 100 ms
+        int published = 0;
+        for (int t = 1; t <= 1000; ++t) {
+            if (throttle.update(t * 1000, total, t)) ++published;
+        }
+        QVERIFY(published <= 10);
+        QCOMPARE(throttle.percentage(), 100);
+    }
+
+    void testProgressThrottleSkipsUnchangedPercentage() {
+        install::ProgressThrottle throttle(10);
+        QVERIFY(throttle.update(0, 1000, 0));
+        QVERIFY(!throttle.update(5, 1000, 500)); // Still 0%, even though an update is due
+        QVERIFY(throttle.update(20, 1000, 600));
+        QCOMPARE(throttle.percentage(), 2);
+    }
+
+    void testProgressThrottleAlwaysPublishesCompletion() {
+        install::ProgressThrottle throttle(1);
+        QVERIFY(throttle.update(0, 1000, 0));
+        QVERIFY(throttle.update(1000, 1000, 10)); // Not due yet, but finished
+    }
+
+    // ========== Transfer Stats Tests ==========
+
+    void testTransferStatsRates() {
+        install::TransferStats stats;
+        QVERIFY(!stats.hasSamples());
+        QCOMPARE(stats.snapshot(0).etaSeconds, qint64(-1));
+
+        // 1 MB/s in 10 ms chunks for 20 s
+        const qint64 total = 100000000;
+        qint64 bytes = 0;
+        for (qint64 t = 0; t <= 20000; t += 10) {
+            stats.addSample(bytes, total, t);
+            bytes += 10000;
+        }
+        const auto steady = stats.snapshot(20000);
+        QVERIFY(qAbs(steady.instantBytesPerSecond - 1000000.0) < 1000.0);
+        QVERIFY(qAbs(steady.smoothedBytesPerSecond - 1000000.0) < 1000.0);
+        QVERIFY(qAbs(steady.averageBytesPerSecond - 1000000.0) < 1000.0);
+        QVERIFY(qAbs(steady.etaSeconds - 80) <= 1);
+        QVERIFY(!steady.stalled);
+
+        // Speed jumps to 4 MB/s: instant follows at once, the average barely moves
+        for (qint64 t = 20010; t <= 22000; t += 10) {
+            stats.addSample(bytes, total, t);
+            bytes += 40000;
+        }
+        const auto faster = stats.snapshot(22000);
+        QVERIFY(qAbs(faster.instantBytesPerSecond - 4000000.0) < 10000.0);
+        QVERIFY(faster.smoothedBytesPerSecond > 1500000.0);
+        QVERIFY(faster.smoothedBytesPerSecond < 4000000.0);
+        QVERIFY(faster.averageBytesPerSecond < 1500000.0);
+    }
+
+    void testTransferStatsStallDetection() {
+        install::TransferStats stats(5000);
+        stats.addSample(0, 1000, 0);
+        stats.addSample(500, 1000, 1000);
+        QVERIFY(!stats.isStalled(5000));
+
+        // No data for a while: rates decay and the transfer counts as stalled
+        const auto stalled = stats.snapshot(7000);
+        QVERIFY(stalled.stalled);
+        QCOMPARE(stalled.instantBytesPerSecond, 0.0);
+        QVERIFY(stalled.smoothedBytesPerSecond < 500.0);
+        QCOMPARE(stalled.etaSeconds, qint64(-1));
+
+        stats.addSample(600, 1000, 7100);
+        QVERIFY(!stats.isStalled(7100));
+
+        // A finished transfer is never stalled
+        stats.addSample(1000, 1000, 7200);
+        QVERIFY(!stats.isStalled(60000));
+    }
+
+    void testTransferStatsAggregateAndFormat() {
+        install::TransferStats::Snapshot a;
+        a.receivedBytes = 100;
+        a.totalBytes = 1100;
+        a.smoothedBytesPerSecond = 100;
+        a.stalled = true;
+        install::TransferStats::Snapshot b = a;
+        b.stalled = false;
+
+        a += b;
+        QCOMPARE(a.totalBytes, qint64(2200));
+        QCOMPARE(a.etaSeconds, qint64(10));
+        QVERIFY(!a.stalled);
+
+        QCOMPARE(install::TransferStats::formatRate(12400000), QString("12.4 MB/s"));
+        QCOMPARE(install::TransferStats::formatDuration(170), QString("3m"));
+        QCOMPARE(install::TransferStats::formatDuration(4800), QString("1h 20m"));
+        QCOMPARE(a.toString(), QString("200 B/s, 10s left"));
+        QCOMPARE(a.toJson().value("etaSeconds").toInteger(), qint64(10));
+    }
+
     // ========== Download Resume Tests ==========
 
     void testDownloadResume() {
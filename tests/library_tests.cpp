@@ -0,0 +1,483 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/library/executable_index.h"
+#include "opengalaxy/library/library_service.h"
+#include <QDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+#include <optional>
+
+using namespace opengalaxy;
+
+class LibraryTests : public QObject {
+    Q_OBJECT
+
+  private:
+    QString dbPath() const {
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/library.db";
+    }
+
+    // Rows are seeded through the service's named connection, as a library sync would
+    void insertGame(const QString &id, const QString &title) {
+        QSqlQuery query(QSqlDatabase::database("library"));
+        query.prepare("INSERT INTO games (id, title, platform) VALUES (?, ?, 'windows')");
+        query.addBindValue(id);
+        query.addBindValue(title);
+        QVERIFY(query.exec());
+    }
+
+    static void writeFile(const QString &path, const QByteArray &contents) {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(contents);
+    }
+
+    api::GameInfo game(library::LibraryService &service, const QString &id) {
+        api::GameInfo found;
+        service.getGame(id, [&found](util::Result<api::GameInfo> result) {
+            if (result.isOk()) found = result.value();
+        });
+        return found;
+    }
+
+    // Waits for the callback when the game has to be indexed first
+    util::Result<library::GameExecutable> primary(library::LibraryService &service,
+                                                  const QString &id) {
+        std::optional<util::Result<library::GameExecutable>> found;
+        service.primaryExecutable(id, [&found](auto result) { found.emplace(result); });
+        QTest::qWaitFor([&found]() { return found.has_value(); }, 5000);
+        return found ? *found : util::Result<library::GameExecutable>::error("Timed out");
+    }
+
+  private slots:
+    void initTestCase() {
+        QStandardPaths::setTestModeEnabled(true);
+        QDir().mkpath(QFileInfo(dbPath()).absolutePath());
+    }
+
+    void init() {
+        for (const char *suffix : {"", "-wal", "-shm", ".snapshot"}) {
+            QFile::remove(dbPath() + suffix);
+        }
+    }
+
+    // ========== Schema Tests ==========
+
+    void testMigratesLegacyPackedColumns() {
+        {
+            // The games table as unversioned builds created it, with packed
+            // runner arguments and a JSON environment
+            QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy");
+            legacy.setDatabaseName(dbPath());
+            QVERIFY(legacy.open());
+            QSqlQuery query(legacy);
+            QVERIFY(query.exec(R"(
+                CREATE TABLE games (
+                        id TEXT PRIMARY KEY,
+                        title TEXT NOT NULL,
+                        platform TEXT,
+                        coverUrl TEXT,
+                        backgroundUrl TEXT,
+                        developer TEXT,
+                        publisher TEXT,
+                        releaseDate TEXT,
+                        description TEXT,
+                        isInstalled INTEGER DEFAULT 0,
+                        installPath TEXT,
+                        version TEXT,
+                        size INTEGER DEFAULT 0,
+                        preferredRunner TEXT,
+                        runnerExecutable TEXT,
+                        runnerArguments TEXT,
+                        extraEnvironment TEXT,
+                        slug TEXT,
+                        hiddenInLibrary INTEGER DEFAULT 0,
+                        enableMangoHud INTEGER DEFAULT 0,
+                        enableDxvkHudFps INTEGER DEFAULT 0,
+                        enableGameMode INTEGER DEFAULT 0,
+                        enableCloudSaves INTEGER DEFAULT 1
+                )
+            )"));
+            QVERIFY(query.exec("INSERT INTO games (id, title, platform, runnerArguments, "
+                               "extraEnvironment) VALUES ('1', 'Legacy', 'windows', "
+                               "'--foo\n--bar', '{\"DXVK_HUD\":\"fps\"}')"));
+            legacy.close();
+        }
+        QSqlDatabase::removeDatabase("legacy");
+
+        library::LibraryService service(nullptr);
+        const api::GameInfo legacyGame = game(service, "1");
+
+        QCOMPARE(legacyGame.title, QString("Legacy"));
+        QCOMPARE(legacyGame.runnerArguments, QStringList({"--foo", "--bar"}));
+        QCOMPARE(legacyGame.extraEnvironment.value("DXVK_HUD"), QString("fps"));
+        QVERIFY(legacyGame.enableCloudSaves);
+    }
+
+    void testMigratesV4LaunchProfileColumns() {
+        // Migrate a fresh file, then strip it back to what a v4 build left behind
+        { library::LibraryService service(nullptr); }
+        {
+            QSqlDatabase v4 = QSqlDatabase::addDatabase("QSQLITE", "v4");
+            v4.setDatabaseName(dbPath());
+            QVERIFY(v4.open());
+            QSqlQuery query(v4);
+            for (const char *column : {"cpuAffinity", "niceLevel", "ioClass", "ioLevel",
+                                       "schedIso", "cgroupSlice", "memoryMax",
+                                       "cpuQuotaPercent"}) {
+                QVERIFY(query.exec(QString("ALTER TABLE games DROP COLUMN %1").arg(column)));
+            }
+            QVERIFY(query.exec("PRAGMA user_version = 4"));
+            QVERIFY(query.exec("INSERT INTO games (id, title, platform, enableGameMode) "
+                               "VALUES ('5', 'From v4', 'windows', 1)"));
+            v4.close();
+        }
+        QSqlDatabase::removeDatabase("v4");
+
+        library::LibraryService service(nullptr);
+        api::GameInfo upgraded = game(service, "5");
+        QCOMPARE(upgraded.title, QString("From v4"));
+        QVERIFY(upgraded.enableGameMode);
+        QVERIFY(upgraded.launchProfile == api::LaunchProfile());
+
+        upgraded.launchProfile.cpuAffinity = "0-3";
+        service.updateGameProperties(upgraded);
+        QCOMPARE(game(service, "5").launchProfile.cpuAffinity, QString("0-3"));
+    }
+
+    void testPropertiesRoundTrip() {
+        library::LibraryService service(nullptr);
+        insertGame("10", "Round Trip");
+        service.reload();
+
+        api::GameInfo g = game(service, "10");
+        g.runnerArguments = {"-a", "value with spaces", "-b"};
+        g.extraEnvironment = {{"PROTON_LOG", "1"}, {"WINEDEBUG", "-all"}};
+        g.hiddenInLibrary = true;
+        g.launchProfile.cpuAffinity = "0-7,16-23";
+        g.launchProfile.niceLevel = -5;
+        g.launchProfile.ioClass = 2;
+        g.launchProfile.ioLevel = 0;
+        g.launchProfile.memoryMax = "8G";
+        service.updateGameProperties(g);
+
+        const api::GameInfo stored = game(service, "10");
+        QCOMPARE(stored.runnerArguments, g.runnerArguments);
+        QCOMPARE(stored.extraEnvironment, g.extraEnvironment);
+        QVERIFY(stored.hiddenInLibrary);
+        QVERIFY(stored.launchProfile == g.launchProfile);
+    }
+
+    void testDownloadsAndInstallerPlatformFilter() {
+        library::LibraryService service(nullptr);
+        insertGame("20", "Linux Game");
+        insertGame("21", "Windows Game");
+
+        api::GameInfo::DownloadLink linuxInstaller;
+        linuxInstaller.url = "https://api.gog.com/products/20/downlink/installer/en3installer0";
+        linuxInstaller.platform = "linux";
+        linuxInstaller.size = 1024;
+        service.cacheGameDownloads("20", {linuxInstaller});
+
+        api::GameInfo::DownloadLink windowsInstaller = linuxInstaller;
+        windowsInstaller.platform = "windows";
+        service.cacheGameDownloads("21", {windowsInstaller});
+
+        const auto cached = service.cachedDownloads("20");
+        QCOMPARE(cached.size(), size_t(1));
+        QCOMPARE(cached.front().url, linuxInstaller.url);
+        QCOMPARE(cached.front().size, qint64(1024));
+
+        const auto linuxGames = service.filterByInstallerPlatform("Linux");
+        QCOMPARE(linuxGames.size(), size_t(1));
+        QCOMPARE(linuxGames.front().id, QString("20"));
+        QCOMPARE(linuxGames.front().downloads.size(), size_t(1));
+    }
+
+    void testCachedDetailsSurviveEmptyUpdates() {
+        library::LibraryService service(nullptr);
+        insertGame("25", "Detailed Game");
+        service.reload();
+
+        api::GameInfo details;
+        details.id = "25";
+        details.description = "A game with a story.";
+        details.backgroundUrl = "https://images.gog.com/25_bg.jpg";
+        details.releaseDate = QDateTime(QDate(2015, 5, 19), QTime(0, 0));
+        service.cacheGameDetails(details);
+
+        api::GameInfo stored = game(service, "25");
+        QCOMPARE(stored.description, details.description);
+        QCOMPARE(stored.backgroundUrl, details.backgroundUrl);
+        QCOMPARE(stored.releaseDate.date(), QDate(2015, 5, 19));
+
+        // A partial response only fills in what it has
+        api::GameInfo partial;
+        partial.id = "25";
+        partial.slug = "detailed_game";
+        service.cacheGameDetails(partial);
+
+        stored = game(service, "25");
+        QCOMPARE(stored.description, details.description);
+        QCOMPARE(stored.slug, QString("detailed_game"));
+    }
+
+    void testGenreFilter() {
+        library::LibraryService service(nullptr);
+        insertGame("30", "Some RPG");
+        insertGame("31", "Some Shooter");
+
+        QSqlQuery query(QSqlDatabase::database("library"));
+        QVERIFY(query.exec("INSERT INTO game_genres VALUES ('30', 'Role-playing')"));
+        QVERIFY(query.exec("INSERT INTO game_genres VALUES ('31', 'Shooter')"));
+
+        const auto rpgs = service.filterByGenre("role-playing");
+        QCOMPARE(rpgs.size(), size_t(1));
+        QCOMPARE(rpgs.front().id, QString("30"));
+        QCOMPARE(rpgs.front().genres, QStringList({"Role-playing"}));
+    }
+
+    // ========== Snapshot Tests ==========
+
+    void testSnapshotCopyOnWrite() {
+        library::LibraryService service(nullptr);
+        insertGame("40", "Installed Later");
+        insertGame("41", "Untouched");
+
+        QSignalSpy added(&service, &library::LibraryService::gamesAdded);
+        service.reload();
+        QCOMPARE(added.count(), 1);
+        QCOMPARE(added.first().first().toStringList().size(), 2);
+
+        const library::LibrarySnapshotPtr before = service.snapshot();
+        QCOMPARE(before->size(), size_t(2));
+        QVERIFY(!before->find("40")->isInstalled);
+
+        QSignalSpy updated(&service, &library::LibraryService::gameUpdated);
+        service.updateGameInstallation("40", "/games/40", "1.0");
+        QCOMPARE(updated.count(), 1);
+        QCOMPARE(updated.first().first().toString(), QString("40"));
+
+        const library::LibrarySnapshotPtr after = service.snapshot();
+        QVERIFY(after->version() > before->version());
+        QVERIFY(after->find("40")->isInstalled);
+        QCOMPARE(after->find("40")->installPath, QString("/games/40"));
+
+        // The old snapshot is untouched and unchanged entries are shared
+        QVERIFY(!before->find("40")->isInstalled);
+        QCOMPARE(after->find("41").get(), before->find("41").get());
+        QVERIFY(!after->find("missing"));
+
+        // Reloading an unchanged database publishes nothing
+        service.reload();
+        QCOMPARE(service.snapshot()->version(), after->version());
+    }
+
+    // ========== Play Session Tests ==========
+
+    void testPlaySessionAggregates() {
+        library::LibraryService service(nullptr);
+        insertGame("50", "Played First");
+        insertGame("51", "Played Last");
+
+        const qint64 first = service.beginPlaySession("50", "Wine");
+        QVERIFY(first > 0);
+        service.endPlaySession(first, 0, false);
+        // Closing twice must not count the session again
+        service.endPlaySession(first, 0, false);
+
+        QTest::qWait(10);
+        const qint64 second = service.beginPlaySession("51", "Wine");
+        service.endPlaySession(second, 1, false);
+        service.beginPlaySession("50", "Native"); // still running
+
+        const library::PlayStats stats = service.playStats("50");
+        QCOMPARE(stats.launchCount, 2);
+        QVERIFY(stats.lastPlayed.isValid());
+
+        const auto recent = service.recentlyPlayed();
+        QCOMPARE(recent.size(), size_t(2));
+        QCOMPARE(recent.front().gameId, QString("50"));
+
+        const auto sessions = service.playSessions("50");
+        QCOMPARE(sessions.size(), size_t(2));
+        QVERIFY(!sessions.front().endedAt.isValid());
+        QCOMPARE(sessions.back().runner, QString("Wine"));
+
+        // Open sessions are excluded from runner stats
+        const auto runners = service.runnerStats();
+        QCOMPARE(runners.size(), size_t(1));
+        QCOMPARE(runners.front().runner, QString("Wine"));
+        QCOMPARE(runners.front().sessions, 2);
+        QCOMPARE(runners.front().failures, 1);
+    }
+
+    // ========== Snapshot File Tests ==========
+
+    void testSnapshotExportImport() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file = dir.filePath("library.ogsnap");
+
+        {
+            library::LibraryService service(nullptr);
+            insertGame("60", "Exported");
+            service.reload();
+
+            api::GameInfo::DownloadLink installer;
+            installer.url = "https://api.gog.com/products/60/downlink/installer/en1installer0";
+            installer.platform = "windows";
+            service.cacheGameDownloads("60", {installer});
+            service.updateGameInstallation("60", "/games/60", "1.0");
+
+            QVERIFY(service.exportSnapshot(file).isOk());
+        }
+
+        // Fresh machine
+        init();
+        library::LibraryService service(nullptr);
+        QVERIFY(!service.snapshot()->contains("60"));
+
+        const auto imported = service.importSnapshot(file);
+        QVERIFY(imported.isOk());
+        QCOMPARE(imported.value(), 1);
+
+        const api::GameInfo game = this->game(service, "60");
+        QCOMPARE(game.title, QString("Exported"));
+        QCOMPARE(game.downloads.size(), size_t(1));
+        // Install state belongs to the machine that exported it
+        QVERIFY(!game.isInstalled);
+    }
+
+    void testSnapshotRejectsGarbage() {
+        QTemporaryDir dir;
+        QFile file(dir.filePath("garbage.ogsnap"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("definitely not a snapshot");
+        file.close();
+
+        QVERIFY(!library::LibrarySnapshot::readFromFile(file.fileName()).isOk());
+        QVERIFY(!library::LibrarySnapshot::readFromFile(dir.filePath("missing")).isOk());
+    }
+
+    // ========== Maintenance Tests ==========
+
+    void testDatabaseMaintenance() {
+        library::LibraryService service(nullptr);
+        for (int i = 0; i < 200; ++i) {
+            insertGame(QString::number(1000 + i), QString("Filler %1").arg(i).repeated(50));
+        }
+        QSqlQuery query(QSqlDatabase::database("library"));
+        QVERIFY(query.exec("DELETE FROM games"));
+
+        const library::DatabaseStats before = service.databaseStats();
+        QCOMPARE(before.journalMode.toLower(), QString("wal"));
+        QVERIFY(before.schemaVersion >= 3);
+        QVERIFY(before.pageSize > 0);
+        QVERIFY(before.freePages > 0);
+        QVERIFY(!before.lastMaintenance.isValid());
+
+        QSignalSpy finished(&service, &library::LibraryService::maintenanceFinished);
+        service.runMaintenance();
+        QCOMPARE(finished.count(), 1);
+
+        const library::DatabaseStats after = service.databaseStats();
+        QVERIFY(after.freePages < before.freePages);
+        QVERIFY(after.pageCount < before.pageCount);
+        QCOMPARE(after.walSize, qint64(0));
+        QVERIFY(after.lastMaintenance.isValid());
+    }
+
+    // ========== Executable Index Tests ==========
+
+    void testExecutableIndexUsesPlayTasks() {
+        QTemporaryDir install;
+        QVERIFY(install.isValid());
+        writeFile(install.filePath("bin/Game.exe"), "MZ");
+        writeFile(install.filePath("setup.exe"), QByteArray(2 * 1024 * 1024, 'x'));
+        writeFile(install.filePath("DOSBOX/dosbox.exe"), "MZ");
+        // Windows paths in the wrong case, as GOG writes them
+        writeFile(install.filePath("goggame-1207658924.info"), R"({
+            "gameId": "1207658924",
+            "playTasks": [
+                {"category": "game", "isPrimary": true, "type": "FileTask",
+                 "path": "BIN\\game.exe", "arguments": "-windowed", "name": "Play Game"},
+                {"category": "game", "type": "FileTask", "path": "DOSBOX\\dosbox.exe"},
+                {"category": "document", "type": "FileTask", "path": "manual.pdf"}
+            ]
+        })");
+
+        const auto entries = library::ExecutableIndex::build(install.path());
+        QVERIFY(!entries.empty());
+        const QString expected = QFileInfo(install.filePath("bin/Game.exe")).absoluteFilePath();
+        QCOMPARE(entries.front().path, expected);
+        QCOMPARE(entries.front().arguments, QString("-windowed"));
+        QCOMPARE(entries.front().name, QString("Play Game"));
+        QCOMPARE(entries.front().source, library::GameExecutable::Source::GogInfo);
+        QVERIFY(entries.front().isPrimary);
+
+        for (const auto &entry : entries) {
+            QVERIFY(!entry.path.contains("dosbox", Qt::CaseInsensitive));
+        }
+    }
+
+    void testExecutableIndexHeuristics() {
+        QTemporaryDir install;
+        QVERIFY(install.isValid());
+        writeFile(install.filePath("start.sh"), "#!/bin/sh\n");
+        writeFile(install.filePath("unins000.exe"), QByteArray(4 * 1024 * 1024, 'x'));
+        writeFile(install.filePath("support/postinst.sh"), "#!/bin/sh\n");
+        writeFile(install.filePath(".wine/drive_c/windows/system32/notepad.exe"), "MZ");
+
+        const auto entries = library::ExecutableIndex::build(install.path());
+        QCOMPARE(entries.size(), size_t(2)); // start.sh and the uninstaller
+        QCOMPARE(QFileInfo(entries.front().path).fileName(), QString("start.sh"));
+        QCOMPARE(entries.front().source, library::GameExecutable::Source::Heuristic);
+    }
+
+    void testPrimaryExecutableReindexesStaleEntries() {
+        QTemporaryDir install;
+        QVERIFY(install.isValid());
+        writeFile(install.filePath("game.exe"), "MZ");
+
+        library::LibraryService service(nullptr);
+        insertGame("30", "Indexed Game");
+        service.reload();
+
+        QSignalSpy indexed(&service, &library::LibraryService::executablesIndexed);
+        service.updateGameInstallation("30", install.path(), "1.0");
+        QVERIFY(indexed.wait());
+        QCOMPARE(service.executables("30").size(), size_t(1));
+
+        auto target = primary(service, "30");
+        QVERIFY(target.isOk());
+        QCOMPARE(QFileInfo(target.value().path).fileName(), QString("game.exe"));
+
+        // Patched in place: launched as is, re-indexed in the background
+        writeFile(install.filePath("game.exe"), "MZ patched");
+        indexed.clear();
+        target = primary(service, "30");
+        QVERIFY(target.isOk());
+        QCOMPARE(QFileInfo(target.value().path).fileName(), QString("game.exe"));
+        QVERIFY(indexed.wait());
+        QCOMPARE(service.executables("30").front().size, qint64(10));
+
+        // Patched: the old binary is gone, a new one took its place
+        QVERIFY(QFile::remove(install.filePath("game.exe")));
+        writeFile(install.filePath("game64.exe"), "MZ");
+        target = primary(service, "30");
+        QVERIFY(target.isOk());
+        QCOMPARE(QFileInfo(target.value().path).fileName(), QString("game64.exe"));
+
+        service.removeGameInstallation("30");
+        QVERIFY(service.executables("30").empty());
+    }
+
+    void cleanupTestCase() { QFile::remove(dbPath()); }
+};
+
+QTEST_MAIN(LibraryTests)
+#include "library_tests.moc"
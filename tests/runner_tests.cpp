@@ -1,13 +1,68 @@
 // SPDX-License-Identifier: Apache-2.0
+#include "opengalaxy/runners/binary_info.h"
+#include "opengalaxy/runners/dosbox_manager.h"
+#include "opengalaxy/runners/game_process_supervisor.h"
+#include "opengalaxy/runners/launch_environment.h"
+#include "opengalaxy/runners/prefix_manager.h"
+#include "opengalaxy/runners/resource_profile.h"
 #include "opengalaxy/runners/runner.h"
 #include "opengalaxy/runners/runner_manager.h"
+#include "opengalaxy/runners/runner_registry.h"
+#include "opengalaxy/runners/shader_cache.h"
+#include "opengalaxy/runners/wineserver_keepalive.h"
+#include "opengalaxy/util/config.h"
+#include "runners/proton_runner.h"
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtEndian>
 #include <QtTest/QtTest>
+#include <cstring>
+
+namespace {
+// Minimal 32-bit GUI PE image importing d3d9.dll: one section mapping RVA
+// 0x1000 to file offset 0x200, with the import directory at its start
+QByteArray makePe32() {
+    QByteArray image(0x400, '\0');
+    auto *d = reinterpret_cast<uchar *>(image.data());
+    auto put16 = [d](int offset, quint16 v) { qToLittleEndian(v, d + offset); };
+    auto put32 = [d](int offset, quint32 v) { qToLittleEndian(v, d + offset); };
+
+    d[0] = 'M';
+    d[1] = 'Z';
+    put32(0x3C, 0x80);
+    put32(0x80, 0x00004550); // "PE\0\0"
+
+    const int coff = 0x84, optional = coff + 20;
+    put16(coff, 0x014C); // i386
+    put16(coff + 2, 1);  // One section
+    put16(coff + 16, 224);
+    put16(optional, 0x10B);  // PE32
+    put16(optional + 68, 2); // GUI subsystem
+    put32(optional + 92, 16);
+    put32(optional + 96 + 8, 0x1000); // Import directory
+    put32(optional + 96 + 12, 40);
+
+    const int section = optional + 224;
+    put32(section + 8, 0x200);   // Virtual size
+    put32(section + 12, 0x1000); // Virtual address
+    put32(section + 16, 0x200);  // Raw size
+    put32(section + 20, 0x200);  // Raw offset
+
+    put32(0x200 + 12, 0x1100); // First descriptor's name
+    memcpy(d + 0x300, "D3D9.dll", 8);
+    return image;
+}
+} // namespace
 
 class RunnerTests : public QObject {
     Q_OBJECT
 
   private slots:
-    void initTestCase() { manager_ = new opengalaxy::runners::RunnerManager(this); }
+    void initTestCase() {
+        // Keep the registry cache out of the user's real cache directory
+        QStandardPaths::setTestModeEnabled(true);
+        manager_ = new opengalaxy::runners::RunnerManager(this);
+    }
 
     void testRunnerDiscovery() {
         manager_->discoverRunners();
@@ -97,9 +152,524 @@ class RunnerTests : public QObject {
         QVERIFY(runner != nullptr);
     }
 
+    void testRepeatedDiscoveryKeepsRunnersUnique() {
+        manager_->discoverRunners();
+        const auto first = manager_->availableRunners().size();
+        manager_->discoverRunners();
+
+        QCOMPARE(manager_->availableRunners().size(), first);
+    }
+
+    void testRegistryRoundTrip() {
+        using opengalaxy::runners::RunnerRecord;
+        using opengalaxy::runners::RunnerRegistry;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("runners.json");
+
+        RunnerRecord dosbox{"dosbox", "DOSBox", "/usr/bin/dosbox", 1700000000000, "0.74-3"};
+        RunnerRecord wine{"wine", "Wine", "/usr/bin/wine", 1700000001000, QString()};
+        QVERIFY(RunnerRegistry::save(path, {dosbox, wine}).isOk());
+
+        const auto loaded = RunnerRegistry::load(path);
+        QVERIFY(loaded.isOk());
+        QCOMPARE(loaded.value().size(), size_t(2));
+        QVERIFY(loaded.value()[0] == dosbox);
+        QVERIFY(loaded.value()[1] == wine);
+
+        QVERIFY(RunnerRegistry::load(dir.filePath("missing.json")).isError());
+    }
+
+    void testRegistryRecordValidation() {
+        using opengalaxy::runners::RunnerRecord;
+        using opengalaxy::runners::RunnerRegistry;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString exe = dir.filePath("fakerunner");
+        QFile file(exe);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("#!/bin/sh\n");
+        file.close();
+
+        RunnerRecord record{"wine", "Wine", exe, QFileInfo(exe).lastModified().toMSecsSinceEpoch(),
+                            QString()};
+        QVERIFY(RunnerRegistry::isCurrent(record));
+
+        // Binary replaced since the scan
+        record.mtime -= 60000;
+        QVERIFY(!RunnerRegistry::isCurrent(record));
+
+        record.path = dir.filePath("gone");
+        QVERIFY(!RunnerRegistry::isCurrent(record));
+    }
+
+    void testRegistryScanReusesKnownVersions() {
+        using opengalaxy::runners::RunnerRecord;
+        using opengalaxy::runners::RunnerRegistry;
+
+        // A dosbox that leaves a trace whenever it is probed
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString exe = dir.filePath("dosbox");
+        QFile file(exe);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("#!/bin/sh\ntouch \"$0.probed\"\necho 'DOSBox version 0.74-3'\n");
+        file.close();
+        QVERIFY(file.setPermissions(file.permissions() | QFileDevice::ExeOwner));
+
+        const QByteArray path = qgetenv("PATH");
+        qputenv("PATH", dir.path().toLocal8Bit() + ':' + path);
+
+        const RunnerRecord known{"dosbox", "DOSBox", exe,
+                                 QFileInfo(exe).lastModified().toMSecsSinceEpoch(), "cached"};
+        const auto records = RunnerRegistry::scan({known});
+        const bool probed = QFileInfo::exists(exe + ".probed");
+        RunnerRegistry::scan();
+        const bool probedWithoutRecords = QFileInfo::exists(exe + ".probed");
+        qputenv("PATH", path);
+
+        QVERIFY(!records.empty());
+        QCOMPARE(records.front().path, exe);
+        QCOMPARE(records.front().version, QString("cached"));
+        QVERIFY(!probed);
+        QVERIFY(probedWithoutRecords);
+    }
+
+    void testPeHeaderParsing() {
+        using opengalaxy::runners::BinaryInfo;
+        const QByteArray image = makePe32();
+        const BinaryInfo info = opengalaxy::runners::BinaryInspector::parse(
+            reinterpret_cast<const uchar *>(image.constData()), image.size());
+
+        QCOMPARE(info.format, BinaryInfo::Format::PE);
+        QCOMPARE(info.platform, opengalaxy::runners::Platform::Windows);
+        QCOMPARE(info.arch, opengalaxy::runners::Architecture::X86);
+        QVERIFY(!info.is64Bit);
+        QCOMPARE(info.subsystem, quint16(2));
+        QVERIFY(!info.dotNet);
+        QCOMPARE(info.imports, QStringList{"d3d9.dll"});
+        QVERIFY(info.usesDirect3D9());
+    }
+
+    void testDosAndTruncatedImages() {
+        using namespace opengalaxy::runners;
+
+        // MZ header with no new-style header behind it: plain DOS program
+        QByteArray dos(0x40, '\0');
+        dos[0] = 'M';
+        dos[1] = 'Z';
+        BinaryInfo info =
+            BinaryInspector::parse(reinterpret_cast<const uchar *>(dos.constData()), dos.size());
+        QCOMPARE(info.platform, Platform::DOS);
+
+        // Cut off inside the section table; must not read past the end
+        const QByteArray truncated = makePe32().left(0x150);
+        info = BinaryInspector::parse(reinterpret_cast<const uchar *>(truncated.constData()),
+                                      truncated.size());
+        QCOMPARE(info.arch, Architecture::X86);
+        QVERIFY(info.imports.isEmpty());
+
+        info = BinaryInspector::parse(nullptr, 0);
+        QVERIFY(!info.isValid());
+    }
+
+    void testInspectOwnExecutable() {
+#if defined(Q_OS_LINUX)
+        const auto info =
+            opengalaxy::runners::BinaryInspector::inspect(QCoreApplication::applicationFilePath());
+        QCOMPARE(info.format, opengalaxy::runners::BinaryInfo::Format::ELF);
+#if defined(__x86_64__)
+        QCOMPARE(info.arch, opengalaxy::runners::Architecture::X86_64);
+#endif
+#else
+        QSKIP("ELF only");
+#endif
+    }
+
+    void testInspectCacheFollowsFileChanges() {
+        using namespace opengalaxy::runners;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("game.exe");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(makePe32());
+        file.close();
+        QCOMPARE(Runner::detectArchitecture(path), Architecture::X86);
+
+        // Same path, different contents and size
+        QByteArray dos(0x40, '\0');
+        dos[0] = 'M';
+        dos[1] = 'Z';
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(dos);
+        file.close();
+        QCOMPARE(Runner::detectPlatform(path), Platform::DOS);
+    }
+
+    void testSupervisorFollowsOrphanedChildren() {
+#if defined(Q_OS_LINUX)
+        using namespace opengalaxy::runners;
+
+        // The shell exits at once; the game is the background sleep it leaves behind
+        GameProcessSupervisor supervisor;
+        QSignalSpy exited(&supervisor, &GameProcessSupervisor::gameExited);
+        QVERIFY(supervisor.supervise("orphan", startTagged("orphan", "sleep 1 & exit 0")));
+        QVERIFY(supervisor.isRunning("orphan"));
+
+        QVERIFY(exited.wait(5000));
+        QCOMPARE(exited.first().at(0).toString(), QString("orphan"));
+        QCOMPARE(exited.first().at(2).toBool(), false);
+        QVERIFY(!supervisor.isRunning("orphan"));
+        const auto stats = exited.first().at(3).value<GameProcessStats>();
+        QVERIFY(stats.wallTimeMs >= 900);
+#else
+        QSKIP("Needs /proc");
+#endif
+    }
+
+    void testSupervisorStopsWholeTree() {
+#if defined(Q_OS_LINUX)
+        using namespace opengalaxy::runners;
+
+        GameProcessSupervisor supervisor;
+        QSignalSpy exited(&supervisor, &GameProcessSupervisor::gameExited);
+        QVERIFY(supervisor.supervise("tree", startTagged("tree", "sleep 30 & sleep 30")));
+        QTRY_VERIFY(supervisor.processTree("tree").size() >= 2);
+
+        supervisor.stop("tree", 1000);
+        QVERIFY(exited.wait(5000));
+        QCOMPARE(exited.first().at(2).toBool(), false); // Stopped, not crashed
+        QVERIFY(!supervisor.isRunning("tree"));
+#else
+        QSKIP("Needs /proc");
+#endif
+    }
+
+    void testTerminateProcessesInParallel() {
+#if defined(Q_OS_LINUX)
+        using opengalaxy::runners::DOSBoxManager;
+
+        QProcess first, second;
+        first.start("sleep", {"30"});
+        second.start("sleep", {"30"});
+        QVERIFY(first.waitForStarted() && second.waitForStarted());
+
+        const QStringList pids = {QString::number(first.processId()),
+                                  QString::number(second.processId())};
+        QVERIFY(DOSBoxManager::isProcessRunning(pids[0]));
+        QVERIFY(DOSBoxManager::getProcessUptime(pids[0]) >= 0);
+        QVERIFY(DOSBoxManager::getProcessInfo(pids[0]).contains("sleep"));
+
+        // Both exit on SIGTERM, so neither waits out the other's timeout
+        QElapsedTimer timer;
+        timer.start();
+        QCOMPARE(DOSBoxManager::terminateProcesses(pids, 5000), 2);
+        QVERIFY(timer.elapsed() < 2000);
+        QVERIFY(!DOSBoxManager::isProcessRunning(pids[1]));
+        QVERIFY(!DOSBoxManager::findRunningDOSBoxProcesses().contains(pids[0]));
+#else
+        QSKIP("Needs /proc");
+#endif
+    }
+
+    void testPrefixCloneKeepsLayout() {
+        using opengalaxy::runners::PrefixManager;
+        using opengalaxy::runners::PrefixSpec;
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString source = dir.filePath("template");
+        QVERIFY(QDir().mkpath(source + "/drive_c/windows/system32"));
+        QVERIFY(QDir().mkpath(source + "/dosdevices"));
+        QFile reg(source + "/system.reg");
+        QVERIFY(reg.open(QIODevice::WriteOnly));
+        reg.write("WINE REGISTRY Version 2\n");
+        reg.close();
+        QFile dll(source + "/drive_c/windows/system32/kernel32.dll");
+        QVERIFY(dll.open(QIODevice::WriteOnly));
+        dll.write(QByteArray(100000, 'k'));
+        dll.close();
+        QVERIFY(QFile::link("../drive_c", source + "/dosdevices/c:"));
+        QVERIFY(PrefixManager::isInitialised(PrefixSpec::Type::Wine, source));
+
+        const QString clone = dir.filePath("game/prefix");
+        const auto result = PrefixManager::clone(source, clone);
+        QVERIFY2(result.isOk(), qPrintable(result.isOk() ? QString() : result.errorMessage()));
+        QCOMPARE(result.value().files, 2);
+        QVERIFY(PrefixManager::isInitialised(PrefixSpec::Type::Wine, clone));
+        QCOMPARE(QFileInfo(clone + "/drive_c/windows/system32/kernel32.dll").size(), 100000);
+
+        // Relative links stay relative, so they point into the clone
+        QCOMPARE(QFileInfo(clone + "/dosdevices/c:").canonicalFilePath(),
+                 QFileInfo(clone + "/drive_c").canonicalFilePath());
+
+        // Writing to the clone leaves the template alone
+        QFile cloned(clone + "/system.reg");
+        QVERIFY(cloned.open(QIODevice::Append));
+        cloned.write("changed");
+        cloned.close();
+        QCOMPARE(QFileInfo(source + "/system.reg").size(), qint64(24));
+    }
+
+    void testContainingPrefix() {
+        using opengalaxy::runners::PrefixManager;
+        using opengalaxy::runners::PrefixSpec;
+
+        const QString wine = "/games/x/.wine/drive_c/GOG Games/X/x.exe";
+        QCOMPARE(PrefixManager::containingPrefix(PrefixSpec::Type::Wine, wine),
+                 QString("/games/x/.wine"));
+        QVERIFY(PrefixManager::containingPrefix(PrefixSpec::Type::Proton, wine).isEmpty());
+
+        const QString proton = "/games/x/.proton/pfx/drive_c/GOG Games/X/x.exe";
+        QCOMPARE(PrefixManager::containingPrefix(PrefixSpec::Type::Proton, proton),
+                 QString("/games/x/.proton"));
+        QVERIFY(PrefixManager::containingPrefix(PrefixSpec::Type::Wine, "/games/x/x.exe")
+                    .isEmpty());
+    }
+
+    void testLaunchEnvironmentLayers() {
+        using opengalaxy::runners::LaunchEnvironment;
+
+        LaunchEnvironment env({{"WINEDEBUG", "+seh"}, {"OPENGALAXY_TEST_GAME", "1"}});
+        env.insert(LaunchEnvironment::Layer::Runner, "WINEDEBUG", "-all");
+        env.insert(LaunchEnvironment::Layer::Runner, "WINEPREFIX", "/prefix");
+        env.insert(LaunchEnvironment::Layer::Global, "WINEPREFIX", "/global");
+
+        // Game over runner over global, whatever order they were set in
+        const QProcessEnvironment merged = env.toProcessEnvironment();
+        QCOMPARE(merged.value("WINEDEBUG"), QString("+seh"));
+        QCOMPARE(merged.value("WINEPREFIX"), QString("/prefix"));
+        QCOMPARE(merged.value("PATH"), qEnvironmentVariable("PATH"));
+        QVERIFY(env.contains("PATH"));
+        QVERIFY(!env.contains("OPENGALAXY_TEST_UNSET"));
+
+        const QStringList lines = env.describe();
+        QVERIFY(lines.contains("WINEPREFIX=/prefix  [runner]"));
+        QVERIFY(lines.contains("PATH=" + qEnvironmentVariable("PATH")));
+        QCOMPARE(env.describeOverrides().size(), 3);
+    }
+
+    void testShaderCacheEnvironment() {
+        using opengalaxy::runners::LaunchEnvironment;
+        using opengalaxy::runners::PrefixSpec;
+        using opengalaxy::runners::ShaderCache;
+
+        LaunchEnvironment env({{"DXVK_STATE_CACHE_PATH", "/mine"}});
+        ShaderCache::applyTo(env, "1207658924", PrefixSpec::Type::Proton);
+        const QString dir = ShaderCache::path("1207658924");
+        QCOMPARE(env.value("DXVK_STATE_CACHE_PATH"), QString("/mine"));
+        QCOMPARE(env.value("VKD3D_SHADER_CACHE_PATH"), dir + "/vkd3d");
+        QCOMPARE(env.value("STEAM_COMPAT_SHADER_PATH"), dir);
+
+        ShaderCache::markUsed("1207658924");
+        QVERIFY(QFileInfo(dir + "/vkd3d").isDir());
+
+        LaunchEnvironment untouched;
+        ShaderCache::applyTo(untouched, "../escape", PrefixSpec::Type::Wine);
+        QVERIFY(untouched.describeOverrides().isEmpty());
+        QVERIFY(ShaderCache::clear("1207658924"));
+    }
+
+    void testShaderCachePruneOldestFirst() {
+        using opengalaxy::runners::ShaderCache;
+        QVERIFY(ShaderCache::clearAll());
+
+        const QDateTime now = QDateTime::currentDateTime();
+        const QStringList ids = {"old", "recent", "removed"};
+        for (int i = 0; i < ids.size(); ++i) {
+            ShaderCache::markUsed(ids[i]);
+            QFile cache(ShaderCache::path(ids[i]) + "/dxvk/game.dxvk-cache");
+            QVERIFY(cache.open(QIODevice::WriteOnly));
+            cache.write(QByteArray(1024, 'x'));
+            cache.close();
+
+            QFile marker(ShaderCache::path(ids[i]) + "/.last-used");
+            QVERIFY(marker.open(QIODevice::ReadWrite));
+            marker.setFileTime(now.addDays(i - 10), QFileDevice::FileModificationTime);
+        }
+        QVERIFY(ShaderCache::size("old") >= 1024);
+
+        // The removed game goes regardless of age, then the oldest known one
+        const qint64 freed = ShaderCache::prune(ShaderCache::size("recent"), {"old", "recent"});
+        QVERIFY(freed >= 2048);
+        QVERIFY(!QFileInfo::exists(ShaderCache::path("removed")));
+        QVERIFY(!QFileInfo::exists(ShaderCache::path("old")));
+        QVERIFY(QFileInfo::exists(ShaderCache::path("recent")));
+
+        // A running game's cache survives clearing the rest
+        ShaderCache::markUsed("running");
+        QVERIFY(ShaderCache::clearAll({"running"}));
+        QVERIFY(!QFileInfo::exists(ShaderCache::path("recent")));
+        QVERIFY(QFileInfo::exists(ShaderCache::path("running")));
+        QVERIFY(ShaderCache::clearAll());
+    }
+
+    void testProtonServerEnvironment() {
+        using opengalaxy::runners::LaunchConfig;
+        using opengalaxy::runners::ProtonRunner;
+
+        for (const char *name : {"PROTON_CONFIG", "PROTON_NO_ESYNC", "PROTON_NO_FSYNC",
+                                 "PROTON_USE_NTSYNC", "WINEESYNC", "WINEFSYNC"}) {
+            qunsetenv(name);
+        }
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        ProtonRunner runner("Proton Test", dir.filePath("proton"));
+        const auto serverEnvironment = [&](const QMap<QString, QString> &environment) {
+            LaunchConfig config;
+            config.installPath = dir.filePath("games/x");
+            config.environment = environment;
+            return runner.serverEnvironment(config);
+        };
+
+        // Esync and fsync are on unless turned off, whatever the game sets
+        auto env = serverEnvironment({{"WINEESYNC", "0"}});
+        QVERIFY(env.has_value());
+        QCOMPARE(env->value("WINEESYNC"), QString("1"));
+        QCOMPARE(env->value("WINEFSYNC"), QString("1"));
+
+        env = serverEnvironment({{"PROTON_CONFIG", "noesync, nofsync"}, {"WINEESYNC", "1"}});
+        QVERIFY(env.has_value());
+        QVERIFY(!env->contains("WINEESYNC"));
+        QVERIFY(!env->contains("WINEFSYNC"));
+
+        // A set PROTON_NO_* variable overrides PROTON_CONFIG either way
+        env = serverEnvironment({{"PROTON_CONFIG", "noesync,nofsync"},
+                                 {"PROTON_NO_ESYNC", "0"},
+                                 {"PROTON_NO_FSYNC", ""}});
+        QVERIFY(env.has_value());
+        QCOMPARE(env->value("WINEESYNC"), QString("1"));
+        QCOMPARE(env->value("WINEFSYNC"), QString("1"));
+
+        env = serverEnvironment({{"PROTON_NO_FSYNC", "1"}});
+        QVERIFY(env.has_value());
+        QCOMPARE(env->value("WINEESYNC"), QString("1"));
+        QVERIFY(!env->contains("WINEFSYNC"));
+
+        // NTSync, and settings only user_settings.py knows, cannot be predicted
+        QVERIFY(!serverEnvironment({{"PROTON_CONFIG", "ntsync"}}).has_value());
+        QVERIFY(!serverEnvironment({{"PROTON_USE_NTSYNC", "1"}}).has_value());
+        QVERIFY(serverEnvironment({{"PROTON_CONFIG", "ntsync"}, {"PROTON_USE_NTSYNC", "0"}})
+                    .has_value());
+
+        QVERIFY(QDir().mkpath(dir.filePath("proton")));
+        QFile settings(dir.filePath("proton/user_settings.py"));
+        QVERIFY(settings.open(QIODevice::WriteOnly));
+        settings.close();
+        QVERIFY(!serverEnvironment({}).has_value());
+    }
+
+    void testKeepAliveDisabled() {
+        using opengalaxy::runners::PrefixManager;
+        using opengalaxy::runners::PrefixSpec;
+        using opengalaxy::runners::WineserverKeepAlive;
+        using opengalaxy::util::Config;
+
+        // An initialised prefix with a working wineserver, so only the setting refuses
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const PrefixSpec spec{PrefixSpec::Type::Proton, dir.filePath("proton/proton"),
+                              dir.filePath("prefix")};
+        QVERIFY(QDir().mkpath(spec.path + "/pfx/drive_c"));
+        QFile reg(spec.path + "/pfx/system.reg");
+        QVERIFY(reg.open(QIODevice::WriteOnly));
+        reg.close();
+        QVERIFY(PrefixManager::isInitialised(spec.type, spec.path));
+        QVERIFY(QDir().mkpath(dir.filePath("proton/files/bin")));
+        QFile server(dir.filePath("proton/files/bin/wineserver"));
+        QVERIFY(server.open(QIODevice::WriteOnly));
+        server.write("#!/bin/sh\nexit 0\n");
+        server.close();
+        QVERIFY(server.setPermissions(server.permissions() | QFileDevice::ExeOwner));
+
+        Config &config = Config::instance();
+        const int previous = config.wineserverKeepAlive();
+        config.setWineserverKeepAlive(0);
+        QCOMPARE(WineserverKeepAlive::idleTimeout(), 0);
+        const bool acquired =
+            WineserverKeepAlive::acquire(spec, QProcessEnvironment::systemEnvironment());
+        config.setWineserverKeepAlive(previous);
+
+        QVERIFY(!acquired);
+        QVERIFY(!WineserverKeepAlive::activePrefixes().contains(spec.path + "/pfx"));
+    }
+
+    void testCpuLists() {
+        using opengalaxy::runners::ResourceProfile;
+
+        QCOMPARE(ResourceProfile::parseCpuList("0-3, 8,10-11,2"),
+                 QList<int>({0, 1, 2, 3, 8, 10, 11}));
+        QCOMPARE(ResourceProfile::formatCpuList({11, 0, 2, 1, 3, 8, 10}), QString("0-3,8,10-11"));
+        QVERIFY(ResourceProfile::parseCpuList("3-1").isEmpty());
+        QVERIFY(ResourceProfile::parseCpuList("0-").isEmpty());
+        QVERIFY(ResourceProfile::parseCpuList("p-cores").isEmpty());
+
+        opengalaxy::api::LaunchProfile profile;
+        QVERIFY(ResourceProfile::validate(profile).isEmpty());
+        profile.memoryMax = "8 GB";
+        QVERIFY(!ResourceProfile::validate(profile).isEmpty());
+        profile.memoryMax = "8G";
+        profile.slice = "../escape";
+        QVERIFY(!ResourceProfile::validate(profile).isEmpty());
+    }
+
+    void testProfileAppliedInChild() {
+        using opengalaxy::runners::ResourceProfile;
+
+        // Pin to the last CPU this test may use; raising the nice level needs no privileges
+        const QList<int> allowed = ResourceProfile::parseCpuList(readStatus("Cpus_allowed_list"));
+        if (allowed.isEmpty()) QSKIP("No /proc to read the affinity from");
+        opengalaxy::api::LaunchProfile profile;
+        profile.cpuAffinity = QString::number(allowed.last());
+        profile.niceLevel = 19;
+
+        QProcess process;
+        process.setProgram("/bin/sh");
+        process.setArguments({"-c", "grep Cpus_allowed_list /proc/self/status; nice"});
+        ResourceProfile::applyTo(process, profile, false);
+        process.start();
+        QVERIFY(process.waitForFinished());
+
+        const QStringList lines = QString::fromLocal8Bit(process.readAllStandardOutput())
+                                      .split('\n', Qt::SkipEmptyParts);
+        QCOMPARE(lines.size(), 2);
+        QCOMPARE(lines[0].section(':', 1).trimmed(), profile.cpuAffinity);
+        QCOMPARE(lines[1].trimmed(), QString("19"));
+    }
+
     void cleanupTestCase() { delete manager_; }
 
   private:
+    static QString readStatus(const QString &field) {
+        QFile status("/proc/self/status");
+        if (!status.open(QIODevice::ReadOnly)) return {};
+        for (const QByteArray &line : status.readAll().split('\n')) {
+            if (line.startsWith(field.toLatin1() + ':')) {
+                return QString::fromLatin1(line.mid(field.size() + 1)).trimmed();
+            }
+        }
+        return {};
+    }
+
+    static std::unique_ptr<QProcess> startTagged(const QString &gameId, const QString &script) {
+        opengalaxy::runners::LaunchConfig config;
+        opengalaxy::runners::GameProcessSupervisor::tagLaunch(config, gameId);
+
+        auto process = std::make_unique<QProcess>();
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        for (auto it = config.environment.cbegin(); it != config.environment.cend(); ++it) {
+            env.insert(it.key(), it.value());
+        }
+        process->setProcessEnvironment(env);
+        process->start("/bin/sh", {"-c", script});
+        if (!process->waitForStarted()) return nullptr;
+        return process;
+    }
+
     opengalaxy::runners::RunnerManager *manager_;
 };
 
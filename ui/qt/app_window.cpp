@@ -14,7 +14,6 @@
 #include "dialogs/oauth_login_dialog.h"
 #include "pages/friends_page.h"
 #include "pages/store_page.h"
-#include "widgets/game_card.h"
 
 namespace opengalaxy {
 namespace ui {
@@ -59,6 +58,8 @@ AppWindow::AppWindow(TranslationManager *translationManager, QWidget *parent)
     storePage = new StorePage(this);
     friendsPage = new FriendsPage(session_, this);
     settingsPage = new SettingsPage(translationManager_, session_, this);
+    settingsPage->setLibraryService(libraryPage->libraryService());
+    settingsPage->setSupervisor(libraryPage->supervisor());
 
     stackedWidget->addWidget(loginPage);
     stackedWidget->addWidget(libraryPage);
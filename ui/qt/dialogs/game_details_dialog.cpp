@@ -1,4 +1,5 @@
 #include "game_details_dialog.h"
+#include "opengalaxy/runners/resource_profile.h"
 
 #include <QDebug>
 #include <QDesktopServices>
@@ -9,7 +10,9 @@
 #include <QMessageBox>
 #include <QProcess>
 #include <QStandardPaths>
+#include <QThread>
 #include <QUrl>
+#include <algorithm>
 
 namespace opengalaxy {
 namespace ui {
@@ -46,7 +49,7 @@ GameDetailsDialog::GameDetailsDialog(const api::GameInfo &game,
     : QDialog(parent), game_(game), libraryService_(libraryService), runnerManager_(runnerManager) {
     setWindowTitle(tr("Game Properties"));
     setModal(true);
-    resize(520, 520);
+    resize(520, 640);
 
     auto *root = new QVBoxLayout(this);
     root->setContentsMargins(18, 18, 18, 18);
@@ -101,7 +104,7 @@ GameDetailsDialog::GameDetailsDialog(const api::GameInfo &game,
     tweaksLayout->addWidget(mangohudCheck_);
 
     gamemodeCheck_ = new QCheckBox(tr("Use GameMode"), tweaksBox);
-    gamemodeCheck_->setToolTip(tr("Enable GameMode for better performance"));
+    gamemodeCheck_->setToolTip(tr("Run under gamemoderun; GameMode then sets the priorities"));
     tweaksLayout->addWidget(gamemodeCheck_);
 
     cloudSavesCheck_ = new QCheckBox(tr("Enable Cloud Saves"), tweaksBox);
@@ -111,6 +114,67 @@ GameDetailsDialog::GameDetailsDialog(const api::GameInfo &game,
 
     root->addWidget(tweaksBox);
 
+    // Launch profile Section
+    auto *profileBox = new QGroupBox(tr("Performance"), this);
+    auto *profileForm = new QFormLayout(profileBox);
+
+    cpuAffinityEdit_ = new QLineEdit(profileBox);
+    cpuAffinityEdit_->setPlaceholderText(tr("All CPUs (e.g. 0-7,16-23)"));
+    cpuGroupCombo_ = new QComboBox(profileBox);
+    cpuGroupCombo_->addItem(tr("All CPUs"), QString());
+    for (const auto &group : runners::ResourceProfile::cpuGroups()) {
+        cpuGroupCombo_->addItem(QString("%1: %2").arg(group.name, group.cpus), group.cpus);
+    }
+    cpuGroupCombo_->setEnabled(cpuGroupCombo_->count() > 1);
+    connect(cpuGroupCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [this](int index) {
+                if (index < 0) return;
+                cpuAffinityEdit_->setText(cpuGroupCombo_->itemData(index).toString());
+            });
+    auto *affinityLayout = new QHBoxLayout();
+    affinityLayout->addWidget(cpuAffinityEdit_, 1);
+    affinityLayout->addWidget(cpuGroupCombo_);
+
+    niceSpin_ = new QSpinBox(profileBox);
+    niceSpin_->setRange(-20, 19);
+    niceSpin_->setToolTip(tr("Lower runs first; below 0 needs permission to raise priority"));
+
+    ioClassCombo_ = new QComboBox(profileBox);
+    ioClassCombo_->addItem(tr("Default"), 0);
+    ioClassCombo_->addItem(tr("Realtime"), 1);
+    ioClassCombo_->addItem(tr("Best effort"), 2);
+    ioClassCombo_->addItem(tr("Idle"), 3);
+    ioLevelSpin_ = new QSpinBox(profileBox);
+    ioLevelSpin_->setRange(0, 7);
+    ioLevelSpin_->setToolTip(tr("0 is the highest priority within the class"));
+    auto *ioLayout = new QHBoxLayout();
+    ioLayout->addWidget(ioClassCombo_, 1);
+    ioLayout->addWidget(ioLevelSpin_);
+
+    schedIsoCheck_ = new QCheckBox(tr("Soft real-time scheduling (SCHED_ISO)"), profileBox);
+    schedIsoCheck_->setToolTip(tr("Only on kernels that provide it; GameMode sets it itself"));
+
+    sliceEdit_ = new QLineEdit(profileBox);
+    sliceEdit_->setPlaceholderText(tr("Optional: systemd slice (e.g. games.slice)"));
+    memoryMaxEdit_ = new QLineEdit(profileBox);
+    memoryMaxEdit_->setPlaceholderText(tr("Unlimited (e.g. 8G)"));
+    cpuQuotaSpin_ = new QSpinBox(profileBox);
+    cpuQuotaSpin_->setRange(0, 100 * QThread::idealThreadCount());
+    cpuQuotaSpin_->setSingleStep(50);
+    cpuQuotaSpin_->setSuffix("%");
+    cpuQuotaSpin_->setSpecialValueText(tr("Unlimited"));
+    cpuQuotaSpin_->setToolTip(tr("100% is one full CPU"));
+
+    profileForm->addRow(tr("CPU affinity"), affinityLayout);
+    profileForm->addRow(tr("Nice level"), niceSpin_);
+    profileForm->addRow(tr("I/O priority"), ioLayout);
+    profileForm->addRow(QString(), schedIsoCheck_);
+    profileForm->addRow(tr("Slice"), sliceEdit_);
+    profileForm->addRow(tr("Memory limit"), memoryMaxEdit_);
+    profileForm->addRow(tr("CPU limit"), cpuQuotaSpin_);
+
+    root->addWidget(profileBox);
+
     // Wine/Proton Tools Section
     auto *toolsBox = new QGroupBox(tr("Wine/Proton Tools"), this);
     auto *toolsLayout = new QHBoxLayout(toolsBox);
@@ -194,6 +258,17 @@ GameDetailsDialog::GameDetailsDialog(const api::GameInfo &game,
     gamemodeCheck_->setChecked(game_.enableGameMode);
     cloudSavesCheck_->setChecked(game_.enableCloudSaves);
 
+    // Load launch profile
+    const api::LaunchProfile &profile = game_.launchProfile;
+    cpuAffinityEdit_->setText(profile.cpuAffinity);
+    niceSpin_->setValue(profile.niceLevel);
+    ioClassCombo_->setCurrentIndex(std::max(0, ioClassCombo_->findData(profile.ioClass)));
+    ioLevelSpin_->setValue(profile.ioLevel);
+    schedIsoCheck_->setChecked(profile.schedIso);
+    sliceEdit_->setText(profile.slice);
+    memoryMaxEdit_->setText(profile.memoryMax);
+    cpuQuotaSpin_->setValue(profile.cpuQuotaPercent);
+
     // Select preferred runner
     const QString pref = game_.preferredRunner.trimmed();
     if (!pref.isEmpty()) {
@@ -223,6 +298,22 @@ void GameDetailsDialog::onSave() {
         return;
     }
 
+    api::LaunchProfile profile;
+    profile.cpuAffinity = cpuAffinityEdit_->text().trimmed();
+    profile.niceLevel = niceSpin_->value();
+    profile.ioClass = ioClassCombo_->currentData().toInt();
+    profile.ioLevel = ioLevelSpin_->value();
+    profile.schedIso = schedIsoCheck_->isChecked();
+    profile.slice = sliceEdit_->text().trimmed();
+    profile.memoryMax = memoryMaxEdit_->text().trimmed();
+    profile.cpuQuotaPercent = cpuQuotaSpin_->value();
+    const QString profileError = runners::ResourceProfile::validate(profile);
+    if (!profileError.isEmpty()) {
+        QMessageBox::warning(this, tr("Invalid performance settings"), profileError);
+        return;
+    }
+    game_.launchProfile = profile;
+
     game_.preferredRunner = runnerCombo_->currentData().toString();
     game_.runnerExecutable = runnerExecutableEdit_->text().trimmed();
     game_.runnerArguments = runnerArgsEdit_->toPlainText().split('\n', Qt::SkipEmptyParts);
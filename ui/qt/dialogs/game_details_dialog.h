@@ -8,6 +8,7 @@
 #include <QLineEdit>
 #include <QPlainTextEdit>
 #include <QPushButton>
+#include <QSpinBox>
 #include <QVBoxLayout>
 
 #include "opengalaxy/api/models.h"
@@ -57,6 +58,17 @@ class GameDetailsDialog : public QDialog {
     QCheckBox *gamemodeCheck_ = nullptr;
     QCheckBox *cloudSavesCheck_ = nullptr;
 
+    // Launch profile
+    QLineEdit *cpuAffinityEdit_ = nullptr;
+    QComboBox *cpuGroupCombo_ = nullptr;
+    QSpinBox *niceSpin_ = nullptr;
+    QComboBox *ioClassCombo_ = nullptr;
+    QSpinBox *ioLevelSpin_ = nullptr;
+    QCheckBox *schedIsoCheck_ = nullptr;
+    QLineEdit *sliceEdit_ = nullptr;
+    QLineEdit *memoryMaxEdit_ = nullptr;
+    QSpinBox *cpuQuotaSpin_ = nullptr;
+
     // Tool buttons
     QPushButton *winecfgBtn_ = nullptr;
     QPushButton *protontricksBtn_ = nullptr;
@@ -7,6 +7,8 @@
 #include <QUrl>
 #include <QVBoxLayout>
 
+#include "../services/image_cache.h"
+
 namespace opengalaxy {
 namespace ui {
 
@@ -68,6 +70,27 @@ GameInformationDialog::GameInformationDialog(const api::GameInfo &game, QWidget
     contentLayout->setContentsMargins(0, 0, 0, 0);
     contentLayout->setSpacing(10);
 
+    // Background art; usually already warmed by the library's DetailsPrefetcher
+    if (!game_.backgroundUrl.isEmpty()) {
+        QLabel *backgroundLabel = new QLabel(content);
+        backgroundLabel->setAlignment(Qt::AlignCenter);
+        ImageCache &cache = ImageCache::instance();
+        const QPixmap background = cache.pixmap(game_.backgroundUrl, backgroundSize());
+        if (!background.isNull()) {
+            backgroundLabel->setPixmap(background);
+        } else {
+            backgroundLabel->hide();
+            connect(&cache, &ImageCache::imageReady, backgroundLabel,
+                    [backgroundLabel, url = game_.backgroundUrl](const QString &readyUrl) {
+                        if (readyUrl != url) return;
+                        backgroundLabel->setPixmap(
+                            ImageCache::instance().pixmap(url, backgroundSize()));
+                        backgroundLabel->show();
+                    });
+        }
+        contentLayout->addWidget(backgroundLabel);
+    }
+
     // Title
     QLabel *titleLabel = new QLabel(game_.title, content);
     titleLabel->setObjectName("title");
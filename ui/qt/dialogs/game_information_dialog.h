@@ -17,6 +17,9 @@ class GameInformationDialog : public QDialog {
     explicit GameInformationDialog(const api::GameInfo &game, QWidget *parent = nullptr);
     ~GameInformationDialog();
 
+    // Background art is loaded through the ImageCache at this size
+    static QSize backgroundSize() { return QSize(540, 304); }
+
   private:
     void openLink(const QString &url);
 
@@ -0,0 +1,99 @@
+#include "library_filter_model.h"
+
+#include "library_model.h"
+
+namespace opengalaxy {
+namespace ui {
+
+LibraryFilterModel::LibraryFilterModel(QObject *parent) : QSortFilterProxyModel(parent) {}
+
+LibraryFilterModel::~LibraryFilterModel() = default;
+
+void LibraryFilterModel::setSourceModel(QAbstractItemModel *model) {
+    if (sourceModel()) {
+        disconnect(sourceModel(), nullptr, this, nullptr);
+    }
+
+    // Connected before the base class hooks up its own handlers, so the cache is
+    // current by the time the proxy re-evaluates rows for the same signal
+    if (model) {
+        connect(model, &QAbstractItemModel::modelReset, this, [this]() { rebuildCache(); });
+        connect(model, &QAbstractItemModel::rowsInserted, this, [this]() { rebuildCache(); });
+        connect(model, &QAbstractItemModel::rowsRemoved, this, [this]() { rebuildCache(); });
+        connect(model, &QAbstractItemModel::dataChanged, this,
+                [this](const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                       const QList<int> &roles) {
+                    if (!roles.isEmpty() && !roles.contains(LibraryModel::TitleRole) &&
+                        !roles.contains(LibraryModel::HiddenRole)) {
+                        return; // Progress, covers, ...: nothing we filter on
+                    }
+                    const int last = qMin(bottomRight.row(), int(lowerTitles_.size()) - 1);
+                    for (int row = topLeft.row(); row <= last; ++row) {
+                        cacheRow(row);
+                        matches_[row] = true; // Title may have changed; test it in full
+                    }
+                });
+    }
+
+    QSortFilterProxyModel::setSourceModel(model);
+    rebuildCache();
+    invalidateRowsFilter();
+}
+
+void LibraryFilterModel::setSearchText(const QString &text) {
+    const QString search = text.trimmed().toLower();
+    if (search == search_) return;
+
+    // Every row was tested against search_, so a longer query can only lose matches
+    narrowing_ = search.startsWith(search_);
+    search_ = search;
+    refilter();
+}
+
+void LibraryFilterModel::setShowHiddenGames(bool show) {
+    if (show == showHidden_) return;
+    showHidden_ = show;
+    narrowing_ = true; // The search did not change; neither did its matches
+    refilter();
+}
+
+void LibraryFilterModel::refilter() {
+    invalidateRowsFilter();
+    narrowing_ = false;
+}
+
+void LibraryFilterModel::rebuildCache() {
+    const int rows = sourceModel() ? sourceModel()->rowCount() : 0;
+
+    lowerTitles_.assign(rows, QString());
+    hidden_.assign(rows, false);
+    matches_.assign(rows, true);
+    narrowing_ = false;
+
+    for (int row = 0; row < rows; ++row) {
+        cacheRow(row);
+    }
+}
+
+void LibraryFilterModel::cacheRow(int row) {
+    const QModelIndex index = sourceModel()->index(row, 0);
+    lowerTitles_[row] = index.data(LibraryModel::TitleRole).toString().toLower();
+    hidden_[row] = index.data(LibraryModel::HiddenRole).toBool();
+}
+
+bool LibraryFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    Q_UNUSED(sourceParent);
+    if (sourceRow < 0 || sourceRow >= int(lowerTitles_.size())) return true;
+
+    bool match = true;
+    if (!search_.isEmpty()) {
+        match = (!narrowing_ || matches_[sourceRow]) &&
+                lowerTitles_[sourceRow].contains(search_);
+    }
+    matches_[sourceRow] = match;
+
+    return match && (showHidden_ || !hidden_[sourceRow]);
+}
+
+} // namespace ui
+} // namespace opengalaxy
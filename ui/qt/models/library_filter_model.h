@@ -0,0 +1,55 @@
+#ifndef LIBRARY_FILTER_MODEL_H
+#define LIBRARY_FILTER_MODEL_H
+
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <vector>
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Search and hidden-game filter over a LibraryModel.
+ *
+ * Titles are lowercased once per library change, not per keystroke. When a
+ * query only extends the previous one ("wit" -> "witc"), rows that did not
+ * match before are rejected without looking at their title, so typing
+ * narrows the last result set instead of rescanning the whole library.
+ */
+class LibraryFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+
+  public:
+    explicit LibraryFilterModel(QObject *parent = nullptr);
+    ~LibraryFilterModel();
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    QString searchText() const { return search_; }
+    void setSearchText(const QString &text);
+
+    bool showHiddenGames() const { return showHidden_; }
+    void setShowHiddenGames(bool show);
+
+  protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+  private:
+    void rebuildCache();
+    void cacheRow(int row);
+    void refilter();
+
+    QString search_; // trimmed and lowercased
+    bool showHidden_ = false;
+    bool narrowing_ = false; // search_ extends the query matches_ was built for
+
+    // Indexed by source row
+    std::vector<QString> lowerTitles_;
+    std::vector<char> hidden_;
+    mutable std::vector<char> matches_;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // LIBRARY_FILTER_MODEL_H
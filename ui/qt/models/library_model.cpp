@@ -1,25 +1,227 @@
 #include "library_model.h"
 
+#include <QDateTime>
+#include <QPixmap>
+#include <algorithm>
+
+#include "../services/image_cache.h"
+
 namespace opengalaxy {
 namespace ui {
 
 LibraryModel::LibraryModel(QObject *parent) : QAbstractListModel(parent) {
-    gameNames << "Game 1" << "Game 2" << "Game 3";
+    connect(&ImageCache::instance(), &ImageCache::imageReady, this, &LibraryModel::onCoverLoaded);
+    // Nothing to repaint on failure, the placeholder stays; just stop waiting
+    connect(&ImageCache::instance(), &ImageCache::imageFailed, this,
+            [this](const QString &url) { coverWaiters_.remove(url); });
 }
 
-LibraryModel::~LibraryModel() {}
+LibraryModel::~LibraryModel() = default;
 
 int LibraryModel::rowCount(const QModelIndex &parent) const {
-    Q_UNUSED(parent)
-    return gameNames.size();
+    if (parent.isValid() || !snapshot_) return 0;
+    return static_cast<int>(snapshot_->size());
 }
 
 QVariant LibraryModel::data(const QModelIndex &index, int role) const {
-    if (!index.isValid() || index.row() >= gameNames.size()) return QVariant();
+    if (!index.isValid() || !snapshot_ || index.row() >= rowCount()) return QVariant();
+
+    const api::GameInfo &game = *snapshot_->games()[index.row()];
+    const CardState state = states_.value(game.id);
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case TitleRole:
+        return game.title;
+    case GameIdRole:
+        return game.id;
+    case PlatformRole:
+        return game.platform;
+    case CoverUrlRole:
+        return game.coverUrl;
+    case CoverRole: {
+        const QPixmap cover = ImageCache::instance().pixmap(game.coverUrl, coverSize());
+        if (cover.isNull() && ImageCache::instance().isLoading(game.coverUrl)) {
+            QStringList &waiting = coverWaiters_[game.coverUrl];
+            if (!waiting.contains(game.id)) waiting.append(game.id);
+        }
+        return cover;
+    }
+    case InstalledRole:
+        return game.isInstalled;
+    case InstallingRole:
+        return state.installing;
+    case UpdatingRole:
+        return state.updating;
+    case ProgressRole:
+        return state.progress;
+    case TransferRole:
+        return state.transfer;
+    case UpdateAvailableRole:
+        return state.updateAvailable;
+    case NewVersionRole:
+        return state.newVersion;
+    case RepairNeededRole:
+        return state.repairNeeded;
+    case UnreleasedRole:
+        return game.releaseDate.isValid() && game.releaseDate > QDateTime::currentDateTime();
+    case HiddenRole:
+        return game.hiddenInLibrary;
+    case RunningRole:
+        return state.running;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LibraryModel::roleNames() const {
+    return {
+        {GameIdRole, "gameId"},
+        {TitleRole, "title"},
+        {PlatformRole, "platform"},
+        {CoverUrlRole, "coverUrl"},
+        {CoverRole, "cover"},
+        {InstalledRole, "installed"},
+        {InstallingRole, "installing"},
+        {UpdatingRole, "updating"},
+        {ProgressRole, "progress"},
+        {TransferRole, "transfer"},
+        {UpdateAvailableRole, "updateAvailable"},
+        {NewVersionRole, "newVersion"},
+        {RepairNeededRole, "repairNeeded"},
+        {UnreleasedRole, "unreleased"},
+        {HiddenRole, "hidden"},
+        {RunningRole, "running"},
+    };
+}
+
+void LibraryModel::setSnapshot(library::LibrarySnapshotPtr snapshot) {
+    beginResetModel();
+    snapshot_ = std::move(snapshot);
+    coverWaiters_.clear();
+    // Failed covers get another chance whenever the library is refreshed
+    ImageCache::instance().retryFailed();
+    endResetModel();
+}
+
+void LibraryModel::updateGame(library::LibrarySnapshotPtr snapshot, const QString &gameId) {
+    const int row = snapshot_ ? snapshot_->indexOf(gameId) : -1;
+
+    // Only the next snapshot (or this one again, for the other games a reload
+    // updated) can be patched in place, and only if it kept every row where it
+    // was; a reload that also added or removed games resets the model
+    if (row < 0 || !snapshot || snapshot->version() > snapshot_->version() + 1 ||
+        !sameRows(*snapshot_, *snapshot)) {
+        setSnapshot(std::move(snapshot));
+        return;
+    }
+
+    snapshot_ = std::move(snapshot);
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx);
+}
+
+bool LibraryModel::sameRows(const library::LibrarySnapshot &a, const library::LibrarySnapshot &b) {
+    if (a.size() != b.size()) return false;
+    const auto &before = a.games();
+    const auto &after = b.games();
+    for (size_t i = 0; i < before.size(); ++i) {
+        if (before[i] != after[i] && before[i]->id != after[i]->id) return false;
+    }
+    return true;
+}
+
+QModelIndex LibraryModel::indexForGame(const QString &gameId) const {
+    const int row = snapshot_ ? snapshot_->indexOf(gameId) : -1;
+    return row >= 0 ? index(row) : QModelIndex();
+}
+
+void LibraryModel::setInstalling(const QString &gameId, bool installing) {
+    CardState &state = states_[gameId];
+    state.installing = installing;
+    if (!installing) {
+        state.progress = 0;
+        state.transfer.clear();
+    }
+    notifyGameChanged(gameId, {InstallingRole, ProgressRole, TransferRole});
+}
 
-    if (role == GameNameRole) return gameNames.at(index.row());
+void LibraryModel::setUpdating(const QString &gameId, bool updating) {
+    CardState &state = states_[gameId];
+    state.updating = updating;
+    if (!updating) state.progress = 0;
+    notifyGameChanged(gameId, {UpdatingRole, ProgressRole});
+}
+
+void LibraryModel::setInstallProgress(const QString &gameId, int percent) {
+    const int progress = std::clamp(percent, 0, 100);
+    CardState &state = states_[gameId];
+    if (state.progress == progress) return;
+    state.progress = progress;
+    notifyGameChanged(gameId, {ProgressRole});
+}
+
+void LibraryModel::setInstallTransfer(const QString &gameId, const QString &text) {
+    CardState &state = states_[gameId];
+    if (state.transfer == text) return;
+    state.transfer = text;
+    notifyGameChanged(gameId, {TransferRole});
+}
+
+void LibraryModel::setUpdateAvailable(const QString &gameId, bool available,
+                                      const QString &newVersion) {
+    CardState &state = states_[gameId];
+    state.updateAvailable = available;
+    state.newVersion = newVersion;
+    notifyGameChanged(gameId, {UpdateAvailableRole, NewVersionRole});
+}
+
+void LibraryModel::setRepairNeeded(const QString &gameId, bool needed) {
+    states_[gameId].repairNeeded = needed;
+    notifyGameChanged(gameId, {RepairNeededRole});
+}
+
+void LibraryModel::setRunning(const QString &gameId, bool running) {
+    states_[gameId].running = running;
+    notifyGameChanged(gameId, {RunningRole});
+}
+
+void LibraryModel::notifyGameChanged(const QString &gameId, const QList<int> &roles) {
+    const QModelIndex idx = indexForGame(gameId);
+    if (idx.isValid()) {
+        emit dataChanged(idx, idx, roles);
+    }
+}
+
+void LibraryModel::prefetchCover(const QModelIndex &index) {
+    if (!index.isValid() || !snapshot_ || index.row() >= rowCount()) return;
+
+    const api::GameInfo &game = *snapshot_->games()[index.row()];
+    ImageCache &cache = ImageCache::instance();
+    if (!cache.pixmap(game.coverUrl, coverSize(), ImageCache::Prefetch).isNull()) return;
+
+    if (cache.isLoading(game.coverUrl)) {
+        QStringList &waiting = coverWaiters_[game.coverUrl];
+        if (!waiting.contains(game.id)) waiting.append(game.id);
+    }
+}
+
+void LibraryModel::cancelCoversExcept(const QSet<QString> &keep) {
+    for (auto it = coverWaiters_.begin(); it != coverWaiters_.end();) {
+        if (keep.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        ImageCache::instance().cancel(it.key());
+        it = coverWaiters_.erase(it);
+    }
+}
 
-    return QVariant();
+void LibraryModel::onCoverLoaded(const QString &url) {
+    const QStringList gameIds = coverWaiters_.take(url);
+    for (const QString &gameId : gameIds) {
+        notifyGameChanged(gameId, {CoverRole});
+    }
 }
 
 } // namespace ui
@@ -2,10 +2,25 @@
 #define LIBRARY_MODEL_H
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+
+#include "opengalaxy/library/library_snapshot.h"
 
 namespace opengalaxy {
 namespace ui {
 
+/**
+ * Library grid model: one row per game in a LibrarySnapshot, plus the
+ * transient per-card state (install progress, pending update) that does not
+ * live in the library database.
+ *
+ * Covers are requested from the shared ImageCache the first time a view asks
+ * for CoverRole, i.e. when the card is actually painted, so memory and
+ * network traffic follow the viewport rather than the size of the library.
+ */
 class LibraryModel : public QAbstractListModel {
     Q_OBJECT
 
@@ -13,13 +28,76 @@ class LibraryModel : public QAbstractListModel {
     explicit LibraryModel(QObject *parent = nullptr);
     ~LibraryModel();
 
-    enum Roles { GameNameRole = Qt::UserRole + 1 };
+    enum Roles {
+        GameIdRole = Qt::UserRole + 1,
+        TitleRole,
+        PlatformRole,
+        CoverUrlRole,
+        CoverRole, // QPixmap, null until loaded
+        InstalledRole,
+        InstallingRole,
+        UpdatingRole,
+        ProgressRole,
+        TransferRole, // "12.4 MB/s, 3m left" while downloading
+        UpdateAvailableRole,
+        NewVersionRole,
+        RepairNeededRole,
+        UnreleasedRole,
+        HiddenRole,
+        RunningRole
+    };
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Replace the whole library (resets the model)
+    void setSnapshot(library::LibrarySnapshotPtr snapshot);
+    // Adopt a newer snapshot in which gameId changed; resets the model if rows
+    // were added, removed or moved as well
+    void updateGame(library::LibrarySnapshotPtr snapshot, const QString &gameId);
+    library::LibrarySnapshotPtr snapshot() const { return snapshot_; }
+
+    static QSize coverSize() { return QSize(420, 220); }
+
+    // Start loading a cover that is about to scroll into view
+    void prefetchCover(const QModelIndex &index);
+    // Cancel cover loads this model started for any url not in keep
+    void cancelCoversExcept(const QSet<QString> &keep);
+
+    QModelIndex indexForGame(const QString &gameId) const;
+
+    void setInstalling(const QString &gameId, bool installing);
+    void setUpdating(const QString &gameId, bool updating);
+    void setInstallProgress(const QString &gameId, int percent);
+    void setInstallTransfer(const QString &gameId, const QString &text);
+    void setUpdateAvailable(const QString &gameId, bool available,
+                            const QString &newVersion = QString());
+    void setRepairNeeded(const QString &gameId, bool needed);
+    void setRunning(const QString &gameId, bool running);
 
   private:
-    QStringList gameNames;
+    struct CardState {
+        bool installing = false;
+        bool updating = false;
+        int progress = 0;
+        QString transfer;
+        bool updateAvailable = false;
+        QString newVersion;
+        bool repairNeeded = false;
+        bool running = false;
+    };
+
+    // Same games at the same rows; their data may differ
+    static bool sameRows(const library::LibrarySnapshot &a, const library::LibrarySnapshot &b);
+    void notifyGameChanged(const QString &gameId, const QList<int> &roles);
+    void onCoverLoaded(const QString &url);
+
+    library::LibrarySnapshotPtr snapshot_;
+    QHash<QString, CardState> states_;
+
+    // Cover url -> games painted while it was still loading
+    mutable QHash<QString, QStringList> coverWaiters_;
 };
 
 } // namespace ui
@@ -6,13 +6,21 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QMenu>
 #include <QMessageBox>
-#include <QScrollArea>
+#include <QProcess>
+#include <QScrollBar>
+#include <QShowEvent>
 #include <QVBoxLayout>
 
 #include "../dialogs/game_details_dialog.h"
 #include "../dialogs/game_information_dialog.h"
-#include "../widgets/game_card.h"
+#include "../models/library_filter_model.h"
+#include "../models/library_model.h"
+#include "../services/details_prefetcher.h"
+#include "../widgets/frame_time_overlay.h"
+#include "../widgets/game_card_delegate.h"
+#include "../widgets/library_grid_view.h"
 #include "../widgets/notification_widget.h"
 #include "opengalaxy/util/config.h"
 
@@ -65,26 +73,140 @@ LibraryPage::LibraryPage(api::Session *session, QWidget *parent)
     )");
     headerLayout->addWidget(searchBox_);
 
-    // Connect search box to filter function
-    connect(searchBox_, &QLineEdit::textChanged, this, &LibraryPage::filterGames);
+    // Filter once typing pauses rather than on every keystroke
+    searchDebounce_.setSingleShot(true);
+    searchDebounce_.setInterval(120);
+    connect(searchBox_, &QLineEdit::textChanged, &searchDebounce_,
+            qOverload<>(&QTimer::start));
+    connect(&searchDebounce_, &QTimer::timeout, this,
+            [this]() { filterGames(searchBox_->text()); });
+
+    connect(&libraryService_, &library::LibraryService::gameUpdated, this,
+            &LibraryPage::onGameUpdated);
 
     mainLayout->addLayout(headerLayout);
 
-    // Scroll area
-    QScrollArea *scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setStyleSheet("QScrollArea { background: transparent; border: none; }");
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    // Game grid: one model row per game, painted by the delegate. Only visible cards cost
+    // anything, so the grid scales to any library size.
+    model_ = new LibraryModel(this);
+    filter_ = new LibraryFilterModel(this);
+    filter_->setSourceModel(model_);
+    filter_->setShowHiddenGames(opengalaxy::util::Config::instance().showHiddenGames());
+    delegate_ = new GameCardDelegate(this);
+
+    gameView_ = new LibraryGridView(this);
+    gameView_->setModel(filter_);
+    gameView_->setItemDelegate(delegate_);
+    // Plus the delegate's shadow margin, this matches the old 30px grid spacing
+    gameView_->setCellSize(delegate_->sizeHint(QStyleOptionViewItem(), QModelIndex()) +
+                           QSize(14, 14));
+    gameView_->setMouseTracking(true);
+    gameView_->viewport()->setAttribute(Qt::WA_Hover); // Hover lift and overlay buttons
+    gameView_->viewport()->setCursor(Qt::PointingHandCursor);
+    gameView_->setContextMenuPolicy(Qt::CustomContextMenu);
+    gameView_->setStyleSheet("QListView { background: transparent; border: none; }");
+    mainLayout->addWidget(gameView_, 1);
+
+    connect(delegate_, &GameCardDelegate::detailsRequested, this, &LibraryPage::openGameDetails);
+    connect(delegate_, &GameCardDelegate::playRequested, this, &LibraryPage::launchGame);
+    connect(delegate_, &GameCardDelegate::stopRequested, this, &LibraryPage::stopGame);
+    connect(delegate_, &GameCardDelegate::installRequested, this, &LibraryPage::installGame);
+    connect(delegate_, &GameCardDelegate::cancelInstallRequested, this,
+            &LibraryPage::cancelInstall);
+    connect(delegate_, &GameCardDelegate::updateRequested, this, &LibraryPage::updateGame);
+    connect(gameView_, &QWidget::customContextMenuRequested, this,
+            &LibraryPage::showCardContextMenu);
+
+    // Hover lift is animated by the delegate, which repaints only the cards that move
+    connect(gameView_, &LibraryGridView::hoveredIndexChanged, delegate_,
+            &GameCardDelegate::setHoveredIndex);
+    gameView_->setPaintOverflow(GameCardDelegate::paintOverflow());
+    connect(delegate_, &GameCardDelegate::repaintRequested, gameView_,
+            &LibraryGridView::repaintItem);
+
+    // Resting on a card for a moment warms what its dialogs will show
+    prefetcher_ = new DetailsPrefetcher(&gogClient_, &libraryService_, this);
+    connect(gameView_, &LibraryGridView::hoveredIndexChanged, prefetcher_,
+            [this](const QModelIndex &index) {
+                prefetcher_->hoverGame(index.data(LibraryModel::GameIdRole).toString());
+            });
+
+    // On top of the view rather than the viewport, which moves its children when scrolling
+    frameStats_ = new FrameTimeOverlay(gameView_);
+    frameStats_->hide();
+    connect(gameView_, &LibraryGridView::framePainted, frameStats_,
+            &FrameTimeOverlay::addSample);
+
+    // Covers on screen are requested as they are painted; this adds the next screen in
+    // the scroll direction and drops loads for cards that scrolled far away
+    coverRequests_.setSingleShot(true);
+    coverRequests_.setInterval(30);
+    connect(&coverRequests_, &QTimer::timeout, this, &LibraryPage::updateCoverRequests);
+    connect(gameView_->verticalScrollBar(), &QScrollBar::valueChanged, &coverRequests_,
+            qOverload<>(&QTimer::start));
+    connect(filter_, &QAbstractItemModel::layoutChanged, &coverRequests_,
+            qOverload<>(&QTimer::start));
+    connect(filter_, &QAbstractItemModel::modelReset, &coverRequests_,
+            qOverload<>(&QTimer::start));
+    connect(filter_, &QAbstractItemModel::rowsRemoved, &coverRequests_,
+            qOverload<>(&QTimer::start));
+
+    // Install progress
+    connect(&installService_, &install::InstallService::installStarted, this,
+            [this](const QString &gameId) {
+                model_->setInstalling(gameId, true);
+                NotificationWidget::showToast("Installing...", this);
+            });
+
+    connect(&installService_, &install::InstallService::installProgress, this,
+            [this](const QString &gameId, int percentage) {
+                model_->setInstallProgress(gameId, percentage);
+            });
+    connect(&installService_, &install::InstallService::installTransferStats, this,
+            [this](const QString &gameId, const install::TransferStats::Snapshot &stats) {
+                model_->setInstallTransfer(gameId, stats.toString());
+            });
+
+    // The prefix needs the game's executable, which is indexed after install
+    connect(&libraryService_, &library::LibraryService::executablesIndexed, this,
+            [this](const QString &gameId) {
+                if (prewarmPending_.remove(gameId)) prewarmPrefix(gameId);
+            });
+
+    connect(&supervisor_, &runners::GameProcessSupervisor::gameStarted, this,
+            [this](const QString &gameId) { model_->setRunning(gameId, true); });
+    connect(&supervisor_, &runners::GameProcessSupervisor::gameExited, this,
+            [this](const QString &gameId) { model_->setRunning(gameId, false); });
+
+    connect(
+        &installService_, &install::InstallService::installCompleted, this,
+        [this](const QString &gameId, const QString &installPath, const QString &detectedRunner) {
+            model_->setInstalling(gameId, false);
+            // Installed state comes back through gameUpdated
+            if (opengalaxy::util::Config::instance().prewarmPrefixes()) {
+                prewarmPending_.insert(gameId);
+            }
+            libraryService_.updateGameInstallation(gameId, installPath, "");
+
+            // Save the auto-detected runner if one was found
+            if (!detectedRunner.isEmpty()) {
+                libraryService_.getGame(gameId, [this, gameId, detectedRunner](auto result) {
+                    if (result.isOk()) {
+                        auto game = result.value();
+                        game.preferredRunner = detectedRunner;
+                        libraryService_.updateGameProperties(game);
+                    }
+                });
+            }
 
-    QWidget *scrollWidget = new QWidget(scrollArea);
-    gameGrid = new QGridLayout(scrollWidget);
-    gameGrid->setSpacing(30);                             // Spacing between cards
-    gameGrid->setContentsMargins(0, 0, 0, 20);            // Add bottom margin
-    gameGrid->setAlignment(Qt::AlignTop | Qt::AlignLeft); // Align to top-left
+            NotificationWidget::showToast("Install completed", this);
+        });
 
-    scrollArea->setWidget(scrollWidget);
-    mainLayout->addWidget(scrollArea, 1); // Give scroll area stretch factor
+    connect(&installService_, &install::InstallService::installFailed, this,
+            [this](const QString &gameId, const QString &error) {
+                model_->setInstalling(gameId, false);
+                NotificationWidget::showToast("Install failed: " + error, this);
+            });
 
     // Background
     setStyleSheet(R"(
@@ -127,136 +249,22 @@ void LibraryPage::refreshLibrary(bool forceRefresh) {
 
             qDebug() << "LibraryPage - Loaded" << result.value().size() << "games";
 
-            // Store all games for filtering (deduplicate by ID)
-            allGames_.clear();
-            QSet<QString> seenIds;
-
-            for (const auto &game : result.value()) {
-                // Skip duplicates (same game ID)
-                if (seenIds.contains(game.id)) {
-                    qDebug() << "  - Skipping duplicate:" << game.title << "(" << game.id << ")";
-                    continue;
-                }
-
-                seenIds.insert(game.id);
-                allGames_.append(game);
-                qDebug() << "  -" << game.title << "(" << game.id << ")" << game.platform;
-            }
-
-            qDebug() << "LibraryPage - After deduplication:" << allGames_.size() << "unique games";
-
-            // Clear existing cards completely
-            qDebug() << "Clearing" << cardsById_.size() << "existing cards";
-
-            // First, hide and remove all card widgets
-            for (auto it = cardsById_.begin(); it != cardsById_.end(); ++it) {
-                GameCard *card = it.value();
-                gameGrid->removeWidget(card); // Remove from layout first
-                card->setVisible(false);      // Hide immediately
-                card->setParent(nullptr);     // Remove parent relationship
-                delete card;                  // Delete immediately
-            }
-            cardsById_.clear();
-
-            // Then clear any remaining layout items
-            while (QLayoutItem *item = gameGrid->takeAt(0)) {
-                delete item;
-            }
-
-            // Force layout update
-            gameGrid->update();
-            gameGrid->parentWidget()->update();
-
-            qDebug() << "All cards cleared";
-
-            // Create cards for all games
-            for (const auto &game : allGames_) {
-                auto *card = new GameCard(game.id, game.title, game.platform, game.coverUrl,
-                                          game.releaseDate, gameGrid->parentWidget());
-                card->setInstalled(game.isInstalled);
-                card->show(); // Explicitly show the card
-
-                connect(card, &GameCard::detailsRequested, this, &LibraryPage::openGameDetails);
-                connect(card, &GameCard::playRequested, this, &LibraryPage::launchGame);
-                connect(card, &GameCard::installRequested, this, &LibraryPage::installGame);
-                connect(card, &GameCard::cancelInstallRequested, this, &LibraryPage::cancelInstall);
-                connect(card, &GameCard::updateRequested, this, &LibraryPage::updateGame);
-                connect(card, &GameCard::informationRequested, this,
-                        &LibraryPage::showGameInformation);
-                connect(card, &GameCard::propertiesRequested, this,
-                        &LibraryPage::openGameProperties);
-
-                cardsById_.insert(game.id, card);
-
-                // Check for updates if game is installed
-                if (game.isInstalled) {
-                    checkForUpdate(game.id);
-                }
-            }
-
-            qDebug() << "Created" << cardsById_.size() << "game cards";
+            // The service's snapshot is keyed by id and carries install state and properties
+            model_->setSnapshot(libraryService_.snapshot());
 
-            // Update grid layout with all cards
-            updateGridLayout();
-
-            qDebug() << "Grid layout updated";
-
-            // Apply current search filter if any
-            if (searchBox_ && !searchBox_->text().isEmpty()) {
-                filterGames(searchBox_->text());
-            } else {
-                qDebug() << "No search filter, showing all" << cardsById_.size() << "games";
-            }
-        });
-
-    // Install progress
-    connect(&installService_, &install::InstallService::installStarted, this,
-            [this](const QString &gameId) {
-                if (cardsById_.contains(gameId)) {
-                    cardsById_[gameId]->setInstalling(true);
-                    cardsById_[gameId]->setInstallProgress(0);
-                }
-                NotificationWidget::showToast("Installing...", this);
-            });
+            qDebug() << "LibraryPage - Snapshot v" << model_->snapshot()->version() << "with"
+                     << model_->rowCount() << "unique games";
 
-    connect(&installService_, &install::InstallService::installProgress, this,
-            [this](const QString &gameId, int percentage) {
-                if (cardsById_.contains(gameId)) {
-                    cardsById_[gameId]->setInstallProgress(percentage);
+            // Check for updates on installed games
+            for (const auto &game : model_->snapshot()->games()) {
+                if (game->isInstalled) {
+                    checkForUpdate(game->id);
                 }
-            });
-
-    connect(
-        &installService_, &install::InstallService::installCompleted, this,
-        [this](const QString &gameId, const QString &installPath, const QString &detectedRunner) {
-            if (cardsById_.contains(gameId)) {
-                cardsById_[gameId]->setInstalling(false);
-                cardsById_[gameId]->setInstalled(true);
-            }
-            libraryService_.updateGameInstallation(gameId, installPath, "");
-
-            // Save the auto-detected runner if one was found
-            if (!detectedRunner.isEmpty()) {
-                libraryService_.getGame(gameId, [this, gameId, detectedRunner](auto result) {
-                    if (result.isOk()) {
-                        auto game = result.value();
-                        game.preferredRunner = detectedRunner;
-                        libraryService_.updateGameProperties(game);
-                    }
-                });
             }
 
-            NotificationWidget::showToast("Install completed", this);
+            // The games most likely to be opened next
+            prefetcher_->prefetchRecentlyPlayed(5);
         });
-
-    connect(&installService_, &install::InstallService::installFailed, this,
-            [this](const QString &gameId, const QString &error) {
-                if (cardsById_.contains(gameId)) {
-                    cardsById_[gameId]->setInstalling(false);
-                    cardsById_[gameId]->setInstallProgress(0);
-                }
-                NotificationWidget::showToast("Install failed: " + error, this);
-            });
 }
 
 void LibraryPage::openGameDetails(const QString &gameId) {
@@ -315,13 +323,60 @@ void LibraryPage::launchGame(const QString &gameId) {
             QMessageBox::information(this, "Not installed", "Game is not installed yet.");
             return;
         }
+        if (supervisor_.isRunning(game.id) || launchPending_.contains(game.id)) {
+            QMessageBox::information(this, "Already running", "This game is already running.");
+            return;
+        }
 
-        runners::LaunchConfig cfg;
-        cfg.gamePath = game.installPath;
-        cfg.workingDirectory = QFileInfo(game.installPath).absolutePath();
-        cfg.arguments = {}; // Game arguments (can be extended later)
-        cfg.environment = game.extraEnvironment;
+        // Answers at once from the index; a game without one is indexed on a worker first
+        launchPending_.insert(game.id);
+        libraryService_.primaryExecutable(game.id, [this, game](auto target) {
+            launchPending_.remove(game.id);
+
+            runners::LaunchConfig cfg = launchConfig(game, target);
+            runners::GameProcessSupervisor::tagLaunch(cfg, game.id);
+
+            runners::Runner *runner = runnerFor(game, cfg);
+            if (!runner) {
+                QMessageBox::warning(this, "No runner", "No suitable runner found for this game.");
+                return;
+            }
 
+            auto proc = runner->launch(cfg);
+            if (!proc) {
+                QMessageBox::warning(this, "Launch failed", "Failed to start game process.");
+                return;
+            }
+
+            libraryService_.trackPlaySession(game.id, runner->name(), &supervisor_);
+            supervisor_.supervise(game.id, std::move(proc));
+        });
+    });
+}
+
+runners::LaunchConfig
+LibraryPage::launchConfig(const api::GameInfo &game,
+                          const util::Result<library::GameExecutable> &target) {
+    // Without an indexed executable the runner gets the install directory (only
+    // DOSBox can do anything with that)
+    runners::LaunchConfig cfg;
+    if (target.isOk()) {
+        cfg.gamePath = target.value().path;
+        cfg.workingDirectory = target.value().workingDirectory;
+        cfg.arguments = QProcess::splitCommand(target.value().arguments);
+    } else {
+        cfg.gamePath = game.installPath;
+        cfg.workingDirectory = game.installPath;
+    }
+    cfg.installPath = game.installPath;
+    cfg.environment = game.extraEnvironment;
+    cfg.profile = game.launchProfile;
+    cfg.gameMode = game.enableGameMode;
+
+    // The binary knows best (DOS games are sold as Windows games); the catalogue
+    // platform covers scripts and anything unrecognised
+    cfg.gamePlatform = runners::Runner::detectPlatform(cfg.gamePath);
+    if (cfg.gamePlatform == runners::Platform::Unknown) {
         const QString p = game.platform.toLower();
         if (p.contains("windows"))
             cfg.gamePlatform = runners::Platform::Windows;
@@ -329,37 +384,57 @@ void LibraryPage::launchGame(const QString &gameId) {
             cfg.gamePlatform = runners::Platform::MacOS;
         else
             cfg.gamePlatform = runners::Platform::Linux;
+    }
+
+    // Detect game architecture from binary
+    cfg.gameArch = runners::Runner::detectArchitecture(cfg.gamePath);
 
-        // Detect game architecture from binary
-        cfg.gameArch = runners::Runner::detectArchitecture(game.installPath);
+    // Wire up custom runner settings
+    cfg.runnerExecutableOverride = game.runnerExecutable.trimmed();
+    cfg.runnerArguments = game.runnerArguments; // Already a QStringList
+    return cfg;
+}
 
-        // Wire up custom runner settings
-        cfg.runnerExecutableOverride = game.runnerExecutable.trimmed();
-        cfg.runnerArguments = game.runnerArguments; // Already a QStringList
+runners::Runner *LibraryPage::runnerFor(const api::GameInfo &game,
+                                        const runners::LaunchConfig &cfg) {
+    // First run: nothing cached yet and the background scan may still be going
+    if (!runnerManager_.isReady()) runnerManager_.discoverRunners();
 
-        runners::Runner *runner = nullptr;
-        if (!game.preferredRunner.trimmed().isEmpty()) {
-            runner = runnerManager_.getRunner(game.preferredRunner.trimmed());
-        }
-        if (!runner) {
-            runner = runnerManager_.findBestRunner(cfg);
-        }
+    runners::Runner *runner = nullptr;
+    if (!game.preferredRunner.trimmed().isEmpty()) {
+        runner = runnerManager_.getRunner(game.preferredRunner.trimmed());
+    }
+    if (!runner) {
+        runner = runnerManager_.findBestRunner(cfg);
+    }
+    return runner;
+}
 
-        if (!runner) {
-            QMessageBox::warning(this, "No runner", "No suitable runner found for this game.");
-            return;
-        }
+void LibraryPage::prewarmPrefix(const QString &gameId) {
+    libraryService_.getGame(gameId, [this](auto result) {
+        if (!result.isOk() || result.value().installPath.isEmpty()) return;
 
-        auto proc = runner->launch(cfg);
-        if (!proc) {
-            QMessageBox::warning(this, "Launch failed", "Failed to start game process.");
-            return;
-        }
+        const api::GameInfo game = result.value();
+        libraryService_.primaryExecutable(game.id, [this, game](auto target) {
+            const runners::LaunchConfig cfg = launchConfig(game, target);
+            runners::Runner *runner = runnerFor(game, cfg);
+            if (!runner) return;
 
-        proc.release();
+            // Only Wine and Proton have one; the first launch then skips wineboot
+            if (const auto spec = runner->prefix(cfg)) prefixManager_.prewarm(*spec);
+        });
     });
 }
 
+void LibraryPage::stopGame(const QString &gameId) {
+    const auto answer = QMessageBox::question(
+        this, "Stop game", "Stop the game? Unsaved progress will be lost.",
+        QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+    if (answer == QMessageBox::Yes) {
+        supervisor_.stop(gameId);
+    }
+}
+
 void LibraryPage::installGame(const QString &gameId) {
     // Use default installation directory: ~/Games/OpenGalaxy
     QString homeDir = QDir::homePath();
@@ -385,48 +460,52 @@ void LibraryPage::installGame(const QString &gameId) {
 
     const QString installDir = dir.absoluteFilePath("OpenGalaxy");
 
-    gogClient_.fetchGameDownloads(
-        gameId, [this, installDir, gameId](opengalaxy::util::Result<api::GameInfo> result) {
+    // Start from the cached installer metadata when we have it
+    libraryService_.getGame(gameId, [this, installDir, gameId](auto cached) {
+        if (cached.isOk() && !cached.value().downloads.empty()) {
+            startInstall(cached.value(), installDir);
+            return;
+        }
+
+        gogClient_.fetchGameDownloads(gameId, [this, installDir, gameId, cached](
+                                                  opengalaxy::util::Result<api::GameInfo> result) {
             if (!result.isOk()) {
                 QMessageBox::warning(this, "Install", result.errorMessage());
                 return;
             }
 
-            api::GameInfo game = result.value();
+            libraryService_.cacheGameDownloads(gameId, result.value().downloads);
 
-            // Keep title/platform from cached library row
-            libraryService_.getGame(gameId, [this, installDir, game, gameId](auto cached) mutable {
-                if (cached.isOk()) {
-                    game.platform = cached.value().platform;
-                    game.title = cached.value().title;
-                }
+            // Keep title/platform/genres from cached library row
+            api::GameInfo game = cached.isOk() ? cached.value() : result.value();
+            game.downloads = result.value().downloads;
+            startInstall(game, installDir);
+        });
+    });
+}
 
-                // Set up progress callback
-                auto progressCallback =
-                    [this, gameId](const install::InstallService::InstallProgress &progress) {
-                        if (cardsById_.contains(gameId)) {
-                            cardsById_[gameId]->setInstallProgress(progress.percentage);
-                        }
-                    };
+void LibraryPage::startInstall(const api::GameInfo &game, const QString &installDir) {
+    const QString gameId = game.id;
 
-                // Set up completion callback (signals handle the rest)
-                auto completionCallback = [](util::Result<QString> result) {
-                    // Signals installCompleted/installFailed are already emitted by InstallService
-                    Q_UNUSED(result);
-                };
+    // Set up progress callback
+    auto progressCallback =
+        [this, gameId](const install::InstallService::InstallProgress &progress) {
+            model_->setInstallProgress(gameId, progress.percentage);
+        };
 
-                installService_.installGame(game, installDir, progressCallback, completionCallback);
-            });
-        });
+    // Set up completion callback (signals handle the rest)
+    auto completionCallback = [](util::Result<QString> result) {
+        // Signals installCompleted/installFailed are already emitted by InstallService
+        Q_UNUSED(result);
+    };
+
+    installService_.installGame(game, installDir, progressCallback, completionCallback);
 }
 
 void LibraryPage::cancelInstall(const QString &gameId) {
     installService_.cancelInstallation(gameId);
-    if (cardsById_.contains(gameId)) {
-        cardsById_[gameId]->setInstalling(false);
-        cardsById_[gameId]->setUpdating(false);
-        cardsById_[gameId]->setInstallProgress(0);
-    }
+    model_->setInstalling(gameId, false);
+    model_->setUpdating(gameId, false);
     NotificationWidget::showToast("Install cancelled", this);
 }
 
@@ -453,6 +532,7 @@ void LibraryPage::checkForUpdate(const QString &gameId) {
                 }
 
                 api::GameInfo latestInfo = downloadResult.value();
+                libraryService_.cacheGameDownloads(gameId, latestInfo.downloads);
 
                 // Find the latest version from downloads
                 QString latestVersion;
@@ -470,9 +550,7 @@ void LibraryPage::checkForUpdate(const QString &gameId) {
                     qDebug() << "Update available for" << currentGame.title
                              << "- Current:" << currentGame.version << "Latest:" << latestVersion;
 
-                    if (cardsById_.contains(gameId)) {
-                        cardsById_[gameId]->setUpdateAvailable(true, latestVersion);
-                    }
+                    model_->setUpdateAvailable(gameId, true, latestVersion);
                 }
             });
     });
@@ -494,10 +572,7 @@ void LibraryPage::updateGame(const QString &gameId) {
         }
 
         // Mark as updating
-        if (cardsById_.contains(gameId)) {
-            cardsById_[gameId]->setUpdating(true);
-            cardsById_[gameId]->setInstallProgress(0);
-        }
+        model_->setUpdating(gameId, true);
 
         NotificationWidget::showToast("Updating game...", this);
 
@@ -508,14 +583,13 @@ void LibraryPage::updateGame(const QString &gameId) {
         gogClient_.fetchGameDownloads(gameId, [this, installDir, gameId, currentGame](
                                                   opengalaxy::util::Result<api::GameInfo> result) {
             if (!result.isOk()) {
-                if (cardsById_.contains(gameId)) {
-                    cardsById_[gameId]->setUpdating(false);
-                }
+                model_->setUpdating(gameId, false);
                 QMessageBox::warning(this, "Update Error", result.errorMessage());
                 return;
             }
 
             api::GameInfo game = result.value();
+            libraryService_.cacheGameDownloads(gameId, game.downloads);
 
             // Keep title/platform from current game
             game.platform = currentGame.platform;
@@ -524,26 +598,21 @@ void LibraryPage::updateGame(const QString &gameId) {
             // Set up progress callback
             auto progressCallback =
                 [this, gameId](const install::InstallService::InstallProgress &progress) {
-                    if (cardsById_.contains(gameId)) {
-                        cardsById_[gameId]->setInstallProgress(progress.percentage);
-                    }
+                    model_->setInstallProgress(gameId, progress.percentage);
                 };
 
             // Set up completion callback
             auto completionCallback = [this, gameId](util::Result<QString> result) {
-                if (cardsById_.contains(gameId)) {
-                    cardsById_[gameId]->setUpdating(false);
+                model_->setUpdating(gameId, false);
 
-                    if (result.isOk()) {
-                        cardsById_[gameId]->setUpdateAvailable(false);
-                        NotificationWidget::showToast("Update completed", this);
-
-                        // Refresh game info to get new version
-                        checkForUpdate(gameId);
-                    } else {
-                        NotificationWidget::showToast("Update failed: " + result.errorMessage(),
-                                                      this);
-                    }
+                if (result.isOk()) {
+                    model_->setUpdateAvailable(gameId, false);
+                    NotificationWidget::showToast("Update completed", this);
+
+                    // Refresh game info to get new version
+                    checkForUpdate(gameId);
+                } else {
+                    NotificationWidget::showToast("Update failed: " + result.errorMessage(), this);
                 }
             };
 
@@ -553,110 +622,89 @@ void LibraryPage::updateGame(const QString &gameId) {
     });
 }
 
-void LibraryPage::filterGames(const QString &searchText) {
-    QString search = searchText.trimmed().toLower();
-
-    // Load current setting
-    showHiddenGames_ = opengalaxy::util::Config::instance().showHiddenGames();
-
-    qDebug() << "Filtering games with search:" << search << "showHiddenGames:" << showHiddenGames_;
-    qDebug() << "Total cards:" << cardsById_.size();
-
-    int visibleCount = 0;
+void LibraryPage::onGameUpdated(const QString &gameId) {
+    // Hiding a game from its properties dialog reaches the filter as a data change
+    if (model_->snapshot()) {
+        model_->updateGame(libraryService_.snapshot(), gameId);
+    }
+}
 
-    // Show/hide cards based on search and hidden status
-    for (auto it = cardsById_.begin(); it != cardsById_.end(); ++it) {
-        GameCard *card = it.value();
+void LibraryPage::showCardContextMenu(const QPoint &pos) {
+    const QModelIndex index = gameView_->indexAt(pos);
+    if (!index.isValid()) return;
+    const QString gameId = index.data(LibraryModel::GameIdRole).toString();
 
-        // Find the game info
-        bool isHidden = false;
-        QString gameTitle;
-        for (const auto &game : allGames_) {
-            if (game.id == it.key()) {
-                gameTitle = game.title;
-                isHidden = game.hiddenInLibrary;
-                break;
-            }
+    QMenu menu;
+    menu.setStyleSheet(R"(
+        QMenu {
+                background: #f8f7f5;
+                color: #3c3a37;
+                border: 1px solid #e8e6e3;
+                border-radius: 6px;
+                padding: 4px;
         }
-
-        // Check if game should be visible
-        bool shouldShow = true;
-
-        // Check hidden status
-        if (isHidden && !showHiddenGames_) {
-            shouldShow = false;
+        QMenu::item {
+                padding: 8px 16px;
+                border-radius: 4px;
+                color: #3c3a37;
         }
-
-        // Check search filter
-        if (shouldShow && !search.isEmpty()) {
-            shouldShow = gameTitle.toLower().contains(search);
+        QMenu::item:hover {
+                background: #e8e6e3;
+                color: #3c3a37;
         }
-
-        card->setVisible(shouldShow);
-        if (shouldShow) {
-            if (!search.isEmpty()) {
-                qDebug() << "  Match:" << gameTitle;
-            }
-            visibleCount++;
+        QMenu::item:selected {
+                background: #6c5ce7;
+                color: white;
         }
-    }
-
-    qDebug() << "Visible cards after filter:" << visibleCount;
-
-    // Update grid layout to reflow visible cards
-    updateGridLayout();
-}
+    )");
 
-void LibraryPage::updateGridLayout() {
-    qDebug() << "updateGridLayout() called";
-    qDebug() << "Total games in allGames_:" << allGames_.size();
-    qDebug() << "Total cards in cardsById_:" << cardsById_.size();
+    QAction *informationAction = menu.addAction(tr("Information"));
+    QAction *propertiesAction = menu.addAction(tr("Properties"));
 
-    // Remove all widgets from grid (but don't delete them)
-    QList<GameCard *> visibleCards;
+    QAction *selectedAction = menu.exec(gameView_->viewport()->mapToGlobal(pos));
 
-    // Collect visible cards in order
-    for (const auto &game : allGames_) {
-        if (cardsById_.contains(game.id)) {
-            GameCard *card = cardsById_[game.id];
-            if (card->isVisible()) {
-                visibleCards.append(card);
-            }
-        }
+    if (selectedAction == informationAction) {
+        showGameInformation(gameId);
+    } else if (selectedAction == propertiesAction) {
+        openGameProperties(gameId);
     }
+}
 
-    qDebug() << "Visible cards to add to grid:" << visibleCards.size();
+void LibraryPage::updateCoverRequests() {
+    const int scrollValue = gameView_->verticalScrollBar()->value();
+    const int direction = scrollValue >= lastScrollValue_ ? 1 : -1;
+    lastScrollValue_ = scrollValue;
 
-    // Remove all items from layout
-    while (QLayoutItem *item = gameGrid->takeAt(0)) {
-        delete item; // Delete the layout item, not the widget
-    }
+    // Everything within a screen of the viewport is worth finishing
+    const int keepFirst = gameView_->visibleRows(-1).first;
+    const int keepLast = gameView_->visibleRows(1).second;
 
-    // Clear all row/column stretches
-    for (int i = 0; i < 100; ++i) {
-        gameGrid->setRowStretch(i, 0);
-        gameGrid->setColumnStretch(i, 0);
+    QSet<QString> keep;
+    for (int row = keepFirst; row <= keepLast; ++row) {
+        keep.insert(filter_->index(row, 0).data(LibraryModel::CoverUrlRole).toString());
     }
+    model_->cancelCoversExcept(keep);
 
-    // Re-add visible cards to grid
-    int row = 0;
-    int col = 0;
-    const int columns = 3; // 3 cards per row
-
-    for (GameCard *card : visibleCards) {
-        gameGrid->addWidget(card, row, col, Qt::AlignTop | Qt::AlignLeft);
-        qDebug() << "  Added card at row" << row << "col" << col;
-        col++;
-        if (col >= columns) {
-            col = 0;
-            row++;
-        }
+    const auto [first, last] = gameView_->visibleRows(direction);
+    for (int row = first; row <= last; ++row) {
+        model_->prefetchCover(filter_->mapToSource(filter_->index(row, 0)));
     }
+}
 
-    qDebug() << "Grid now has" << (row * columns + col) << "cards in" << (row + 1) << "rows";
+void LibraryPage::filterGames(const QString &searchText) {
+    // One repaint for the whole refilter, however many rows come and go
+    gameView_->setUpdatesEnabled(false);
+    filter_->setSearchText(searchText);
+    gameView_->setUpdatesEnabled(true);
+}
 
-    // Add vertical stretch after last row to push cards to top
-    gameGrid->setRowStretch(row + 1, 1);
+void LibraryPage::showEvent(QShowEvent *event) {
+    // These settings only change on the settings page, so pick them up when coming back
+    auto &config = opengalaxy::util::Config::instance();
+    filter_->setShowHiddenGames(config.showHiddenGames());
+    delegate_->setAnimationsEnabled(config.enableAnimations());
+    frameStats_->setVisible(config.showFrameStats());
+    QWidget::showEvent(event);
 }
 
 } // namespace ui
@@ -1,23 +1,28 @@
 #ifndef LIBRARY_PAGE_H
 #define LIBRARY_PAGE_H
 
-#include <QGridLayout>
 #include <QLineEdit>
-#include <QMap>
 #include <QSet>
-#include <QVector>
+#include <QTimer>
 #include <QWidget>
 
 #include "opengalaxy/api/gog_client.h"
 #include "opengalaxy/api/session.h"
 #include "opengalaxy/install/install_service.h"
 #include "opengalaxy/library/library_service.h"
+#include "opengalaxy/runners/game_process_supervisor.h"
+#include "opengalaxy/runners/prefix_manager.h"
 #include "opengalaxy/runners/runner_manager.h"
 
 namespace opengalaxy {
 namespace ui {
 
-class GameCard;
+class DetailsPrefetcher;
+class FrameTimeOverlay;
+class GameCardDelegate;
+class LibraryFilterModel;
+class LibraryGridView;
+class LibraryModel;
 
 class LibraryPage : public QWidget {
     Q_OBJECT
@@ -28,6 +33,12 @@ class LibraryPage : public QWidget {
 
     void refreshLibrary(bool forceRefresh = false);
 
+    library::LibraryService *libraryService() { return &libraryService_; }
+    runners::GameProcessSupervisor *supervisor() { return &supervisor_; }
+
+  protected:
+    void showEvent(QShowEvent *event) override;
+
   private slots:
     void filterGames(const QString &searchText);
 
@@ -36,25 +47,42 @@ class LibraryPage : public QWidget {
     void openGameProperties(const QString &gameId);
     void showGameInformation(const QString &gameId);
     void launchGame(const QString &gameId);
+    runners::LaunchConfig launchConfig(const api::GameInfo &game,
+                                       const util::Result<library::GameExecutable> &target);
+    runners::Runner *runnerFor(const api::GameInfo &game, const runners::LaunchConfig &cfg);
+    void prewarmPrefix(const QString &gameId);
+    void stopGame(const QString &gameId);
     void installGame(const QString &gameId);
+    void startInstall(const api::GameInfo &game, const QString &installDir);
     void cancelInstall(const QString &gameId);
     void updateGame(const QString &gameId);
     void checkForUpdate(const QString &gameId);
-    void updateGridLayout();
+    void onGameUpdated(const QString &gameId);
+    void showCardContextMenu(const QPoint &pos);
+    void updateCoverRequests();
 
-    QGridLayout *gameGrid = nullptr;
+    LibraryGridView *gameView_ = nullptr;
+    LibraryModel *model_ = nullptr; // Owns the snapshot the grid shows
+    LibraryFilterModel *filter_ = nullptr;
+    GameCardDelegate *delegate_ = nullptr;
+    FrameTimeOverlay *frameStats_ = nullptr; // Debug paint timings, see Config::showFrameStats
+    DetailsPrefetcher *prefetcher_ = nullptr; // Warms dialog data for hovered and recent games
     QLineEdit *searchBox_ = nullptr;
+    QTimer searchDebounce_;
+    QTimer coverRequests_; // Coalesces scroll steps before re-planning cover loads
+    int lastScrollValue_ = 0;
 
-    QMap<QString, GameCard *> cardsById_;
-    QVector<api::GameInfo> allGames_; // Store all games for filtering
-    bool isLoading_ = false;          // Prevent double-loading
-    bool showHiddenGames_ = false;    // Whether to show hidden games
+    bool isLoading_ = false; // Prevent double-loading
 
     // Core services used by UI (session is passed from AppWindow)
     api::Session *session_;
     api::GOGClient gogClient_;
     library::LibraryService libraryService_;
     runners::RunnerManager runnerManager_;
+    runners::GameProcessSupervisor supervisor_; // Running games; they outlive the client
+    runners::PrefixManager prefixManager_;
+    QSet<QString> prewarmPending_; // Installed, waiting for the executable index
+    QSet<QString> launchPending_;  // Launched, waiting for the executable index
     install::InstallService installService_;
 };
 
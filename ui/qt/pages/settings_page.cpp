@@ -1,5 +1,8 @@
 #include "settings_page.h"
 #include "i18n/translation_manager.h"
+#include "opengalaxy/library/library_service.h"
+#include "opengalaxy/runners/game_process_supervisor.h"
+#include "opengalaxy/runners/shader_cache.h"
 #include "opengalaxy/util/config.h"
 #include <QCheckBox>
 #include <QComboBox>
@@ -12,6 +15,7 @@
 #include <QLabel>
 #include <QListWidget>
 #include <QMessageBox>
+#include <QLocale>
 #include <QPushButton>
 #include <QScrollArea>
 #include <QSysInfo>
@@ -179,12 +183,80 @@ SettingsPage::SettingsPage(opengalaxy::ui::TranslationManager *translationManage
 
     contentLayout->addWidget(showHiddenGamesCheckbox_);
 
+    // Library rendering
+    QCheckBox *animationsCheckbox = new QCheckBox(tr("Animate game cards on hover"), content);
+    animationsCheckbox->setStyleSheet(showHiddenGamesCheckbox_->styleSheet());
+    animationsCheckbox->setChecked(config.enableAnimations());
+    connect(animationsCheckbox, &QCheckBox::toggled, this, [](bool checked) {
+        opengalaxy::util::Config::instance().setEnableAnimations(checked);
+    });
+    contentLayout->addWidget(animationsCheckbox);
+
+    QCheckBox *frameStatsCheckbox = new QCheckBox(tr("Show library frame times (debug)"), content);
+    frameStatsCheckbox->setStyleSheet(showHiddenGamesCheckbox_->styleSheet());
+    frameStatsCheckbox->setChecked(config.showFrameStats());
+    connect(frameStatsCheckbox, &QCheckBox::toggled, this,
+            [](bool checked) { opengalaxy::util::Config::instance().setShowFrameStats(checked); });
+    contentLayout->addWidget(frameStatsCheckbox);
+
+    QCheckBox *prewarmCheckbox =
+        new QCheckBox(tr("Prepare Wine/Proton prefixes right after installing"), content);
+    prewarmCheckbox->setStyleSheet(showHiddenGamesCheckbox_->styleSheet());
+    prewarmCheckbox->setChecked(config.prewarmPrefixes());
+    connect(prewarmCheckbox, &QCheckBox::toggled, this,
+            [](bool checked) { opengalaxy::util::Config::instance().setPrewarmPrefixes(checked); });
+    contentLayout->addWidget(prewarmCheckbox);
+
+    QLabel *keepAliveLabel = new QLabel(tr("Keep Wine running after a game exits"), content);
+    keepAliveLabel->setObjectName("settingLabel");
+    contentLayout->addWidget(keepAliveLabel);
+
+    // Relaunches within this window skip wineserver's start-up
+    QComboBox *keepAliveCombo = new QComboBox(content);
+    keepAliveCombo->addItem(tr("Off"), 0);
+    keepAliveCombo->addItem(tr("1 minute"), 60);
+    keepAliveCombo->addItem(tr("5 minutes"), 300);
+    keepAliveCombo->addItem(tr("15 minutes"), 900);
+    keepAliveCombo->addItem(tr("1 hour"), 3600);
+    const int keepAliveIndex = keepAliveCombo->findData(config.wineserverKeepAlive());
+    if (keepAliveIndex >= 0) {
+        keepAliveCombo->setCurrentIndex(keepAliveIndex);
+    }
+    connect(keepAliveCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [keepAliveCombo](int index) {
+                opengalaxy::util::Config::instance().setWineserverKeepAlive(
+                    keepAliveCombo->itemData(index).toInt());
+            });
+    contentLayout->addWidget(keepAliveCombo);
+
+    // Shader caches live outside prefixes, so only this removes them
+    shaderCacheWorker_.setMaxThreadCount(1);
+    shaderCacheLabel_ = new QLabel(content);
+    shaderCacheLabel_->setObjectName("settingLabel");
+    contentLayout->addWidget(shaderCacheLabel_);
+
+    QPushButton *clearShadersBtn = new QPushButton(tr("Clear Shader Caches"), content);
+    connect(clearShadersBtn, &QPushButton::clicked, this,
+            &SettingsPage::onClearShaderCachesClicked);
+    contentLayout->addWidget(clearShadersBtn);
+    updateShaderCacheStats();
+
     QPushButton *installsBtn = new QPushButton(tr("Installation Folders"), content);
 
     connect(installsBtn, &QPushButton::clicked, this, &SettingsPage::onInstallationFoldersClicked);
 
     contentLayout->addWidget(installsBtn);
 
+    // Library database
+    databaseStatsLabel_ = new QLabel(content);
+    databaseStatsLabel_->setObjectName("settingLabel");
+    databaseStatsLabel_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    contentLayout->addWidget(databaseStatsLabel_);
+
+    QPushButton *optimizeBtn = new QPushButton(tr("Optimize Library Database"), content);
+    connect(optimizeBtn, &QPushButton::clicked, this, &SettingsPage::onOptimizeDatabaseClicked);
+    contentLayout->addWidget(optimizeBtn);
+
     // Account section
     QLabel *accountTitle = new QLabel(tr("Account"), content);
     accountTitle->setObjectName("sectionTitle");
@@ -237,6 +309,88 @@ SettingsPage::SettingsPage(opengalaxy::ui::TranslationManager *translationManage
     mainLayout->addWidget(scrollArea);
 }
 
+void SettingsPage::setLibraryService(opengalaxy::library::LibraryService *libraryService) {
+    if (libraryService_) disconnect(libraryService_, nullptr, this, nullptr);
+    libraryService_ = libraryService;
+    if (libraryService_) {
+        connect(libraryService_, &opengalaxy::library::LibraryService::maintenanceFinished, this,
+                &SettingsPage::updateDatabaseStats);
+    }
+    updateDatabaseStats();
+}
+
+void SettingsPage::setSupervisor(opengalaxy::runners::GameProcessSupervisor *supervisor) {
+    supervisor_ = supervisor;
+}
+
+void SettingsPage::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    updateDatabaseStats();
+    updateShaderCacheStats();
+}
+
+void SettingsPage::updateDatabaseStats() {
+    if (!databaseStatsLabel_) return;
+    if (!libraryService_) {
+        databaseStatsLabel_->setVisible(false);
+        return;
+    }
+
+    const opengalaxy::library::DatabaseStats stats = libraryService_->databaseStats();
+    const QLocale locale;
+
+    QString text = tr("Library database: %1 (log %2), schema v%3, %4 mode")
+                       .arg(locale.formattedDataSize(stats.fileSize),
+                            locale.formattedDataSize(stats.walSize))
+                       .arg(stats.schemaVersion)
+                       .arg(stats.journalMode.toUpper());
+    text += "\n" + tr("%1 pages of %2, %3 free")
+                       .arg(stats.pageCount)
+                       .arg(locale.formattedDataSize(stats.pageSize))
+                       .arg(stats.freePages);
+    text += "\n" + (stats.lastMaintenance.isValid()
+                        ? tr("Last maintenance: %1")
+                              .arg(locale.toString(stats.lastMaintenance, QLocale::ShortFormat))
+                        : tr("No maintenance yet this session"));
+
+    databaseStatsLabel_->setText(text);
+    databaseStatsLabel_->setVisible(true);
+}
+
+void SettingsPage::onOptimizeDatabaseClicked() {
+    if (libraryService_) libraryService_->runMaintenance();
+}
+
+void SettingsPage::updateShaderCacheStats() {
+    if (!shaderCacheLabel_) return;
+    shaderCacheWorker_.start([this]() {
+        const qint64 total = opengalaxy::runners::ShaderCache::totalSize();
+        QMetaObject::invokeMethod(
+            this, [this, total]() { showShaderCacheSize(total); }, Qt::QueuedConnection);
+    });
+}
+
+void SettingsPage::showShaderCacheSize(qint64 total) {
+    const QLocale locale;
+    const qint64 limit = qint64(opengalaxy::util::Config::instance().shaderCacheLimitMb()) << 20;
+    shaderCacheLabel_->setText(tr("Shader caches: %1 of %2")
+                                   .arg(locale.formattedDataSize(total),
+                                        locale.formattedDataSize(limit)));
+}
+
+void SettingsPage::onClearShaderCachesClicked() {
+    const auto answer = QMessageBox::question(
+        this, tr("Clear Shader Caches"),
+        tr("Games will rebuild their shaders and may stutter the next time they run. Continue?"));
+    if (answer != QMessageBox::Yes) return;
+
+    // Running games have their caches open; theirs are kept
+    const QStringList running = supervisor_ ? supervisor_->runningGames() : QStringList();
+    shaderCacheWorker_.start(
+        [running]() { opengalaxy::runners::ShaderCache::clearAll(running); });
+    updateShaderCacheStats(); // Runs after the clear on the same worker
+}
+
 void SettingsPage::onLanguageChanged(int index) {
     if (!translationManager_ || index < 0) {
         return;
@@ -3,12 +3,19 @@
 
 #include "opengalaxy/api/session.h"
 #include <QComboBox>
+#include <QThreadPool>
 #include <QWidget>
 
 namespace opengalaxy {
 namespace ui {
 class TranslationManager;
 }
+namespace library {
+class LibraryService;
+}
+namespace runners {
+class GameProcessSupervisor;
+}
 } // namespace opengalaxy
 
 class SettingsPage : public QWidget {
@@ -18,21 +25,40 @@ class SettingsPage : public QWidget {
     explicit SettingsPage(opengalaxy::ui::TranslationManager *translationManager,
                           opengalaxy::api::Session *session, QWidget *parent = nullptr);
 
+    // Source of the library database statistics (owned by the library page)
+    void setLibraryService(opengalaxy::library::LibraryService *libraryService);
+    // Running games, whose shader caches are kept when clearing (owned by the library page)
+    void setSupervisor(opengalaxy::runners::GameProcessSupervisor *supervisor);
+
   signals:
     void logoutRequested();
 
+  protected:
+    void showEvent(QShowEvent *event) override;
+
   private slots:
     void onLanguageChanged(int index);
     void onInstallationFoldersClicked();
     void onLogoutClicked();
     void onAboutClicked();
     void onCheckForUpdates();
+    void onOptimizeDatabaseClicked();
+    void onClearShaderCachesClicked();
 
   private:
     opengalaxy::ui::TranslationManager *translationManager_ = nullptr;
     opengalaxy::api::Session *session_ = nullptr;
     QComboBox *languageCombo_ = nullptr;
     class QCheckBox *showHiddenGamesCheckbox_ = nullptr;
+    opengalaxy::library::LibraryService *libraryService_ = nullptr;
+    class QLabel *databaseStatsLabel_ = nullptr;
+    class QLabel *shaderCacheLabel_ = nullptr;
+    opengalaxy::runners::GameProcessSupervisor *supervisor_ = nullptr;
+    QThreadPool shaderCacheWorker_; // Walks and clears the cache off the GUI thread, in order
+
+    void updateDatabaseStats();
+    void updateShaderCacheStats();
+    void showShaderCacheSize(qint64 total);
 };
 
 #endif // SETTINGS_PAGE_H
@@ -0,0 +1,158 @@
+#include "details_prefetcher.h"
+
+#include "../dialogs/game_information_dialog.h"
+#include "image_cache.h"
+
+namespace opengalaxy {
+namespace ui {
+
+namespace {
+// Long enough that sweeping the mouse across the grid warms nothing
+constexpr int kDefaultHoverDelayMs = 400;
+} // namespace
+
+DetailsPrefetcher::DetailsPrefetcher(api::GOGClient *gogClient,
+                                     library::LibraryService *libraryService, QObject *parent)
+    : QObject(parent), gogClient_(gogClient), libraryService_(libraryService) {
+    hoverTimer_.setSingleShot(true);
+    hoverTimer_.setInterval(kDefaultHoverDelayMs);
+    connect(&hoverTimer_, &QTimer::timeout, this, [this]() { prefetch(hovered_); });
+
+    connect(&ImageCache::instance(), &ImageCache::imageReady, this,
+            &DetailsPrefetcher::onImageDone);
+    connect(&ImageCache::instance(), &ImageCache::imageFailed, this,
+            &DetailsPrefetcher::onImageDone);
+}
+
+DetailsPrefetcher::~DetailsPrefetcher() = default;
+
+void DetailsPrefetcher::hoverGame(const QString &gameId) {
+    if (gameId == hovered_) return;
+
+    // Only hover-driven work is dropped; recently played games stay queued
+    if (!hovered_.isEmpty()) cancel(hovered_);
+    hovered_ = gameId;
+
+    if (gameId.isEmpty()) {
+        hoverTimer_.stop();
+    } else {
+        hoverTimer_.start();
+    }
+}
+
+void DetailsPrefetcher::prefetchRecentlyPlayed(int count) {
+    for (const auto &stats : libraryService_->recentlyPlayed(count)) {
+        prefetch(stats.gameId);
+    }
+}
+
+bool DetailsPrefetcher::isWarm(const QString &gameId) const {
+    const auto game = libraryService_->snapshot()->find(gameId);
+    if (!game) return true; // Nothing to warm
+    return !game->description.isEmpty() && !game->downloads.empty() &&
+           (game->backgroundUrl.isEmpty() ||
+            ImageCache::instance().contains(game->backgroundUrl,
+                                            GameInformationDialog::backgroundSize()));
+}
+
+void DetailsPrefetcher::prefetch(const QString &gameId) {
+    if (gameId.isEmpty() || warmed_.contains(gameId) || queue_.contains(gameId)) return;
+
+    auto it = running_.find(gameId);
+    if (it != running_.end()) {
+        it->wanted = true; // Hovered again before it finished
+        return;
+    }
+    if (isWarm(gameId)) {
+        warmed_.insert(gameId);
+        return;
+    }
+
+    queue_.enqueue(gameId);
+    startNext();
+}
+
+void DetailsPrefetcher::cancel(const QString &gameId) {
+    queue_.removeAll(gameId);
+
+    auto it = running_.find(gameId);
+    if (it != running_.end()) it->wanted = false;
+
+    const QString background = backgrounds_.take(gameId);
+    if (!background.isEmpty()) ImageCache::instance().cancel(background);
+}
+
+void DetailsPrefetcher::onImageDone(const QString &url) {
+    for (auto it = backgrounds_.begin(); it != backgrounds_.end();) {
+        if (it.value() == url) {
+            it = backgrounds_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DetailsPrefetcher::startNext() {
+    while (running_.size() < maxConcurrent_ && !queue_.isEmpty()) {
+        warm(queue_.dequeue());
+    }
+}
+
+void DetailsPrefetcher::warm(const QString &gameId) {
+    const auto game = libraryService_->snapshot()->find(gameId);
+    if (!game) return;
+
+    Job &job = running_[gameId];
+
+    if (game->description.isEmpty()) {
+        ++job.pending;
+        gogClient_->fetchGameDetails(gameId, [this, gameId](util::Result<api::GameInfo> result) {
+            if (result.isOk()) {
+                libraryService_->cacheGameDetails(result.value());
+                auto it = running_.find(gameId);
+                if (it != running_.end()) requestBackground(gameId, *it);
+            }
+            finishStep(gameId);
+        });
+    } else {
+        requestBackground(gameId, job);
+    }
+
+    if (game->downloads.empty()) {
+        ++job.pending;
+        gogClient_->fetchGameDownloads(gameId, [this, gameId](util::Result<api::GameInfo> result) {
+            if (result.isOk()) {
+                libraryService_->cacheGameDownloads(gameId, result.value().downloads);
+            }
+            finishStep(gameId);
+        });
+    }
+
+    ++job.pending; // Held until warm() returns, so synchronous callbacks cannot finish it
+    finishStep(gameId);
+}
+
+void DetailsPrefetcher::requestBackground(const QString &gameId, const Job &job) {
+    if (!job.wanted) return;
+    const auto game = libraryService_->snapshot()->find(gameId);
+    if (!game || game->backgroundUrl.isEmpty()) return;
+
+    // Starts the download; the pixmap itself is picked up by the dialog
+    ImageCache &cache = ImageCache::instance();
+    cache.pixmap(game->backgroundUrl, GameInformationDialog::backgroundSize(),
+                 ImageCache::Prefetch);
+    if (cache.isLoading(game->backgroundUrl)) backgrounds_.insert(gameId, game->backgroundUrl);
+}
+
+void DetailsPrefetcher::finishStep(const QString &gameId) {
+    auto it = running_.find(gameId);
+    if (it == running_.end() || --it->pending > 0) return;
+
+    // A cancelled game may be hovered again later; finished ones are not retried
+    if (it->wanted) warmed_.insert(gameId);
+    running_.erase(it);
+    startNext();
+}
+
+} // namespace ui
+} // namespace opengalaxy
@@ -0,0 +1,78 @@
+#ifndef DETAILS_PREFETCHER_H
+#define DETAILS_PREFETCHER_H
+
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QTimer>
+
+#include "opengalaxy/api/gog_client.h"
+#include "opengalaxy/library/library_service.h"
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Warms what the game dialogs need before they are opened.
+ *
+ * For a game that is likely to be opened next (hovered for a moment, or among
+ * the most recently played) it fetches the product details into the library
+ * database, the background art into the ImageCache and the installer links
+ * into the download cache. The dialogs then open from local data.
+ *
+ * Work is low priority: at most a couple of games are warmed at a time,
+ * images load at ImageCache::Prefetch priority, and moving away from a card
+ * drops it from the queue and cancels its image load. API calls already
+ * sent are left to finish, since their result is cached either way.
+ */
+class DetailsPrefetcher : public QObject {
+    Q_OBJECT
+
+  public:
+    DetailsPrefetcher(api::GOGClient *gogClient, library::LibraryService *libraryService,
+                      QObject *parent = nullptr);
+    ~DetailsPrefetcher();
+
+    int hoverDelay() const { return hoverTimer_.interval(); }
+    void setHoverDelay(int msecs) { hoverTimer_.setInterval(msecs); }
+
+    // Card under the mouse; warmed once it has stayed there for hoverDelay().
+    // An empty id (mouse left the cards) cancels the previous one.
+    void hoverGame(const QString &gameId);
+    // Queue the most recently played games
+    void prefetchRecentlyPlayed(int count = 5);
+
+    void prefetch(const QString &gameId);
+    void cancel(const QString &gameId);
+
+  private:
+    struct Job {
+        int pending = 0;    // API calls still running
+        bool wanted = true; // Cleared by cancel()
+    };
+
+    bool isWarm(const QString &gameId) const;
+    void startNext();
+    void warm(const QString &gameId);
+    void requestBackground(const QString &gameId, const Job &job);
+    void onImageDone(const QString &url);
+    void finishStep(const QString &gameId);
+
+    api::GOGClient *gogClient_;
+    library::LibraryService *libraryService_;
+
+    QTimer hoverTimer_;
+    QString hovered_;
+
+    QQueue<QString> queue_;
+    QHash<QString, Job> running_;
+    QHash<QString, QString> backgrounds_; // Game id -> background still loading
+    QSet<QString> warmed_; // Done this session, details or not
+    int maxConcurrent_ = 2;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // DETAILS_PREFETCHER_H
@@ -0,0 +1,247 @@
+#include "image_cache.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QImageReader>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QThread>
+#include <QUrl>
+
+#include "opengalaxy/util/config.h"
+
+namespace opengalaxy {
+namespace ui {
+
+namespace {
+// Roughly 250 library covers at 420x220
+constexpr qint64 kDefaultMemoryBudget = 96LL * 1024 * 1024;
+constexpr qint64 kDiskCacheSize = 512LL * 1024 * 1024;
+// Leave a core for the GUI thread; a handful of decoders keeps up with any scroll speed
+constexpr int kMaxDecoders = 4;
+} // namespace
+
+ImageCache &ImageCache::instance() {
+    // Parented to the application so it goes away before the network stack does
+    static ImageCache *cache = new ImageCache(QCoreApplication::instance());
+    return *cache;
+}
+
+ImageCache::ImageCache(QObject *parent)
+    : QObject(parent), network_(new QNetworkAccessManager(this)),
+      diskCache_(new QNetworkDiskCache(this)) {
+    // Files are stored under a hash of their URL, with the response headers
+    // (ETag, Last-Modified, expiry) kept alongside as metadata
+    diskCache_->setCacheDirectory(opengalaxy::util::Config::instance().imageCacheDir());
+    diskCache_->setMaximumCacheSize(kDiskCacheSize);
+    network_->setCache(diskCache_);
+    network_->setTransferTimeout(10000); // 10 second timeout
+
+    decoders_.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, kMaxDecoders));
+
+    setMemoryBudget(kDefaultMemoryBudget);
+}
+
+ImageCache::~ImageCache() {
+    // Running decodes post back to this object; let them finish while it still exists
+    decoders_.clear();
+    decoders_.waitForDone();
+}
+
+QString ImageCache::key(const QString &url, const QSize &size) {
+    return QString("%1x%2|%3").arg(size.width()).arg(size.height()).arg(url);
+}
+
+void ImageCache::setMemoryBudget(qint64 bytes) {
+    pixmaps_.setMaxCost(qMax<qint64>(1, bytes / 1024));
+}
+
+void ImageCache::setMaxConcurrentFetches(int count) {
+    maxConcurrent_ = qMax(1, count);
+    startFetches();
+}
+
+void ImageCache::clearMemory() { pixmaps_.clear(); }
+
+bool ImageCache::contains(const QString &url, const QSize &size) const {
+    return pixmaps_.contains(key(url, size));
+}
+
+QPixmap ImageCache::pixmap(const QString &url, const QSize &size, Priority priority) {
+    if (url.trimmed().isEmpty()) return QPixmap();
+
+    if (const QPixmap *cached = pixmaps_.object(key(url, size))) {
+        return *cached;
+    }
+    if (failed_.contains(url)) return QPixmap();
+
+    // Already on its way: the download is shared, only the size and priority may change
+    auto it = pending_.find(url);
+    if (it != pending_.end()) {
+        if (priority > it->priority) {
+            it->priority = priority;
+            if (it->queued && prefetchQueue_.removeOne(url)) {
+                visibleQueue_.enqueue(url);
+            }
+        }
+        if (!it->sizes.contains(size)) {
+            it->sizes.append(size);
+            if (!it->data.isEmpty()) startDecode(url, *it, size);
+        }
+        return QPixmap();
+    }
+
+    const QUrl qurl(url);
+    if (!qurl.isValid() || qurl.scheme().isEmpty()) {
+        qDebug() << "Invalid image URL (no protocol):" << url;
+        failed_.insert(url);
+        return QPixmap();
+    }
+
+    Request request;
+    request.sizes = {size};
+    request.priority = priority;
+    pending_.insert(url, request);
+    (priority == Visible ? visibleQueue_ : prefetchQueue_).enqueue(url);
+    startFetches();
+    return QPixmap();
+}
+
+void ImageCache::cancel(const QString &url) {
+    auto it = pending_.find(url);
+    if (it == pending_.end() || !it->data.isEmpty()) return;
+
+    if (it->queued) {
+        visibleQueue_.removeOne(url);
+        prefetchQueue_.removeOne(url);
+        pending_.erase(it);
+        return;
+    }
+
+    // Forget the request first so onFetched() does not treat the abort as a failure
+    pending_.erase(it);
+    if (QNetworkReply *reply = inFlight_.value(url)) {
+        reply->abort();
+    }
+}
+
+void ImageCache::startFetches() {
+    while (active_ < maxConcurrent_ && !(visibleQueue_.isEmpty() && prefetchQueue_.isEmpty())) {
+        fetch(!visibleQueue_.isEmpty() ? visibleQueue_.dequeue() : prefetchQueue_.dequeue());
+    }
+}
+
+void ImageCache::fetch(const QString &url) {
+    pending_[url].queued = false;
+    const QUrl qurl(url);
+
+    QNetworkRequest request(qurl);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+    request.setRawHeader("User-Agent", "OpenGalaxy/0.1.0");
+    request.setRawHeader("Accept", "image/*");
+
+    // GOG image URLs carry a content hash, so a file on disk never goes stale:
+    // serve it without asking the server. Anything else may use the cache if fresh.
+    const bool onDisk = diskCache_->metaData(qurl).isValid();
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                         onDisk ? QNetworkRequest::AlwaysCache : QNetworkRequest::PreferCache);
+
+    ++active_;
+    QNetworkReply *reply = network_->get(request);
+    inFlight_.insert(url, reply);
+    connect(reply, &QNetworkReply::finished, this,
+            [this, reply, url]() { onFetched(reply, url); });
+}
+
+void ImageCache::onFetched(QNetworkReply *reply, const QString &url) {
+    reply->deleteLater();
+    inFlight_.remove(url);
+    --active_;
+
+    auto it = pending_.find(url);
+    if (it == pending_.end()) {
+        // Cancelled
+        startFetches();
+        return;
+    }
+
+    const QByteArray data =
+        reply->error() == QNetworkReply::NoError ? reply->readAll() : QByteArray();
+    if (data.isEmpty()) {
+        // Not critical: callers keep their placeholder
+        pending_.erase(it);
+        failed_.insert(url);
+        emit imageFailed(url);
+        startFetches();
+        return;
+    }
+
+    it->data = data;
+    for (const QSize &size : it->sizes) {
+        startDecode(url, *it, size);
+    }
+    startFetches();
+}
+
+QImage ImageCache::decode(const QByteArray &data, const QSize &size) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    reader.setAutoTransform(true);
+
+    // JPEG (most covers) decodes at a fraction of the full resolution when asked to
+    const QSize source = reader.size();
+    if (source.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize)) {
+        reader.setScaledSize(source.scaled(size, Qt::KeepAspectRatio));
+        return reader.read();
+    }
+
+    const QImage image = reader.read();
+    if (image.isNull()) return image;
+    return image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+void ImageCache::startDecode(const QString &url, Request &request, const QSize &size) {
+    ++request.decodesLeft;
+    const QByteArray data = request.data;
+    decoders_.start(
+        [this, url, size, data]() {
+            const QImage image = decode(data, size);
+            QMetaObject::invokeMethod(
+                this, [this, url, size, image]() { onDecoded(url, size, image); },
+                Qt::QueuedConnection);
+        },
+        request.priority);
+}
+
+void ImageCache::onDecoded(const QString &url, const QSize &size, const QImage &image) {
+    auto it = pending_.find(url);
+    if (it == pending_.end()) return;
+
+    if (!image.isNull()) {
+        // The only step left on the GUI thread
+        const qsizetype cost = qMax<qsizetype>(1, image.sizeInBytes() / 1024);
+        pixmaps_.insert(key(url, size), new QPixmap(QPixmap::fromImage(image)), cost);
+        it->decoded = true;
+    }
+
+    if (--it->decodesLeft > 0) return;
+
+    const bool decoded = it->decoded;
+    pending_.erase(it);
+    if (decoded) {
+        emit imageReady(url);
+    } else {
+        failed_.insert(url);
+        emit imageFailed(url);
+    }
+}
+
+} // namespace ui
+} // namespace opengalaxy
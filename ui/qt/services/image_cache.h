@@ -0,0 +1,116 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QQueue>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+
+class QNetworkAccessManager;
+class QNetworkDiskCache;
+class QNetworkReply;
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Shared loader and cache for remote images (covers, backgrounds).
+ *
+ * Two tiers: decoded pixmaps, already scaled to the size they are drawn at,
+ * live in an in-memory LRU bounded by bytes; the downloaded files live in a
+ * disk cache keyed by URL that keeps the server's validators (ETag,
+ * Last-Modified). An image already on disk is never fetched again, so
+ * reopening the library costs no network traffic.
+ *
+ * Concurrent requests for the same URL share one download, and at most
+ * maxConcurrentFetches() downloads run at a time; the rest wait in a queue.
+ *
+ * Decoding runs on a worker pool and decodes straight to the target size
+ * (QImageReader::setScaledSize), so the GUI thread only turns the finished
+ * QImage into a QPixmap. Visible requests are fetched and decoded before
+ * prefetches, and requests nobody needs any more can be cancelled.
+ */
+class ImageCache : public QObject {
+    Q_OBJECT
+
+  public:
+    enum Priority {
+        Prefetch = 0, // Likely needed soon
+        Visible = 10  // On screen now
+    };
+
+    static ImageCache &instance();
+
+    explicit ImageCache(QObject *parent = nullptr);
+    ~ImageCache();
+
+    // Scaled to fit size (aspect ratio kept). Null if not loaded yet; a load is
+    // started and imageReady() follows.
+    QPixmap pixmap(const QString &url, const QSize &size, Priority priority = Visible);
+    bool contains(const QString &url, const QSize &size) const;
+    bool isLoading(const QString &url) const { return pending_.contains(url); }
+
+    // Drop a queued request or abort its download. Downloads already being
+    // decoded are left to finish.
+    void cancel(const QString &url);
+
+    qint64 memoryBudget() const { return qint64(pixmaps_.maxCost()) * 1024; }
+    void setMemoryBudget(qint64 bytes);
+
+    int maxConcurrentFetches() const { return maxConcurrent_; }
+    void setMaxConcurrentFetches(int count);
+
+    // Drop decoded pixmaps; the disk cache is kept
+    void clearMemory();
+    // Let URLs that failed to load be tried again
+    void retryFailed() { failed_.clear(); }
+
+    // Decode data to fit size, reading no more pixels than needed. Thread-safe.
+    static QImage decode(const QByteArray &data, const QSize &size);
+
+  signals:
+    void imageReady(const QString &url);
+    void imageFailed(const QString &url);
+
+  private:
+    struct Request {
+        QList<QSize> sizes;
+        Priority priority = Prefetch;
+        bool queued = true;  // Waiting for a download slot
+        QByteArray data;     // Set once downloaded
+        int decodesLeft = 0; // Decodes still running on the pool
+        bool decoded = false;
+    };
+
+    static QString key(const QString &url, const QSize &size);
+
+    void startFetches();
+    void fetch(const QString &url);
+    void onFetched(QNetworkReply *reply, const QString &url);
+    void startDecode(const QString &url, Request &request, const QSize &size);
+    void onDecoded(const QString &url, const QSize &size, const QImage &image);
+
+    QNetworkAccessManager *network_;
+    QNetworkDiskCache *diskCache_;
+    QThreadPool decoders_;
+
+    QCache<QString, QPixmap> pixmaps_; // cost in KiB
+    QHash<QString, Request> pending_;
+    QHash<QString, QNetworkReply *> inFlight_;
+    QQueue<QString> visibleQueue_;
+    QQueue<QString> prefetchQueue_;
+    QSet<QString> failed_;
+    int active_ = 0;
+    int maxConcurrent_ = 6;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // IMAGE_CACHE_H
@@ -0,0 +1,72 @@
+#include "frame_time_overlay.h"
+
+#include <QEvent>
+
+namespace opengalaxy {
+namespace ui {
+
+namespace {
+constexpr int kRefreshMs = 250;
+constexpr int kInset = 8;
+} // namespace
+
+FrameTimeOverlay::FrameTimeOverlay(QWidget *parent) : QLabel(parent) {
+    // Opaque, so its own repaints never reach the widget underneath
+    setAutoFillBackground(true);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setStyleSheet("QLabel { background: #1a0f2e; color: #b0ffb0; padding: 4px 8px;"
+                  " font-family: monospace; font-size: 11px; }");
+    setText(tr("waiting for frames"));
+    adjustSize();
+
+    refreshTimer_.setInterval(kRefreshMs);
+    connect(&refreshTimer_, &QTimer::timeout, this, &FrameTimeOverlay::refresh);
+    refreshTimer_.start();
+
+    parent->installEventFilter(this);
+    reposition();
+}
+
+FrameTimeOverlay::~FrameTimeOverlay() = default;
+
+void FrameTimeOverlay::addSample(qint64 nsecs) {
+    samples_[next_] = nsecs;
+    next_ = (next_ + 1) % kSamples;
+    count_ = qMin(count_ + 1, kSamples);
+}
+
+void FrameTimeOverlay::refresh() {
+    if (!isVisible() || count_ == 0) return;
+
+    qint64 total = 0;
+    qint64 worst = 0;
+    for (int i = 0; i < count_; ++i) {
+        total += samples_[i];
+        worst = qMax(worst, samples_[i]);
+    }
+    const qint64 last = samples_[(next_ + kSamples - 1) % kSamples];
+    const double avgMs = total / 1e6 / count_;
+
+    setText(tr("paint %1 ms  avg %2 ms  max %3 ms  (%4 frames)")
+                .arg(last / 1e6, 0, 'f', 2)
+                .arg(avgMs, 0, 'f', 2)
+                .arg(worst / 1e6, 0, 'f', 2)
+                .arg(count_));
+    adjustSize();
+    reposition();
+}
+
+void FrameTimeOverlay::reposition() {
+    move(parentWidget()->width() - width() - kInset, kInset);
+    raise();
+}
+
+bool FrameTimeOverlay::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == parentWidget() && event->type() == QEvent::Resize) {
+        reposition();
+    }
+    return QLabel::eventFilter(watched, event);
+}
+
+} // namespace ui
+} // namespace opengalaxy
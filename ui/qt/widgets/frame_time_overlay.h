@@ -0,0 +1,44 @@
+#ifndef FRAME_TIME_OVERLAY_H
+#define FRAME_TIME_OVERLAY_H
+
+#include <QLabel>
+#include <QTimer>
+#include <array>
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Debug readout of paint times, pinned to the top-right corner of its parent.
+ *
+ * Samples are fed through addSample() and the text is refreshed a few times a
+ * second, so the overlay itself adds next to nothing to the frames it measures.
+ */
+class FrameTimeOverlay : public QLabel {
+    Q_OBJECT
+
+  public:
+    explicit FrameTimeOverlay(QWidget *parent);
+    ~FrameTimeOverlay();
+
+    void addSample(qint64 nsecs);
+
+  protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+  private:
+    void refresh();
+    void reposition();
+
+    static constexpr int kSamples = 120;
+
+    std::array<qint64, kSamples> samples_{};
+    int next_ = 0;
+    int count_ = 0;
+    QTimer refreshTimer_;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // FRAME_TIME_OVERLAY_H
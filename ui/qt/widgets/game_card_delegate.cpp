@@ -0,0 +1,417 @@
+#include "game_card_delegate.h"
+
+#include <QImage>
+#include <QLinearGradient>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QVariantAnimation>
+#include <qdrawutil.h>
+#include <vector>
+
+#include "../models/library_model.h"
+
+namespace opengalaxy {
+namespace ui {
+
+namespace {
+constexpr int kCardWidth = 420;
+constexpr int kCardHeight = 310;
+constexpr int kCoverHeight = 220;
+constexpr int kRadius = 12;
+
+// Room around the card for the shadow and the hover lift
+constexpr int kMarginX = 8;
+constexpr int kMarginTop = 12;
+constexpr int kMarginBottom = 12;
+constexpr int kHoverLift = 8;
+constexpr int kHoverDurationMs = 200;
+
+// Shadow blur at rest and fully lifted, as the old drop shadow effect used
+constexpr int kShadowBlur = 20;
+constexpr int kHoverShadowBlur = 35;
+constexpr int kShadowOffsetY = 4;
+
+// Overlay geometry, relative to the card's top-left corner
+const QRect kActionRect(130, 55, 160, 50);
+const QRect kSideButtonRect(172, 115, 76, 50);
+const QRect kProgressRect(90, 177, 240, 14);
+const QRect kTransferRect(90, 193, 240, 16);
+const QRect kUnreleasedRect(kCardWidth - 180 - 12, 12, 180, 40);
+
+bool isBusy(const QModelIndex &index) {
+    return index.data(LibraryModel::InstallingRole).toBool() ||
+           index.data(LibraryModel::UpdatingRole).toBool();
+}
+
+QFont pixelFont(const QFont &base, int pixelSize, QFont::Weight weight) {
+    QFont font(base);
+    font.setPixelSize(pixelSize);
+    font.setWeight(weight);
+    return font;
+}
+
+// One box blur pass over the alpha channel, along rows (horizontal) or columns
+void boxBlurAlpha(std::vector<int> &alpha, int width, int height, int radius, bool horizontal) {
+    const int lines = horizontal ? height : width;
+    const int length = horizontal ? width : height;
+    const int stride = horizontal ? 1 : width;
+    std::vector<int> line(length);
+
+    for (int l = 0; l < lines; ++l) {
+        const int base = horizontal ? l * width : l;
+        for (int i = 0; i < length; ++i) {
+            line[i] = alpha[base + i * stride];
+        }
+        int sum = 0;
+        for (int i = -radius; i <= radius; ++i) {
+            sum += line[qBound(0, i, length - 1)];
+        }
+        for (int i = 0; i < length; ++i) {
+            alpha[base + i * stride] = sum / (2 * radius + 1);
+            sum += line[qMin(i + radius + 1, length - 1)] - line[qMax(i - radius, 0)];
+        }
+    }
+}
+
+// Nine-patch source for a card shadow: a blurred rounded square whose corners and edges are
+// stretched around any card size by qDrawBorderPixmap(). Rendered once per blur radius and
+// kept in QPixmapCache, which the application clears before it goes away.
+QPixmap shadowPixmap(int blur) {
+    const QString key = QStringLiteral("opengalaxy-card-shadow-%1").arg(blur);
+    QPixmap cached;
+    if (QPixmapCache::find(key, &cached)) return cached;
+
+    const int core = 2 * kRadius + 1;
+    const int side = core + 2 * blur;
+    QImage image(side, side, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, 100));
+        painter.drawRoundedRect(QRect(blur, blur, core, core), kRadius, kRadius);
+    }
+
+    // Three box passes approximate a gaussian of the same radius
+    std::vector<int> alpha(side * side);
+    for (int y = 0; y < side; ++y) {
+        const QRgb *row = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        for (int x = 0; x < side; ++x) alpha[y * side + x] = qAlpha(row[x]);
+    }
+    const int passRadius = qMax(1, blur / 3);
+    for (int pass = 0; pass < 3; ++pass) {
+        boxBlurAlpha(alpha, side, side, passRadius, true);
+        boxBlurAlpha(alpha, side, side, passRadius, false);
+    }
+    for (int y = 0; y < side; ++y) {
+        QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < side; ++x) row[x] = qRgba(0, 0, 0, alpha[y * side + x]);
+    }
+
+    const QPixmap pixmap = QPixmap::fromImage(image);
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
+
+void paintShadow(QPainter *painter, const QRect &card, int blur, qreal opacity) {
+    if (opacity <= 0) return;
+    const int margin = blur + kRadius;
+    const QRect target = card.adjusted(-blur, -blur, blur, blur).translated(0, kShadowOffsetY);
+
+    painter->save();
+    painter->setOpacity(opacity);
+    qDrawBorderPixmap(painter, target, QMargins(margin, margin, margin, margin),
+                      shadowPixmap(blur));
+    painter->restore();
+}
+} // namespace
+
+GameCardDelegate::GameCardDelegate(QObject *parent)
+    : QStyledItemDelegate(parent), hoverAnimation_(new QVariantAnimation(this)) {
+    hoverAnimation_->setStartValue(0.0);
+    hoverAnimation_->setEndValue(1.0);
+    hoverAnimation_->setDuration(kHoverDurationMs);
+    hoverAnimation_->setEasingCurve(QEasingCurve::OutCubic);
+    connect(hoverAnimation_, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+        progress_ = value.toReal();
+        if (hovered_.isValid()) emit repaintRequested(hovered_);
+        if (unhovered_.isValid()) emit repaintRequested(unhovered_);
+    });
+}
+
+GameCardDelegate::~GameCardDelegate() = default;
+
+QSize GameCardDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const {
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+    return QSize(kCardWidth + 2 * kMarginX, kCardHeight + kMarginTop + kMarginBottom);
+}
+
+void GameCardDelegate::setAnimationsEnabled(bool enabled) {
+    animationsEnabled_ = enabled;
+    if (!enabled && hoverAnimation_->state() == QAbstractAnimation::Running) {
+        hoverAnimation_->stop();
+        progress_ = 1;
+        if (hovered_.isValid()) emit repaintRequested(hovered_);
+        if (unhovered_.isValid()) emit repaintRequested(unhovered_);
+    }
+}
+
+qreal GameCardDelegate::hoverAmount(const QModelIndex &index) const {
+    if (index == hovered_) return hoveredFrom_ + (1 - hoveredFrom_) * progress_;
+    if (index == unhovered_) return unhoveredFrom_ * (1 - progress_);
+    return 0;
+}
+
+void GameCardDelegate::setHoveredIndex(const QModelIndex &index) {
+    if (index == hovered_) return;
+
+    // Both animations restart from wherever the cards are now
+    const qreal leaving = hoverAmount(hovered_);
+    const qreal entering = hoverAmount(index);
+    const QPersistentModelIndex previousUnhovered = unhovered_;
+
+    unhovered_ = hovered_;
+    unhoveredFrom_ = leaving;
+    hovered_ = index;
+    hoveredFrom_ = entering;
+
+    hoverAnimation_->stop();
+    if (animationsEnabled_) {
+        progress_ = 0;
+        hoverAnimation_->start();
+    } else {
+        progress_ = 1;
+    }
+
+    if (previousUnhovered.isValid()) emit repaintRequested(previousUnhovered);
+    if (unhovered_.isValid()) emit repaintRequested(unhovered_);
+    if (hovered_.isValid()) emit repaintRequested(hovered_);
+}
+
+QRect GameCardDelegate::cardRect(const QStyleOptionViewItem &option, qreal lift) {
+    return QRect(option.rect.left() + kMarginX,
+                 option.rect.top() + kMarginTop - qRound(lift * kHoverLift), kCardWidth,
+                 kCardHeight);
+}
+
+QMargins GameCardDelegate::paintOverflow() {
+    // Resting and fully lifted positions, with the larger of the two shadows
+    const int blur = qMax(kShadowBlur, kHoverShadowBlur);
+    return QMargins(qMax(0, blur - kMarginX),
+                    qMax(0, blur + kHoverLift - kShadowOffsetY - kMarginTop),
+                    qMax(0, blur - kMarginX), qMax(0, blur + kShadowOffsetY - kMarginBottom));
+}
+
+void GameCardDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const {
+    const bool hovered = option.state & QStyle::State_MouseOver;
+    const bool installed = index.data(LibraryModel::InstalledRole).toBool();
+    const bool busy = isBusy(index);
+    const qreal lift = hoverAmount(index);
+    const QRect card = cardRect(option, lift);
+
+    painter->save();
+
+    // Cross-fade between the resting and the lifted shadow; both are shared pixmaps
+    paintShadow(painter, card, kShadowBlur, 1 - lift);
+    paintShadow(painter, card, kHoverShadowBlur, lift);
+
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+
+    QPainterPath cardPath;
+    cardPath.addRoundedRect(card, kRadius, kRadius);
+    painter->setClipPath(cardPath);
+    painter->translate(card.topLeft());
+
+    // Cover
+    const QRect coverRect(0, 0, kCardWidth, kCoverHeight);
+    QLinearGradient coverGradient(coverRect.topLeft(), coverRect.bottomRight());
+    coverGradient.setColorAt(0, QColor("#2d1b4e"));
+    coverGradient.setColorAt(1, QColor("#3d2b5e"));
+    painter->fillRect(coverRect, coverGradient);
+
+    const QPixmap cover = index.data(LibraryModel::CoverRole).value<QPixmap>();
+    if (!cover.isNull()) {
+        QRect target(QPoint(0, 0), cover.size());
+        target.moveCenter(coverRect.center());
+        painter->drawPixmap(target, cover);
+    } else {
+        painter->setFont(pixelFont(option.font, 72, QFont::Normal));
+        painter->setPen(QColor(255, 255, 255, 77));
+        painter->drawText(coverRect, Qt::AlignCenter, QStringLiteral("🎮"));
+    }
+
+    // Info
+    const QRect infoRect(0, kCoverHeight, kCardWidth, kCardHeight - kCoverHeight);
+    painter->fillRect(infoRect, QColor(45, 27, 78, 153));
+
+    const QFont titleFont = pixelFont(option.font, 18, QFont::DemiBold);
+    const QRect titleBounds = infoRect.adjusted(16, 12, -16, 0);
+    QRect titleRect = QFontMetrics(titleFont).boundingRect(
+        titleBounds.left(), titleBounds.top(), titleBounds.width(), 50, Qt::TextWordWrap,
+        index.data(LibraryModel::TitleRole).toString());
+    titleRect.setHeight(qMin(titleRect.height(), 50));
+
+    painter->save();
+    painter->setClipRect(titleRect, Qt::IntersectClip);
+    painter->setFont(titleFont);
+    painter->setPen(Qt::white);
+    painter->drawText(titleRect, Qt::TextWordWrap, index.data(LibraryModel::TitleRole).toString());
+    painter->restore();
+
+    painter->setFont(pixelFont(option.font, 14, QFont::Normal));
+    painter->setPen(QColor("#b8b8d1"));
+    painter->drawText(QRect(titleBounds.left(), titleRect.bottom() + 5, titleBounds.width(), 20),
+                      Qt::AlignLeft | Qt::AlignTop,
+                      index.data(LibraryModel::PlatformRole).toString());
+
+    if (index.data(LibraryModel::UnreleasedRole).toBool()) {
+        paintButton(painter, kUnreleasedRect, QColor("#ff9800"), QColor("#f57c00"),
+                    QStringLiteral("⏳ UNRELEASED"), 14);
+    }
+
+    // Overlays
+    if (hovered) {
+        const bool running = index.data(LibraryModel::RunningRole).toBool();
+        const QString actionText = busy        ? QStringLiteral("CANCEL")
+                                   : running   ? QStringLiteral("■ STOP")
+                                   : installed ? QStringLiteral("▶ PLAY")
+                                               : QStringLiteral("⬇ INSTALL");
+        paintButton(painter, kActionRect, QColor("#7c4dff"), QColor("#5a3aff"), actionText, 15);
+
+        if (installed && !busy) {
+            if (index.data(LibraryModel::UpdateAvailableRole).toBool()) {
+                paintButton(painter, kSideButtonRect, QColor("#ff9800"), QColor("#f57c00"),
+                            QStringLiteral("⬆ UPD"), 13);
+            } else if (index.data(LibraryModel::RepairNeededRole).toBool()) {
+                paintButton(painter, kSideButtonRect, QColor("#e91e63"), QColor("#c2185b"),
+                            QStringLiteral("🔧 REP"), 13);
+            }
+        }
+    }
+
+    if (busy) {
+        const int progress = index.data(LibraryModel::ProgressRole).toInt();
+
+        painter->setPen(QPen(QColor(124, 77, 255, 77), 2));
+        painter->setBrush(QColor(0, 0, 0, 128));
+        painter->drawRoundedRect(kProgressRect, 7, 7);
+
+        const QRect groove = kProgressRect.adjusted(2, 2, -2, -2);
+        if (progress > 0) {
+            QRect chunk = groove;
+            chunk.setWidth(groove.width() * progress / 100);
+            QLinearGradient chunkGradient(chunk.topLeft(), chunk.topRight());
+            chunkGradient.setColorAt(0, QColor("#00e676"));
+            chunkGradient.setColorAt(0.5, QColor("#00c853"));
+            chunkGradient.setColorAt(1, QColor("#00e676"));
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(chunkGradient);
+            painter->drawRoundedRect(chunk, 5, 5);
+        }
+
+        painter->setFont(pixelFont(option.font, 10, QFont::Bold));
+        painter->setPen(Qt::white);
+        painter->drawText(kProgressRect, Qt::AlignCenter, QString("%1%").arg(progress));
+
+        const QString transfer = index.data(LibraryModel::TransferRole).toString();
+        if (!transfer.isEmpty()) {
+            painter->setFont(pixelFont(option.font, 11, QFont::Normal));
+            painter->setPen(QColor(255, 255, 255, 220));
+            painter->drawText(kTransferRect, Qt::AlignCenter, transfer);
+        }
+    }
+
+    painter->restore();
+}
+
+void GameCardDelegate::paintButton(QPainter *painter, const QRect &rect, const QColor &from,
+                                   const QColor &to, const QString &text, int pixelSize) {
+    QLinearGradient gradient(rect.topLeft(), rect.topRight());
+    gradient.setColorAt(0, from);
+    gradient.setColorAt(1, to);
+
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(gradient);
+    painter->drawRoundedRect(rect, 8, 8);
+
+    painter->setFont(pixelFont(painter->font(), pixelSize, QFont::Bold));
+    painter->setPen(Qt::white);
+    painter->drawText(rect, Qt::AlignCenter, text);
+}
+
+GameCardDelegate::Button GameCardDelegate::buttonAt(const QStyleOptionViewItem &option,
+                                                    const QModelIndex &index, const QPoint &pos) {
+    // Clicks only land on hovered cards, so hit-test against the lifted position
+    const QPoint local = pos - cardRect(option, 1).topLeft();
+
+    if (kActionRect.contains(local)) {
+        return Button::Action;
+    }
+
+    const bool installed = index.data(LibraryModel::InstalledRole).toBool();
+    if (installed && !isBusy(index) && kSideButtonRect.contains(local)) {
+        if (index.data(LibraryModel::UpdateAvailableRole).toBool()) {
+            return Button::Update;
+        }
+        if (index.data(LibraryModel::RepairNeededRole).toBool()) {
+            return Button::Repair;
+        }
+    }
+    return Button::None;
+}
+
+bool GameCardDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                   const QStyleOptionViewItem &option, const QModelIndex &index) {
+    Q_UNUSED(model);
+
+    if (event->type() != QEvent::MouseButtonRelease &&
+        event->type() != QEvent::MouseButtonDblClick) {
+        return false;
+    }
+
+    auto *mouseEvent = static_cast<QMouseEvent *>(event);
+    if (mouseEvent->button() != Qt::LeftButton) {
+        return false;
+    }
+
+    const QString gameId = index.data(LibraryModel::GameIdRole).toString();
+
+    if (event->type() == QEvent::MouseButtonDblClick) {
+        emit detailsRequested(gameId);
+        return true;
+    }
+
+    switch (buttonAt(option, index, mouseEvent->position().toPoint())) {
+    case Button::Action:
+        if (isBusy(index)) {
+            emit cancelInstallRequested(gameId);
+        } else if (index.data(LibraryModel::RunningRole).toBool()) {
+            emit stopRequested(gameId);
+        } else if (index.data(LibraryModel::InstalledRole).toBool()) {
+            emit playRequested(gameId);
+        } else {
+            emit installRequested(gameId);
+        }
+        return true;
+    case Button::Update:
+        emit updateRequested(gameId);
+        return true;
+    case Button::Repair:
+        emit repairRequested(gameId);
+        return true;
+    case Button::None:
+        break;
+    }
+    return false;
+}
+
+} // namespace ui
+} // namespace opengalaxy
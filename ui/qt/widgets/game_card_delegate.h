@@ -0,0 +1,88 @@
+#ifndef GAME_CARD_DELEGATE_H
+#define GAME_CARD_DELEGATE_H
+
+#include <QMargins>
+#include <QPersistentModelIndex>
+#include <QStyledItemDelegate>
+
+class QVariantAnimation;
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Paints a library game card for one LibraryModel row.
+ *
+ * Cards are not widgets: the view only paints the rows that are on screen and
+ * the overlay buttons are hit-tested here, so a library of thousands of games
+ * costs no more to show than a single screen of it.
+ *
+ * Hover feedback only moves the card: the shadow is a blurred nine-patch
+ * rendered once and shared by every card, and the lift is a translation
+ * animated by a single timer for the whole view.
+ */
+class GameCardDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+  public:
+    explicit GameCardDelegate(QObject *parent = nullptr);
+    ~GameCardDelegate();
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    // Card under the mouse. Its lift animates in while the previous card's animates out.
+    void setHoveredIndex(const QModelIndex &index);
+
+    // How far a card paints past its item rect: the shadows reach beyond the item
+    // margins, so any repaint of a single card has to cover these margins as well
+    static QMargins paintOverflow();
+
+    bool animationsEnabled() const { return animationsEnabled_; }
+    void setAnimationsEnabled(bool enabled);
+
+  signals:
+    // A card's appearance changed outside of the model (hover animation);
+    // repaint its item together with paintOverflow()
+    void repaintRequested(const QModelIndex &index);
+
+    void playRequested(const QString &gameId);
+    void stopRequested(const QString &gameId);
+    void detailsRequested(const QString &gameId);
+    void installRequested(const QString &gameId);
+    void cancelInstallRequested(const QString &gameId);
+    void updateRequested(const QString &gameId);
+    void repairRequested(const QString &gameId);
+
+  protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+                     const QModelIndex &index) override;
+
+  private:
+    enum class Button { None, Action, Update, Repair };
+
+    // 0 (resting) to 1 (fully lifted)
+    qreal hoverAmount(const QModelIndex &index) const;
+
+    // Card rectangle inside the item, lifted by lift (0..1)
+    static QRect cardRect(const QStyleOptionViewItem &option, qreal lift);
+    static Button buttonAt(const QStyleOptionViewItem &option, const QModelIndex &index,
+                           const QPoint &pos);
+
+    static void paintButton(QPainter *painter, const QRect &rect, const QColor &from,
+                            const QColor &to, const QString &text, int pixelSize);
+
+    QVariantAnimation *hoverAnimation_;
+    QPersistentModelIndex hovered_;
+    QPersistentModelIndex unhovered_;
+    qreal hoveredFrom_ = 0;   // Lift of hovered_ when the animation started
+    qreal unhoveredFrom_ = 0; // Likewise for the card being left
+    qreal progress_ = 1;
+    bool animationsEnabled_ = true;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // GAME_CARD_DELEGATE_H
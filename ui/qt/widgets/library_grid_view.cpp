@@ -0,0 +1,112 @@
+#include "library_grid_view.h"
+
+#include <QElapsedTimer>
+#include <QHoverEvent>
+#include <QResizeEvent>
+#include <QScrollBar>
+
+namespace opengalaxy {
+namespace ui {
+
+LibraryGridView::LibraryGridView(QWidget *parent) : QListView(parent) {
+    setViewMode(QListView::IconMode);
+    setMovement(QListView::Static);
+    setFlow(QListView::LeftToRight);
+    setWrapping(true);
+    // Relayout is driven by resizeEvent() when the column count changes
+    setResizeMode(QListView::Fixed);
+    setUniformItemSizes(true);
+    setLayoutMode(QListView::Batched); // Large libraries are laid out across event loop passes
+    setBatchSize(200);
+
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    verticalScrollBar()->setSingleStep(40);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setFrameShape(QFrame::NoFrame);
+}
+
+LibraryGridView::~LibraryGridView() = default;
+
+void LibraryGridView::setCellSize(const QSize &size) {
+    if (size == gridSize()) return;
+    setGridSize(size); // Relayouts once
+    columns_ = columnsForWidth(viewport()->width());
+}
+
+int LibraryGridView::columnsForWidth(int width) const {
+    const int cellWidth = gridSize().width();
+    return cellWidth > 0 ? qMax(1, width / cellWidth) : 1;
+}
+
+std::pair<int, int> LibraryGridView::rowsBetween(int top, int bottom) const {
+    const int cellHeight = gridSize().height();
+    const int count = model() ? model()->rowCount(rootIndex()) : 0;
+    if (cellHeight <= 0 || columns_ <= 0 || count == 0 || bottom < 0) return {0, -1};
+
+    // Every cell position follows from the row number, no layout lookup needed
+    const int firstLine = qMax(0, top) / cellHeight;
+    const int lastLine = bottom / cellHeight;
+    return {firstLine * columns_, qMin(count - 1, (lastLine + 1) * columns_ - 1)};
+}
+
+std::pair<int, int> LibraryGridView::visibleRows(int screens) const {
+    const int height = viewport()->height();
+    const int top = verticalOffset() + screens * height;
+    return rowsBetween(top, top + height - 1);
+}
+
+void LibraryGridView::repaintItem(const QModelIndex &index) {
+    if (!index.isValid()) return;
+    viewport()->update(visualRect(index).marginsAdded(paintOverflow_));
+}
+
+void LibraryGridView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                  const QList<int> &roles) {
+    QListView::dataChanged(topLeft, bottomRight, roles);
+    // A single changed item only gets its visual rect repainted, which would cut the
+    // shadow edges it paints over its neighbours; ranges repaint the whole viewport
+    if (topLeft == bottomRight) repaintItem(topLeft);
+}
+
+void LibraryGridView::resizeEvent(QResizeEvent *event) {
+    QListView::resizeEvent(event);
+
+    const int columns = columnsForWidth(viewport()->width());
+    if (columns != columns_) {
+        columns_ = columns;
+        scheduleDelayedItemsLayout();
+    }
+}
+
+bool LibraryGridView::viewportEvent(QEvent *event) {
+    switch (event->type()) {
+    case QEvent::HoverEnter:
+    case QEvent::HoverMove:
+        setHoveredIndex(indexAt(static_cast<QHoverEvent *>(event)->position().toPoint()));
+        break;
+    case QEvent::HoverLeave:
+        setHoveredIndex(QModelIndex());
+        break;
+    default:
+        break;
+    }
+    return QListView::viewportEvent(event);
+}
+
+void LibraryGridView::setHoveredIndex(const QModelIndex &index) {
+    if (index == hovered_) return;
+    hovered_ = index;
+    emit hoveredIndexChanged(index);
+}
+
+void LibraryGridView::paintEvent(QPaintEvent *event) {
+    QElapsedTimer timer;
+    timer.start();
+    QListView::paintEvent(event);
+    emit framePainted(timer.nsecsElapsed());
+}
+
+} // namespace ui
+} // namespace opengalaxy
@@ -0,0 +1,73 @@
+#ifndef LIBRARY_GRID_VIEW_H
+#define LIBRARY_GRID_VIEW_H
+
+#include <QListView>
+#include <QMargins>
+#include <QPersistentModelIndex>
+#include <utility>
+
+namespace opengalaxy {
+namespace ui {
+
+/**
+ * Card grid for the library page.
+ *
+ * Items sit on a fixed grid of cellSize() cells, so every position follows
+ * from the row number alone. The view only lays items out again when the
+ * number of columns that fit the viewport changes; resizing within the same
+ * column count, and repainting for hover or progress, never relayouts.
+ */
+class LibraryGridView : public QListView {
+    Q_OBJECT
+
+  public:
+    explicit LibraryGridView(QWidget *parent = nullptr);
+    ~LibraryGridView();
+
+    // Size of one grid cell: the card as painted plus the gap to its neighbours
+    QSize cellSize() const { return gridSize(); }
+    void setCellSize(const QSize &size);
+
+    int columnCount() const { return columns_; }
+
+    // Model rows whose cells overlap content rows [top, bottom] (in pixels, from the top
+    // of the grid), clamped to the model. Empty ranges have first > last.
+    std::pair<int, int> rowsBetween(int top, int bottom) const;
+    // Rows on screen, offset by the given number of screen heights
+    std::pair<int, int> visibleRows(int screens = 0) const;
+
+    // How far items paint past their visual rect (shadows); single-item repaints cover it
+    QMargins paintOverflow() const { return paintOverflow_; }
+    void setPaintOverflow(const QMargins &margins) { paintOverflow_ = margins; }
+
+  public slots:
+    // Repaints one item, including what it paints outside its visual rect
+    void repaintItem(const QModelIndex &index);
+
+  signals:
+    // Card under the mouse; invalid when the mouse is over empty space or outside
+    void hoveredIndexChanged(const QModelIndex &index);
+    // Time spent in one viewport paint
+    void framePainted(qint64 nsecs);
+
+  protected:
+    void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                     const QList<int> &roles = QList<int>()) override;
+    void resizeEvent(QResizeEvent *event) override;
+    bool viewportEvent(QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+
+  private:
+    int columnsForWidth(int width) const;
+
+    void setHoveredIndex(const QModelIndex &index);
+
+    int columns_ = 0;
+    QPersistentModelIndex hovered_;
+    QMargins paintOverflow_;
+};
+
+} // namespace ui
+} // namespace opengalaxy
+
+#endif // LIBRARY_GRID_VIEW_H